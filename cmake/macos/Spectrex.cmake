@@ -60,7 +60,7 @@ add_library(Spectrex::Spectrex STATIC IMPORTED)
 set_target_properties(Spectrex::Spectrex PROPERTIES
   INTERFACE_INCLUDE_DIRECTORIES "${_IMPORT_PREFIX}/include;${_IMPORT_PREFIX}/include"
   INTERFACE_LINK_LIBRARIES "Spectrex::GSL"
-  INTERFACE_SOURCES "${_IMPORT_PREFIX}/src/Spectrex/MiniProcessor.cpp"
+  INTERFACE_SOURCES "${_IMPORT_PREFIX}/src/Spectrex/Analysis/ConstantQ.cpp;${_IMPORT_PREFIX}/src/Spectrex/Analysis/Fft.cpp;${_IMPORT_PREFIX}/src/Spectrex/Analysis/LogBinRemap.cpp;${_IMPORT_PREFIX}/src/Spectrex/Analysis/LoudnessMeter.cpp;${_IMPORT_PREFIX}/src/Spectrex/Analysis/PartitionedFft.cpp;${_IMPORT_PREFIX}/src/Spectrex/Analysis/PartitionedStft.cpp;${_IMPORT_PREFIX}/src/Spectrex/Analysis/SlidingDft.cpp;${_IMPORT_PREFIX}/src/Spectrex/Analysis/Stft.cpp;${_IMPORT_PREFIX}/src/Spectrex/Analysis/SwappableStft.cpp;${_IMPORT_PREFIX}/src/Spectrex/Analysis/TableCache.cpp;${_IMPORT_PREFIX}/src/Spectrex/Analysis/Vectorscope.cpp;${_IMPORT_PREFIX}/src/Spectrex/Analysis/WaveformPyramid.cpp;${_IMPORT_PREFIX}/src/Spectrex/Analysis/ZoomFft.cpp;${_IMPORT_PREFIX}/src/Spectrex/AnalysisScheduler.cpp;${_IMPORT_PREFIX}/src/Spectrex/MiniProcessor.cpp;${_IMPORT_PREFIX}/src/Spectrex/OfflineProcessor.cpp;${_IMPORT_PREFIX}/src/Spectrex/SpectrogramQuantizer.cpp"
 )
 
 if(NOT CMAKE_VERSION VERSION_LESS "3.23.0")
@@ -69,7 +69,7 @@ if(NOT CMAKE_VERSION VERSION_LESS "3.23.0")
       FILE_SET "HEADERS"
       TYPE "HEADERS"
       BASE_DIRS "${_IMPORT_PREFIX}/include/../src"
-      FILES "${_IMPORT_PREFIX}/include/../src/Spectrex/MiniProcessor.cpp"
+      FILES "${_IMPORT_PREFIX}/include/../src/Spectrex/Analysis/ConstantQ.cpp" "${_IMPORT_PREFIX}/include/../src/Spectrex/Analysis/Fft.cpp" "${_IMPORT_PREFIX}/include/../src/Spectrex/Analysis/LogBinRemap.cpp" "${_IMPORT_PREFIX}/include/../src/Spectrex/Analysis/LoudnessMeter.cpp" "${_IMPORT_PREFIX}/include/../src/Spectrex/Analysis/PartitionedFft.cpp" "${_IMPORT_PREFIX}/include/../src/Spectrex/Analysis/PartitionedStft.cpp" "${_IMPORT_PREFIX}/include/../src/Spectrex/Analysis/SlidingDft.cpp" "${_IMPORT_PREFIX}/include/../src/Spectrex/Analysis/Stft.cpp" "${_IMPORT_PREFIX}/include/../src/Spectrex/Analysis/SwappableStft.cpp" "${_IMPORT_PREFIX}/include/../src/Spectrex/Analysis/TableCache.cpp" "${_IMPORT_PREFIX}/include/../src/Spectrex/Analysis/Vectorscope.cpp" "${_IMPORT_PREFIX}/include/../src/Spectrex/Analysis/WaveformPyramid.cpp" "${_IMPORT_PREFIX}/include/../src/Spectrex/Analysis/ZoomFft.cpp" "${_IMPORT_PREFIX}/include/../src/Spectrex/AnalysisScheduler.cpp" "${_IMPORT_PREFIX}/include/../src/Spectrex/MiniProcessor.cpp" "${_IMPORT_PREFIX}/include/../src/Spectrex/OfflineProcessor.cpp" "${_IMPORT_PREFIX}/include/../src/Spectrex/SpectrogramQuantizer.cpp"
   )
 else()
   set_property(TARGET Spectrex::Spectrex
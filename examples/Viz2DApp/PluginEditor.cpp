@@ -66,5 +66,7 @@ PluginEditor::beginGLDrawFrame()
     // Single synchronization point to gather any data from the
     // processors that can be used consistently throughout the entire
     // frame.
-    m_processor.getSpectrexMiniProcessor().getProcessor().cacheSyncWaveformSpectrogram();
+    auto& miniProcessor = m_processor.getSpectrexMiniProcessor();
+    miniProcessor.markConsumed();
+    miniProcessor.getProcessor().cacheSyncWaveformSpectrogram();
 }
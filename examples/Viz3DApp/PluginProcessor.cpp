@@ -131,6 +131,9 @@ PluginAudioProcessor::PluginAudioProcessor()
       BusesProperties().withInput("Input", juce::AudioChannelSet::stereo(), true).withOutput("Output", juce::AudioChannelSet::stereo(), true))
   , m_spectrexProcessor()
 {
+    // Skip the analysis whenever no editor has drawn a frame for a second
+    m_spectrexProcessor.setIdleTimeout(1.0);
+
     juce::AudioFormatManager formatManager;
     formatManager.registerBasicFormats();
 }
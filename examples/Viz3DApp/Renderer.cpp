@@ -16,6 +16,7 @@
 
 // Spectrex
 #include <Spectrex/Processing/Processor.hpp>
+#include <Spectrex/Utility/Quantize.hpp>
 
 // Stdlib
 #include <limits>
@@ -124,7 +125,8 @@ Renderer::render(int width, int height) noexcept
     // spectrex
     spectrex::SpectrogramInfo info;
     {
-        // Retrieve the processor
+        // Retrieve the processor, keeping its analysis active while frames are drawn
+        m_processor.getSpectrexMiniProcessor().markConsumed();
         spectrex::KProcessor& processor = m_processor.getSpectrexMiniProcessor().getProcessor();
         if (!processor.isValid()) {
             return;
@@ -135,10 +137,11 @@ Renderer::render(int width, int height) noexcept
 
         // Synchronize
         info = processor.getSpectrogramInfo();
-        processor.syncSpectrogram([&](spectrex::SyncInfo<float> first, std::optional<spectrex::SyncInfo<float>> second_) {
+        // The spectrogram is synchronized as 16-bit values, halving the pixel buffer and texture memory and the upload bandwidth
+        m_spectrogramQuantizer.syncSpectrogram(processor, [&](spectrex::SyncInfo<float> first, std::optional<spectrex::SyncInfo<float>> second_) {
             // Allocate the pixel buffer, will noop whenever size is
             // already equal to the requested size
-            m_spectrogramBuffer->allocate((uint32_t)info.Width * (uint32_t)info.Height * sizeof(float), BufferUsageMode::DynamicDraw);
+            m_spectrogramBuffer->allocate((uint32_t)info.Width * (uint32_t)info.Height * sizeof(uint16_t), BufferUsageMode::DynamicDraw);
 
             // Ensure that the dimensions of the spectrogram texture
             // are set correctly
@@ -148,35 +151,35 @@ Renderer::render(int width, int height) noexcept
             // Do sanity check, make sure k_spectrumPoints is equal to (FFT/2 + 1) which is (info.Width + 1)
             assert((k_spectrumPoints + 1) == info.Width);
 
-            // Map the pixel buffer, copy data into the mapped pointer
+            // Map the pixel buffer, quantize data into the mapped pointer
             m_spectrogramBuffer->mapBuffer(
-              [=](void* ptr) {
+              [=, this](void* ptr) {
 #ifdef ENABLE_NVTX
                   const auto r3 = nvtx3::scoped_range{ "Spectrogram write" };
 #endif // ENABLE_NVTX
 
                   jassert(ptr != nullptr);
                   if (ptr != nullptr) {
-                      float* fptr = (float*)ptr;
+                      uint16_t* fptr = (uint16_t*)ptr;
 
-                      // Clear the entire buffer if requested
+                      // Clear the entire buffer if requested, zero decodes to a zero magnitude in either format
                       if (first.Clear) {
-                          std::memset(fptr, 0, info.Width * info.Height * sizeof(float));
+                          std::memset(fptr, 0, info.Width * info.Height * sizeof(uint16_t));
 
                           return;
                       } else if (!first.isValid()) {
                           return;
                       }
 
-                      // Copy first span to buffer
+                      // Quantize first span into buffer
                       // The first span is always there: it contains any new data
-                      std::memcpy(fptr + first.RowIndex * info.Width, first.Pointer, first.Width * first.Height * sizeof(float));
+                      m_spectrogramQuantizer.quantizeRows(first, fptr + first.RowIndex * info.Width);
 
-                      // Copy second part to buffer (if available)
+                      // Quantize second part into buffer (if available)
                       // The second span is only occassional, but handles a case where the buffer wraps around to zero and starts from the beginning
                       if (second_) {
                           const auto& second = *second_;
-                          std::memcpy(fptr + second.RowIndex * info.Width, second.Pointer, second.Width * second.Height * sizeof(float));
+                          m_spectrogramQuantizer.quantizeRows(second, fptr + second.RowIndex * info.Width);
                       }
                   }
               },
@@ -286,6 +289,11 @@ Renderer::visual_1(int width, int height, spectrex::SpectrogramInfo info)
 
             // Row index of the latest row in the spectrogram
             m_program_1->set("uSpectrogramLatestRow", offsetX);
+
+            // Encoding of the spectrogram texture values
+            m_program_1->set("uSpectrogramLogEncoded", m_spectrogramQuantizer.getFormat() == spectrex::QuantizedFormat::LogUint16);
+            m_program_1->set("uSpectrogramMinDb", spectrex::k_logUint16MinDb);
+            m_program_1->set("uSpectrogramMaxDb", spectrex::k_logUint16MaxDb);
         }
 
         // Line variables
@@ -369,6 +377,11 @@ Renderer::visual_2(int width, int height, spectrex::SpectrogramInfo info)
 
             // Row index of the latest row in the spectrogram
             m_program_2->set("uSpectrogramLatestRow", offsetX);
+
+            // Encoding of the spectrogram texture values
+            m_program_2->set("uSpectrogramLogEncoded", m_spectrogramQuantizer.getFormat() == spectrex::QuantizedFormat::LogUint16);
+            m_program_2->set("uSpectrogramMinDb", spectrex::k_logUint16MinDb);
+            m_program_2->set("uSpectrogramMaxDb", spectrex::k_logUint16MaxDb);
         }
 
         // Line variables
@@ -463,6 +476,11 @@ Renderer::visual_3(int width, int height, spectrex::SpectrogramInfo info)
 
             // Row index of the latest row in the spectrogram
             m_program_3->set("uSpectrogramLatestRow", offsetX);
+
+            // Encoding of the spectrogram texture values
+            m_program_3->set("uSpectrogramLogEncoded", m_spectrogramQuantizer.getFormat() == spectrex::QuantizedFormat::LogUint16);
+            m_program_3->set("uSpectrogramMinDb", spectrex::k_logUint16MinDb);
+            m_program_3->set("uSpectrogramMaxDb", spectrex::k_logUint16MaxDb);
         }
 
         m_program_3->set("uXAmount", (int)std::lround(m_parameters.visual_3.x_amount));
@@ -528,9 +546,15 @@ Renderer::Renderer(PluginAudioProcessor& processor, Parameters& parameters) noex
 
     // Create texture resources, the initial dimensions can be zero
     // as the textures will be resized according to the data that
-    // will be written into them
+    // will be written into them. Half floats are stored as GL_R16F, log
+    // encoded values as normalized GL_R16. Interpolated codes do not decode
+    // to interpolated magnitudes, so the shaders filter log encoded values
+    // after decoding them
+    const auto isHalf = m_spectrogramQuantizer.getFormat() == spectrex::QuantizedFormat::Half;
+    const auto spectrogramDataType = isHalf ? TextureDataType::HalfFloat : TextureDataType::UnsignedShort;
+    const auto spectrogramFilteringType = isHalf ? TextureFilteringType::Bilinear : TextureFilteringType::Nearest;
     m_spectrogramTexture = std::unique_ptr<Texture>(RenderingResourceFactory::createTextureResource(
-      0, 0, TextureType::Texture2D, TextureFormat::R, TextureDataType::Float, TextureWrappingType::ClampToEdge, TextureFilteringType::Bilinear));
+      0, 0, TextureType::Texture2D, TextureFormat::R, spectrogramDataType, TextureWrappingType::ClampToEdge, spectrogramFilteringType));
 
     // Set up sprite geometry
     m_spectrum_geometry = std::make_unique<SpectrumLine>();
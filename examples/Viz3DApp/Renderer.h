@@ -11,6 +11,7 @@
 
 // spectrex
 #include <Spectrex/Processing/Processor.hpp>
+#include <Spectrex/SpectrogramQuantizer.hpp>
 
 // Stdlib
 #include <algorithm>
@@ -62,6 +63,7 @@ class Renderer final
     // Spectrex
     std::unique_ptr<Buffer> m_spectrogramBuffer;
     std::unique_ptr<Texture> m_spectrogramTexture;
+    spectrex::SpectrogramQuantizer m_spectrogramQuantizer{ spectrex::QuantizedFormat::LogUint16 };
 
     void visual_1(int width, int height, spectrex::SpectrogramInfo info);
 
@@ -207,6 +207,10 @@ Texture::clear() noexcept
 
     bind();
     {
+        // Rows are tightly packed, which for 16-bit data with an odd width
+        // does not meet the default 4 byte row alignment
+        glPixelStorei(GL_UNPACK_ALIGNMENT, getStride() % 4 == 0 ? 4 : 1);
+
         switch (m_type) {
             // Texture 2D
             case TextureType::Texture2D: {
@@ -232,6 +236,9 @@ Texture::upload(const uint8_t* data, int32_t x, int32_t y, uint32_t width, uint3
     // Upload texture data
     bind();
     {
+        // Rows are tightly packed, see clear
+        glPixelStorei(GL_UNPACK_ALIGNMENT, getStride() % 4 == 0 ? 4 : 1);
+
         switch (m_type) {
             // Texture 2D
             case TextureType::Texture2D: {
@@ -267,9 +274,15 @@ Texture::getStride() const noexcept -> uint32_t
         case TextureDataType::Float:
             stride = sizeof(GLfloat);
             break;
+        case TextureDataType::HalfFloat:
+            stride = sizeof(GLhalf);
+            break;
         case TextureDataType::UnsignedByte:
             stride = sizeof(GLubyte);
             break;
+        case TextureDataType::UnsignedShort:
+            stride = sizeof(GLushort);
+            break;
         default:
             jassertfalse; // Not implemented
             return GL_NONE;
@@ -454,6 +467,21 @@ Texture::getInternalFormat() const noexcept -> GLenum
                     return GL_NONE;
             }
         } break;
+        case TextureDataType::HalfFloat: {
+            switch (m_format) {
+                case TextureFormat::R:
+                    return GL_R16F;
+                case TextureFormat::RG:
+                    return GL_RG16F;
+                case TextureFormat::RGB:
+                    return GL_RGB16F;
+                case TextureFormat::RGBA:
+                    return GL_RGBA16F;
+                default:
+                    jassertfalse; // Not implemented
+                    return GL_NONE;
+            }
+        } break;
         case TextureDataType::UnsignedByte: {
             switch (m_format) {
                 case TextureFormat::R:
@@ -469,6 +497,21 @@ Texture::getInternalFormat() const noexcept -> GLenum
                     return GL_NONE;
             }
         } break;
+        case TextureDataType::UnsignedShort: {
+            switch (m_format) {
+                case TextureFormat::R:
+                    return GL_R16;
+                case TextureFormat::RG:
+                    return GL_RG16;
+                case TextureFormat::RGB:
+                    return GL_RGB16;
+                case TextureFormat::RGBA:
+                    return GL_RGBA16;
+                default:
+                    jassertfalse; // Not implemented
+                    return GL_NONE;
+            }
+        } break;
         default:
             jassertfalse; // Not implemented
             return GL_NONE;
@@ -499,8 +542,12 @@ Texture::getDataType() const noexcept -> GLenum
     switch (m_dataType) {
         case TextureDataType::Float:
             return GL_FLOAT;
+        case TextureDataType::HalfFloat:
+            return GL_HALF_FLOAT;
         case TextureDataType::UnsignedByte:
             return GL_UNSIGNED_BYTE;
+        case TextureDataType::UnsignedShort:
+            return GL_UNSIGNED_SHORT;
         default:
             jassertfalse; // Not implemented
             return GL_NONE;
@@ -315,7 +315,9 @@ enum class TextureDataType
 {
     Undefined,
     Float,
-    UnsignedByte
+    HalfFloat,
+    UnsignedByte,
+    UnsignedShort
 };
 
 /// @brief A texture resource. A texture can be resized dynamically, although
@@ -34,6 +34,11 @@ uniform float uMaxDb;
 uniform float uMinFrequency;
 uniform float uMaxFrequency;
 
+// Spectrogram texture encoding, either linear magnitudes (half float) or dB values mapped onto [0, 1] from [uSpectrogramMinDb, uSpectrogramMaxDb]
+uniform bool uSpectrogramLogEncoded;
+uniform float uSpectrogramMinDb;
+uniform float uSpectrogramMaxDb;
+
 // Spectrum value height in terms of line vertical coordinates
 uniform float uLineSpectrumHeight;
 uniform float uLineThickness;
@@ -88,6 +93,39 @@ float db(float mag)
     return 20.0f * I_LOG10 * log(mag);
 }
 
+// Decodes a texel of the log encoded spectrogram into a linear magnitude, texels outside the texture are clamped to its edges
+float spectrogramTexel(ivec2 texel, ivec2 size)
+{
+    float value = texelFetch(uSpectrogram, clamp(texel, ivec2(0), size - 1), 0).r;
+
+    // Code 0 encodes a zero magnitude, codes 1 to 65535 map onto the dB range
+    float code = floor(value * 65535.0f + 0.5f);
+    if (code < 1.0f) {
+        return 0.0f;
+    }
+    return pow(10.0f, mix(uSpectrogramMinDb, uSpectrogramMaxDb, (code - 1.0f) / 65534.0f) / 20.0f);
+}
+
+float spectrogram(vec2 uv)
+{
+    if (!uSpectrogramLogEncoded) {
+        return texture(uSpectrogram, uv).r;
+    }
+
+    // Interpolated codes do not decode to interpolated magnitudes (e.g. between silence and the dB range), so the log encoded texture is
+    // not filtered, and the decoded magnitudes of the four nearest texels are interpolated instead
+    ivec2 size = textureSize(uSpectrogram, 0);
+    vec2 position = uv * vec2(size) - 0.5f;
+    ivec2 texel = ivec2(floor(position));
+    vec2 t = position - floor(position);
+
+    float m00 = spectrogramTexel(texel, size);
+    float m10 = spectrogramTexel(texel + ivec2(1, 0), size);
+    float m01 = spectrogramTexel(texel + ivec2(0, 1), size);
+    float m11 = spectrogramTexel(texel + ivec2(1, 1), size);
+    return mix(mix(m00, m10, t.x), mix(m01, m11, t.x), t.y);
+}
+
 // Cheap window tapering function [0, 1]
 float taper(float t)
 {
@@ -147,7 +185,7 @@ main()
             else if (sr >= height) { sr -= height; }
 
             // Sample bin from texture
-            magnitude += texture(uSpectrogram, vec2(bin * float(bins), float(sr)) / vec2(bins, height)).r;
+            magnitude += spectrogram(vec2(bin * float(bins), float(sr)) / vec2(bins, height));
         }
         magnitude *= 1.0f / numRowsPerInstance;
 
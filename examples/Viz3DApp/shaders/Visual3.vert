@@ -38,6 +38,11 @@ uniform float uMaxDb;
 uniform float uMinFrequency;
 uniform float uMaxFrequency;
 
+// Spectrogram texture encoding, either linear magnitudes (half float) or dB values mapped onto [0, 1] from [uSpectrogramMinDb, uSpectrogramMaxDb]
+uniform bool uSpectrogramLogEncoded;
+uniform float uSpectrogramMinDb;
+uniform float uSpectrogramMaxDb;
+
 // 1 / log(10)
 #define I_LOG10 0.43429448190325182765
 
@@ -54,6 +59,39 @@ float db(float mag)
     return 20.0f * I_LOG10 * log(mag);
 }
 
+// Decodes a texel of the log encoded spectrogram into a linear magnitude, texels outside the texture are clamped to its edges
+float spectrogramTexel(ivec2 texel, ivec2 size)
+{
+    float value = texelFetch(uSpectrogram, clamp(texel, ivec2(0), size - 1), 0).r;
+
+    // Code 0 encodes a zero magnitude, codes 1 to 65535 map onto the dB range
+    float code = floor(value * 65535.0f + 0.5f);
+    if (code < 1.0f) {
+        return 0.0f;
+    }
+    return pow(10.0f, mix(uSpectrogramMinDb, uSpectrogramMaxDb, (code - 1.0f) / 65534.0f) / 20.0f);
+}
+
+float spectrogram(vec2 uv)
+{
+    if (!uSpectrogramLogEncoded) {
+        return texture(uSpectrogram, uv).r;
+    }
+
+    // Interpolated codes do not decode to interpolated magnitudes (e.g. between silence and the dB range), so the log encoded texture is
+    // not filtered, and the decoded magnitudes of the four nearest texels are interpolated instead
+    ivec2 size = textureSize(uSpectrogram, 0);
+    vec2 position = uv * vec2(size) - 0.5f;
+    ivec2 texel = ivec2(floor(position));
+    vec2 t = position - floor(position);
+
+    float m00 = spectrogramTexel(texel, size);
+    float m10 = spectrogramTexel(texel + ivec2(1, 0), size);
+    float m01 = spectrogramTexel(texel + ivec2(0, 1), size);
+    float m11 = spectrogramTexel(texel + ivec2(1, 1), size);
+    return mix(mix(m00, m10, t.x), mix(m01, m11, t.x), t.y);
+}
+
 void main() {
     Out.InstanceID = gl_InstanceID;
 
@@ -118,7 +156,7 @@ void main() {
             // Average all bins that belong to this block
             float sum = 0.0f;
             for(int b = 0; b < numBins; ++b) {
-                sum += texture(uSpectrogram, vec2(float(binStart + b), float(sr)) / vec2(bins, height)).r;
+                sum += spectrogram(vec2(float(binStart + b), float(sr)) / vec2(bins, height));
             }
             magnitude += sum / float(numBins);
         }
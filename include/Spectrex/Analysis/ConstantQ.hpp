@@ -0,0 +1,118 @@
+#pragma once
+
+// Spectrex
+#include <Spectrex/Analysis/Fft.hpp>
+#include <Spectrex/Utility/Utility.hpp>
+
+// GSL
+#include <gsl/span>
+
+// Stdlib
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace spectrex {
+
+/// Constant-Q transform, producing a magnitude frame of logarithmically spaced bins every hop.
+///
+/// Where a linear STFT spends most of its bins on high frequencies once displayed on a log frequency axis, the number of bins of a constant-Q
+/// transform is set by the number of bins per octave, with the bandwidth of every bin proportional to its frequency. Frames are therefore much
+/// narrower than FFT / 2 + 1 bins, e.g. 24 bins per octave from 20 Hz to 16 kHz gives 232 bins instead of the 2049 bins of a 4096 point STFT.
+///
+/// Uses the recursive octave approach: the bins of the top octave are computed from a single FFT using a sparse spectral kernel, and every lower
+/// octave reuses the same FFT size and kernel on the signal decimated by another factor of two. The cost per frame is one FFT of the kernel size
+/// per octave, plus a few multiply-adds per bin.
+class ConstantQ final : public spectrex::NonCopyable
+{
+  public:
+    /// Function receiving the magnitudes of all bins of a frame, from low to high frequency.
+    using FrameHandler = std::function<void(gsl::span<const float> magnitudes)>;
+
+    /// Maximum ratio of the maximum frequency to the sample rate, leaving room for the anti-aliasing filters of the decimation stages.
+    static constexpr double k_maxRelativeFrequency = 0.4;
+
+    /// Processes samples, calling \a handler for every completed frame.
+    void process(gsl::span<const float> samples, const FrameHandler& handler) noexcept;
+
+    /// Resets the sample histories of all octaves.
+    void reset() noexcept;
+
+    /// Returns the centre frequency of a bin, in Hz.
+    auto getBinFrequency(size_t bin) const noexcept -> double;
+
+    /// Returns the number of bins.
+    auto getNumBins() const noexcept -> size_t { return m_numBins; }
+
+    /// Returns the number of bins per octave.
+    auto getBinsPerOctave() const noexcept -> size_t { return m_binsPerOctave; }
+
+    /// Returns the number of octaves, i.e. the number of decimation stages plus one.
+    auto getNumOctaves() const noexcept -> size_t { return m_octaves.size(); }
+
+    /// Returns the FFT size used for every octave.
+    auto getSize() const noexcept -> size_t { return m_size; }
+
+    /// Returns the hop size in samples.
+    auto getHop() const noexcept -> size_t { return m_hop; }
+
+    /// Constructs a constant-Q transform.
+    /// @param sampleRate Sample rate in Hz.
+    /// @param minFrequency Frequency of the lowest bin in Hz.
+    /// @param maxFrequency Maximum frequency in Hz, clamped to k_maxRelativeFrequency * sampleRate. The highest bin is the highest frequency
+    /// minFrequency * 2^(k / binsPerOctave) not above it.
+    /// @param binsPerOctave Number of bins per octave, at least 1.
+    /// @param hop Hop size in samples, at least 1.
+    ConstantQ(double sampleRate, double minFrequency, double maxFrequency, size_t binsPerOctave, size_t hop);
+
+  private:
+    /// Sample history of an octave, and the anti-aliasing filter history of the decimation stage feeding the next octave.
+    struct Octave
+    {
+        std::vector<float> History;
+        size_t HistoryIndex = 0;
+
+        std::vector<float> FilterHistory;
+        size_t FilterIndex = 0;
+        bool Decimate = false;
+    };
+
+    /// Computes the bins of an octave from its sample history.
+    /// @param octave Octave, 0 being the top octave.
+    void processOctave(size_t octave) noexcept;
+
+    const double m_sampleRate;
+    const size_t m_binsPerOctave;
+    const size_t m_hop;
+
+    size_t m_numBins = 0;
+    size_t m_size = 0;
+
+    /// Frequency of the highest bin.
+    double m_topFrequency = 0.0;
+
+    /// Sparse spectral kernel of the top octave: for every bin of the octave (highest first), the range [KernelOffsets[b], KernelOffsets[b + 1])
+    /// of FFT bins and conjugated, normalized kernel coefficients.
+    std::vector<uint32_t> m_kernelOffsets;
+    std::vector<uint32_t> m_kernelBins;
+    std::vector<std::complex<float>> m_kernelCoefficients;
+
+    /// Half-band anti-aliasing filter taps.
+    std::vector<float> m_filterTaps;
+
+    std::vector<Octave> m_octaves;
+
+    /// Number of samples since the last frame.
+    size_t m_samplesSinceFrame = 0;
+
+    /// FFT and work buffers.
+    std::unique_ptr<FftBackend> m_fft;
+    std::vector<float> m_frame;
+    std::vector<std::complex<float>> m_spectrum;
+    std::vector<float> m_magnitudes;
+};
+
+} // namespace spectrex
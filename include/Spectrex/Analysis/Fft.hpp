@@ -0,0 +1,161 @@
+#pragma once
+
+// Spectrex
+#include <Spectrex/Utility/AlignedAllocator.hpp>
+#include <Spectrex/Utility/Utility.hpp>
+
+// Stdlib
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace spectrex {
+
+/// Instruction set used by vectorized analysis kernels.
+enum class SimdLevel
+{
+    Scalar,
+    Sse,
+    Avx2,
+    Neon
+};
+
+/// Returns the best instruction set supported by the CPU. Detected once, on first use.
+auto detectSimdLevel() noexcept -> SimdLevel;
+
+/// Returns a human readable name of an instruction set.
+auto getSimdLevelName(SimdLevel level) noexcept -> const char*;
+
+/// Real-to-complex FFT of a fixed power-of-two size.
+///
+/// Implementations are not thread-safe: every thread that performs transforms should use its own instance.
+class FftBackend : public spectrex::NonCopyable
+{
+  public:
+    /// Returns the transform size, i.e. the number of real input samples.
+    auto getSize() const noexcept -> size_t { return m_size; }
+
+    /// Returns the number of complex output bins, from DC up to and including Nyquist.
+    auto getNumBins() const noexcept -> size_t { return m_size / 2 + 1; }
+
+    /// Returns a human readable name of the implementation, e.g. for diagnostics and benchmarks.
+    virtual auto getName() const noexcept -> const char* = 0;
+
+    /// Performs an unnormalized forward transform.
+    /// @param input getSize() real input samples.
+    /// @param output getNumBins() complex output bins.
+    virtual void forward(const float* input, std::complex<float>* output) noexcept = 0;
+
+    /// Computes the magnitude spectrum of the windowed input, i.e. |FFT(input * window)|. The default implementation performs windowing, the
+    /// transform and the magnitude computation as separate passes, implementations may fuse them.
+    /// @param input getSize() real input samples.
+    /// @param window getSize() window coefficients.
+    /// @param magnitudes getNumBins() output magnitudes.
+    virtual void forwardMagnitudes(const float* input, const float* window, float* magnitudes) noexcept;
+
+    virtual ~FftBackend() = default;
+
+  protected:
+    /// Constructs a backend.
+    /// @param size Transform size, must be a power of two and at least 4.
+    explicit FftBackend(size_t size);
+
+  private:
+    const size_t m_size;
+
+    /// Work buffers of the default forwardMagnitudes implementation.
+    std::vector<float> m_windowed;
+    std::vector<std::complex<float>> m_spectrum;
+};
+
+/// Immutable tables of the built-in FFT of a given size, shared by all BuiltinFft instances of that size, see TableCache::getFftPlan.
+struct FftPlan final
+{
+    /// Real transform size.
+    size_t Size = 0;
+
+    /// Bit-reversal permutation of the complex transform of size Size / 2.
+    AlignedVector<uint32_t> BitReversal;
+
+    /// Butterfly twiddles, the twiddles of a stage with half size h are stored at [h, 2h).
+    AlignedVector<float> TwiddlesRe;
+    AlignedVector<float> TwiddlesIm;
+
+    /// Twiddles of the split pass.
+    AlignedVector<float> SplitRe;
+    AlignedVector<float> SplitIm;
+
+    /// Computes the tables of a transform size.
+    /// @param size Transform size, must be a power of two and at least 4.
+    explicit FftPlan(size_t size);
+};
+
+/// Built-in FFT backend.
+///
+/// Computes a real transform of size N as a complex transform of size N/2 on split real/imaginary arrays, followed by a split pass that recovers
+/// the N/2+1 real-input bins. The radix-2 butterfly stages are vectorized with AVX2, SSE or NEON, selected at runtime. forwardMagnitudes fuses
+/// windowing into the (bit-reversed) load of the input and the magnitude computation into the split pass, so the data is only passed over by the
+/// butterfly stages in between. The split pass and magnitudes are vectorized as well, whereas the load is only vectorized with AVX2, which
+/// gathers the bit-reversed samples.
+class BuiltinFft final : public FftBackend
+{
+  public:
+    auto getName() const noexcept -> const char* override;
+
+    void forward(const float* input, std::complex<float>* output) noexcept override;
+    void forwardMagnitudes(const float* input, const float* window, float* magnitudes) noexcept override;
+
+    /// Returns the instruction set used by the butterfly stages.
+    auto getSimdLevel() const noexcept -> SimdLevel { return m_simdLevel; }
+
+    /// Constructs a built-in backend.
+    /// @param size Transform size, must be a power of two and at least 4.
+    /// @param simdLevel Instruction set to use, clamped to what the CPU supports.
+    explicit BuiltinFft(size_t size, SimdLevel simdLevel = detectSimdLevel());
+
+  private:
+    /// Loads the input into the work buffers in bit-reversed order, optionally windowed.
+    void load(const float* input, const float* window) noexcept;
+
+    /// Performs the butterfly stages on the work buffers.
+    void transform() noexcept;
+
+    /// Returns the real-input bin \a k from the complex transform in the work buffers.
+    auto split(size_t k) const noexcept -> std::complex<float>;
+
+    const SimdLevel m_simdLevel;
+
+    /// Size of the complex transform, half the real transform size.
+    const size_t m_halfSize;
+
+    /// Shared tables.
+    const std::shared_ptr<const FftPlan> m_plan;
+
+    /// Work buffers.
+    AlignedVector<float> m_re;
+    AlignedVector<float> m_im;
+};
+
+/// Factory function that creates an FFT backend of a given size.
+using FftBackendFactory = std::function<std::unique_ptr<FftBackend>(size_t size)>;
+
+/// Process-wide selection of the FFT backend, so hosts can plug in the FFT of their platform (e.g. vDSP or IPP) for all open analysis code.
+class FftBackendRegistry final
+{
+  public:
+    /// Sets the factory used by create. An empty factory restores the built-in backend.
+    /// @thread any
+    static void setFactory(FftBackendFactory factory);
+
+    /// Creates a backend using the current factory.
+    /// @param size Transform size, must be a power of two and at least 4.
+    /// @thread any
+    static auto create(size_t size) -> std::unique_ptr<FftBackend>;
+
+    FftBackendRegistry() = delete;
+};
+
+} // namespace spectrex
@@ -0,0 +1,51 @@
+#pragma once
+
+// Stdlib
+#include <algorithm>
+
+namespace spectrex {
+
+/// Range of frequencies in Hz.
+struct FrequencyBand
+{
+    /// Minimum frequency.
+    float MinFrequency = 0.0f;
+
+    /// Maximum frequency.
+    float MaxFrequency = 0.0f;
+
+    /// Returns the width of the band.
+    auto getWidth() const noexcept -> float { return MaxFrequency - MinFrequency; }
+
+    /// Returns whether or not the band is empty.
+    auto isEmpty() const noexcept -> bool { return MaxFrequency <= MinFrequency; }
+
+    /// Returns the smallest band containing both bands, ignoring empty bands.
+    static auto getUnion(const FrequencyBand& a, const FrequencyBand& b) noexcept -> FrequencyBand
+    {
+        if (a.isEmpty()) {
+            return b;
+        }
+        if (b.isEmpty()) {
+            return a;
+        }
+
+        return { std::min(a.MinFrequency, b.MinFrequency), std::max(a.MaxFrequency, b.MaxFrequency) };
+    }
+};
+
+/// Returns the union of the frequency ranges (KComponent::getMinFrequency and KComponent::getMaxFrequency) of a number of components, i.e. the
+/// band an analysis feeding these components has to cover.
+/// @param components Range of pointers to components, e.g. a std::vector<KComponent*>.
+template<typename Components>
+auto getRequiredBand(const Components& components) noexcept -> FrequencyBand
+{
+    FrequencyBand band;
+    for (const auto* component : components) {
+        band = FrequencyBand::getUnion(band, { component->getMinFrequency(), component->getMaxFrequency() });
+    }
+
+    return band;
+}
+
+} // namespace spectrex
@@ -0,0 +1,101 @@
+#pragma once
+
+// Spectrex
+#include <Spectrex/Analysis/Fft.hpp>
+#include <Spectrex/Utility/Utility.hpp>
+
+// Stdlib
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace spectrex {
+
+/// Remaps linear FFT magnitudes to logarithmically spaced analyzer bins, with the spectrogram tilt and analyzer dB scale applied.
+///
+/// The mapping, tilt and dB scale are all linear in the magnitudes, so they are folded into a single sparse weight matrix that is only rebuilt when
+/// the configuration changes. Per frame, remapping is a single pass of gathers and multiply-adds. Analyzer bins narrower than an FFT bin
+/// (at low frequencies) interpolate between the two nearest FFT bins, wider ones average the FFT bins they overlap.
+///
+/// The matrix is stored as slices of 8 analyzer bins, each padded to the number of weights of its widest bin, so 8 analyzer bins are computed at a
+/// time without horizontal sums. Since neighbouring analyzer bins have about the same width, padding is small. With AVX2, a slice is computed using
+/// gather instructions, other instruction sets use the scalar kernel.
+class LogBinRemap final
+{
+  public:
+    /// Number of analyzer bins per slice.
+    static constexpr size_t k_sliceSize = 8;
+
+    /// Configuration of the remap.
+    struct Config
+    {
+        /// Number of FFT bins, from DC up to and including Nyquist.
+        size_t NumFftBins = 0;
+
+        /// Sample rate in Hz, see ProcessorParameters::Key::SampleRate.
+        float SampleRate = 48000.0f;
+
+        /// Number of analyzer bins, see KProcessor::getAnalyzerNumBins.
+        uint32_t NumBins = 0;
+
+        /// Frequency range of the analyzer bins in Hz, clamped to Nyquist.
+        float MinFrequency = 20.0f;
+        float MaxFrequency = 20000.0f;
+
+        /// Tilt in dB per octave relative to TiltReferenceFrequency, see KProcessor::getSpectrogramTiltDbPerOctave.
+        float TiltDbPerOctave = 0.0f;
+        float TiltReferenceFrequency = 1000.0f;
+
+        /// dB scale between [-1, 1], halving or doubling the magnitudes, see KProcessor::getAnalyzerDbScale.
+        float DbScale = 0.0f;
+
+        auto operator==(const Config& other) const noexcept -> bool
+        {
+            return NumFftBins == other.NumFftBins && SampleRate == other.SampleRate && NumBins == other.NumBins &&
+                   MinFrequency == other.MinFrequency && MaxFrequency == other.MaxFrequency && TiltDbPerOctave == other.TiltDbPerOctave &&
+                   TiltReferenceFrequency == other.TiltReferenceFrequency && DbScale == other.DbScale;
+        }
+        auto operator!=(const Config& other) const noexcept -> bool { return !(*this == other); }
+    };
+
+    /// Sets the configuration, rebuilding the matrix only if it changed. May allocate when rebuilding.
+    /// @return Whether or not the matrix was rebuilt.
+    auto configure(const Config& config) -> bool;
+
+    /// Remaps magnitudes.
+    /// @param magnitudes Config::NumFftBins FFT magnitudes.
+    /// @param output Config::NumBins analyzer bin magnitudes.
+    void apply(const float* magnitudes, float* output) const noexcept;
+
+    /// Returns the current configuration.
+    auto getConfig() const noexcept -> const Config& { return m_config; }
+
+    /// Returns the centre frequency of an analyzer bin, in Hz.
+    auto getBinFrequency(size_t bin) const noexcept -> double;
+
+    /// Returns the instruction set used by apply, either SimdLevel::Avx2 or SimdLevel::Scalar.
+    auto getSimdLevel() const noexcept -> SimdLevel { return m_simdLevel; }
+
+    /// Returns the number of stored weights, including padding.
+    auto getNumWeights() const noexcept -> size_t { return m_weights.size(); }
+
+    /// Constructs an empty remap, see configure.
+    /// @param simdLevel Instruction set to use, falls back to the scalar kernel if it is not AVX2 or not supported by the CPU.
+    explicit LogBinRemap(SimdLevel simdLevel = detectSimdLevel());
+
+  private:
+    /// Rebuilds the matrix from the current configuration.
+    void rebuild();
+
+    SimdLevel m_simdLevel;
+    Config m_config;
+
+    /// Per slice, the offset of its first entry and its number of entries per analyzer bin. The entries of a slice are interleaved: entry e of
+    /// analyzer bin b is stored at offset + e * k_sliceSize + b.
+    std::vector<uint32_t> m_sliceOffsets;
+    std::vector<uint32_t> m_sliceLengths;
+    std::vector<int32_t> m_indices;
+    std::vector<float> m_weights;
+};
+
+} // namespace spectrex
@@ -0,0 +1,177 @@
+#pragma once
+
+// Spectrex
+#include <Spectrex/Analysis/Fft.hpp>
+#include <Spectrex/Processing/Data.hpp>
+#include <Spectrex/Utility/Utility.hpp>
+
+// GSL
+#include <gsl/span>
+
+// Stdlib
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace spectrex {
+
+/// Loudness measurement of a LoudnessMeter. Loudness values are in LUFS, -infinity until enough audio has been measured (or if the audio is
+/// below the absolute gate of -70 LUFS), true peaks are in dBTP.
+struct LoudnessInfo
+{
+    /// Momentary loudness, of the last 400 ms.
+    float Momentary = -std::numeric_limits<float>::infinity();
+
+    /// Short-term loudness, of the last 3 s.
+    float ShortTerm = -std::numeric_limits<float>::infinity();
+
+    /// Gated integrated loudness since the last reset.
+    float Integrated = -std::numeric_limits<float>::infinity();
+
+    /// Loudness range since the last reset in LU, 0 until enough audio has been measured.
+    float LoudnessRange = 0.0f;
+
+    /// Highest momentary and short-term loudness since the last reset.
+    float MaxMomentary = -std::numeric_limits<float>::infinity();
+    float MaxShortTerm = -std::numeric_limits<float>::infinity();
+
+    /// True peak of the last 100 ms, e.g. for a peak meter.
+    float TruePeak = -std::numeric_limits<float>::infinity();
+
+    /// Highest true peak since the last reset.
+    float MaxTruePeak = -std::numeric_limits<float>::infinity();
+
+    /// Duration of the measured audio since the last reset in seconds.
+    double Seconds = 0.0;
+};
+
+/// Loudness meter following EBU R 128 (ITU-R BS.1770-4 and EBU Tech 3342): momentary, short-term and integrated loudness, loudness range and true
+/// peak of up to k_maxNumChannels channels (e.g. a stereo pair), all weighted 1.
+///
+/// Audio is processed incrementally in 100 ms segments. Per segment, the mean square of the K-weighted audio is kept for the momentary (4
+/// segments) and short-term (30 segments) windows. The integrated loudness and loudness range are gated over the entire program, so instead of
+/// keeping every block, the momentary and short-term loudness of every segment are counted in histograms of k_histogramStep LU, from the absolute
+/// gate up to k_histogramMax, along with the sum of their mean squares per bin. Memory is constant regardless of the program length. The
+/// integrated loudness is exact but for the blocks within k_histogramStep of the relative gate, the loudness range is within k_histogramStep.
+///
+/// K-weighting (a high shelf and a highpass biquad per channel) is evaluated as one vector of all biquads, every highpass taking the shelf output
+/// of the previous sample, which delays the audio by a sample but removes the serial dependency. True peak is the maximum of the audio oversampled
+/// 4 times by a 48 tap polyphase FIR, all phases and channels computed as one vector. Both use AVX2, or scalar kernels on other instruction sets.
+class LoudnessMeter final : public spectrex::NonCopyable
+{
+  public:
+    /// Maximum number of channels.
+    static constexpr size_t k_maxNumChannels = 2;
+
+    /// Oversampling factor of the true peak.
+    static constexpr size_t k_truePeakFactor = 4;
+
+    /// Number of taps of every phase of the true peak FIR.
+    static constexpr size_t k_truePeakTaps = 12;
+
+    /// Absolute gate in LUFS, also the lowest loudness of the histograms.
+    static constexpr float k_absoluteGate = -70.0f;
+
+    /// Highest loudness of the histograms in LUFS, louder segments are counted in the last bin.
+    static constexpr float k_histogramMax = 30.0f;
+
+    /// Bin width of the histograms in LU.
+    static constexpr float k_histogramStep = 0.1f;
+
+    /// Processes samples of every channel, all of the same length. Channels beyond k_maxNumChannels are ignored.
+    void process(gsl::span<const AudioChannelView> channels) noexcept;
+
+    /// Clears the measurement and the filter states.
+    void reset() noexcept;
+
+    /// Returns the measurement. Computes the integrated loudness and loudness range from the histograms, in the order of a few microseconds.
+    auto getInfo() const noexcept -> LoudnessInfo;
+
+    /// Returns the sample rate in Hz.
+    auto getSampleRate() const noexcept -> float { return m_sampleRate; }
+
+    /// Returns the instruction set of the kernels, either SimdLevel::Avx2 or SimdLevel::Scalar.
+    auto getSimdLevel() const noexcept -> SimdLevel { return m_simdLevel; }
+
+    /// Constructs a meter.
+    /// @param sampleRate Sample rate in Hz.
+    /// @param simdLevel Instruction set to use, falls back to the scalar kernels if it is not AVX2 or not supported by the CPU.
+    explicit LoudnessMeter(float sampleRate, SimdLevel simdLevel = detectSimdLevel());
+
+  private:
+    /// Number of biquads of the K-weighting.
+    static constexpr size_t k_numBiquads = 2 * k_maxNumChannels;
+
+    /// Number of segments of the momentary and short-term windows.
+    static constexpr size_t k_momentarySegments = 4;
+    static constexpr size_t k_shortTermSegments = 30;
+
+    /// Number of bins of the histograms.
+    static constexpr size_t k_histogramSize = (size_t)((k_histogramMax - k_absoluteGate) / k_histogramStep + 0.5f);
+
+    /// State of the K-weighting, one lane per biquad. Lanes 0 and 1 are the high shelves of the channels, lanes 2 and 3 their highpasses.
+    struct FilterState
+    {
+        /// Biquad coefficients, normalized by a0.
+        alignas(16) float B0[k_numBiquads] = {};
+        alignas(16) float B1[k_numBiquads] = {};
+        alignas(16) float B2[k_numBiquads] = {};
+        alignas(16) float A1[k_numBiquads] = {};
+        alignas(16) float A2[k_numBiquads] = {};
+
+        /// Transposed direct form II state and last output.
+        alignas(16) float S1[k_numBiquads] = {};
+        alignas(16) float S2[k_numBiquads] = {};
+        alignas(16) float Y[k_numBiquads] = {};
+    };
+
+    /// State of the true peak FIR.
+    struct TruePeakState
+    {
+        /// Coefficients per tap, oldest sample first, of all phases of all channels (channel-major).
+        alignas(32) float Taps[k_truePeakTaps][k_maxNumChannels * k_truePeakFactor] = {};
+
+        /// Sample history per channel, written twice so the last k_truePeakTaps samples are contiguous at Position + 1.
+        float History[k_maxNumChannels][2 * k_truePeakTaps] = {};
+        size_t Position = 0;
+    };
+
+    /// Histogram of loudness values above the absolute gate.
+    struct Histogram
+    {
+        /// Number of values per bin.
+        std::vector<uint32_t> Counts = std::vector<uint32_t>(k_histogramSize);
+
+        /// Sum of the mean squares of the values per bin.
+        std::vector<double> MeanSquares = std::vector<double>(k_histogramSize);
+    };
+
+    /// Completes a segment, updating the windows and histograms.
+    void completeSegment() noexcept;
+
+    const float m_sampleRate;
+    const SimdLevel m_simdLevel;
+    const size_t m_segmentSize;
+
+    FilterState m_filterState;
+    TruePeakState m_truePeakState;
+
+    /// Segment in progress: number of samples, sum of squares of the channels and true peak (linear).
+    size_t m_segmentFill = 0;
+    double m_segmentSum = 0.0;
+    float m_segmentPeak = 0.0f;
+
+    /// Mean squares of the last k_shortTermSegments segments, a ring buffer.
+    std::array<double, k_shortTermSegments> m_segments = {};
+    uint64_t m_numSegments = 0;
+
+    /// Histograms of the momentary (every segment) and short-term (every segment once the window is full) loudness above the absolute gate.
+    Histogram m_momentaryHistogram;
+    Histogram m_shortTermHistogram;
+
+    LoudnessInfo m_info;
+};
+
+} // namespace spectrex
@@ -0,0 +1,101 @@
+#pragma once
+
+// Spectrex
+#include <Spectrex/Analysis/Fft.hpp>
+#include <Spectrex/Analysis/TableCache.hpp>
+#include <Spectrex/Utility/AlignedAllocator.hpp>
+#include <Spectrex/Utility/Utility.hpp>
+
+// GSL
+#include <gsl/span>
+
+// Stdlib
+#include <cstddef>
+#include <memory>
+
+namespace spectrex {
+
+/// Windowed magnitude FFT whose work is split into chunks that can be performed across successive calls, so the cost of a large transform can be
+/// spread out instead of being paid at once.
+///
+/// A transform consists of the windowed bit-reversed load, the radix-2 butterfly stages and the split pass into magnitudes, the same passes as
+/// BuiltinFft::forwardMagnitudes (sharing its FftPlan). Every pass is cut into chunks of at most k_chunkSize elements or butterflies, each of
+/// which costs about the same, so bounding the number of chunks per call bounds the time per call.
+class PartitionedFft final : public spectrex::NonCopyable
+{
+  public:
+    /// Maximum number of elements or butterflies per chunk.
+    static constexpr size_t k_chunkSize = 256;
+
+    /// Starts a transform. The transform reads its input while loading, so the input must not change until the transform is done.
+    /// @param input Circular buffer of input samples, its size must be a power of two of at least getSize().
+    /// @param first Position of the first (oldest) input sample in \a input, input sample i is input[(first + i) % input.size()].
+    /// @param window getSize() window coefficients.
+    void start(gsl::span<const float> input, size_t first, const float* window) noexcept;
+
+    /// Performs up to \a maxChunks chunks of the current transform.
+    /// @return Whether or not the transform is done, i.e. getMagnitudes is valid.
+    auto step(size_t maxChunks) noexcept -> bool;
+
+    /// Performs all remaining chunks of the current transform.
+    void finish() noexcept;
+
+    /// Abandons the current transform, if any.
+    void cancel() noexcept { m_chunk = m_numChunks; }
+
+    /// Returns whether or not a transform was started and is not done yet.
+    auto isBusy() const noexcept -> bool { return m_chunk < m_numChunks; }
+
+    /// Returns the number of chunks left of the current transform.
+    auto getNumRemainingChunks() const noexcept -> size_t { return m_numChunks - m_chunk; }
+
+    /// Returns the total number of chunks of a transform.
+    auto getNumChunks() const noexcept -> size_t { return m_numChunks; }
+
+    /// Returns the getNumBins() magnitudes of the last completed transform, on the same scale as FftBackend::forwardMagnitudes.
+    auto getMagnitudes() const noexcept -> const float* { return m_magnitudes.data(); }
+
+    /// Returns the transform size.
+    auto getSize() const noexcept -> size_t { return m_size; }
+
+    /// Returns the number of bins, from DC up to and including Nyquist.
+    auto getNumBins() const noexcept -> size_t { return m_size / 2 + 1; }
+
+    /// Constructs a transform.
+    /// @param size Transform size, must be a power of two and at least 4.
+    explicit PartitionedFft(size_t size);
+
+  private:
+    /// Performs a single chunk.
+    void performChunk(size_t chunk) noexcept;
+
+    const size_t m_size;
+
+    /// Size of the complex transform, half the real transform size.
+    const size_t m_halfSize;
+
+    /// Number of chunks of the load pass and of a single butterfly stage.
+    const size_t m_numLoadChunks;
+    const size_t m_numStageChunks;
+
+    /// Number of chunks of a transform.
+    const size_t m_numChunks;
+
+    /// Shared tables.
+    const std::shared_ptr<const FftPlan> m_plan;
+
+    /// Input of the current transform.
+    gsl::span<const float> m_input;
+    size_t m_first = 0;
+    const float* m_window = nullptr;
+
+    /// Next chunk of the current transform, m_numChunks if done.
+    size_t m_chunk;
+
+    /// Work buffers and output.
+    AlignedVector<float> m_re;
+    AlignedVector<float> m_im;
+    AlignedVector<float> m_magnitudes;
+};
+
+} // namespace spectrex
@@ -0,0 +1,81 @@
+#pragma once
+
+// Spectrex
+#include <Spectrex/Analysis/PartitionedFft.hpp>
+#include <Spectrex/Analysis/TableCache.hpp>
+#include <Spectrex/Utility/AlignedAllocator.hpp>
+#include <Spectrex/Utility/Utility.hpp>
+
+// GSL
+#include <gsl/span>
+
+// Stdlib
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace spectrex {
+
+/// Short-time Fourier transform for large transform sizes (e.g. 16384, 32768 or 65536, for sub-bass resolution at high sample rates), with the
+/// work of every frame spread out over the following hop.
+///
+/// Computing a large FFT in the call in which its frame comes due makes the cost per call spike once per hop. Instead, the transform of a frame is
+/// started when it comes due and performed in chunks (see PartitionedFft) along with the samples of the following calls, in proportion to their
+/// number of samples, so it is done by the time the next frame comes due. The cost per call is then about the cost of a frame times the call size
+/// divided by the hop, regardless of how the host splits its blocks. In return, a frame is passed to the handler up to a hop after it came due.
+/// The frames themselves are the same as those of Stft with Method::Fft, up to rounding.
+class PartitionedStft final : public spectrex::NonCopyable
+{
+  public:
+    /// Function receiving the magnitudes of the bins of interest of a frame.
+    using FrameHandler = std::function<void(gsl::span<const float> magnitudes)>;
+
+    /// Processes samples, calling \a handler for every completed frame.
+    void process(gsl::span<const float> samples, const FrameHandler& handler) noexcept;
+
+    /// Resets the sample history, abandoning a frame in progress.
+    void reset() noexcept;
+
+    /// Returns the transform size.
+    auto getSize() const noexcept -> size_t { return m_size; }
+
+    /// Returns the hop size in samples.
+    auto getHop() const noexcept -> size_t { return m_hop; }
+
+    /// Returns the first bin of interest.
+    auto getFirstBin() const noexcept -> size_t { return m_firstBin; }
+
+    /// Returns the number of bins of interest.
+    auto getNumBins() const noexcept -> size_t { return m_numBins; }
+
+    /// Returns whether or not the work of every frame is spread out over the following hop.
+    auto isSpread() const noexcept -> bool { return m_spread; }
+
+    /// Constructs a short-time Fourier transform.
+    /// @param size Transform size, must be a power of two and at least 4.
+    /// @param hop Hop size in samples, at least 1.
+    /// @param firstBin First bin of interest.
+    /// @param lastBin Last bin of interest (inclusive), at most size / 2.
+    /// @param spread Whether or not the work of every frame is spread out over the following hop, otherwise frames are computed in the call in
+    /// which they come due.
+    PartitionedStft(size_t size, size_t hop, size_t firstBin, size_t lastBin, bool spread = true);
+
+  private:
+    const size_t m_size;
+    const size_t m_hop;
+    const size_t m_firstBin;
+    const size_t m_numBins;
+    const bool m_spread;
+
+    /// Number of samples since the last frame came due.
+    size_t m_samplesSinceFrame = 0;
+
+    /// Sample history, holding a hop of samples on top of a frame, so the frame in progress is not overwritten.
+    AlignedVector<float> m_history;
+    size_t m_historyIndex = 0;
+
+    std::shared_ptr<const WindowTable> m_window;
+    PartitionedFft m_fft;
+};
+
+} // namespace spectrex
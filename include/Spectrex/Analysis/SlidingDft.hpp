@@ -0,0 +1,102 @@
+#pragma once
+
+// Spectrex
+#include <Spectrex/Analysis/Fft.hpp>
+#include <Spectrex/Utility/Utility.hpp>
+
+// GSL
+#include <gsl/span>
+
+// Stdlib
+#include <complex>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace spectrex {
+
+/// Sliding DFT, updating a range of bins of an N-point DFT with every incoming sample.
+///
+/// Every sample costs a single complex rotation per bin, independent of N, so whenever the STFT hop is only a few samples (e.g. a StftOverlap close
+/// to 1), updating the bins of interest per sample is cheaper than a full FFT per hop. The bins of the rectangular window are kept, the Hann
+/// window is applied in the frequency domain as a three-tap kernel when the magnitudes are read.
+///
+/// Bins are accumulated in double precision and periodically recomputed from the sample history using an FFT, so rounding errors never build up.
+class SlidingDft final : public spectrex::NonCopyable
+{
+  public:
+    /// Number of windows after which the bins are recomputed from the sample history.
+    static constexpr size_t k_resyncInterval = 64;
+
+    /// Resets all bins and the sample history to zero.
+    void reset() noexcept;
+
+    /// Updates the bins with new samples.
+    void process(gsl::span<const float> samples) noexcept;
+
+    /// Copies the most recent samples of the sample history, oldest first.
+    /// @param samples \a count output samples.
+    /// @param count Number of samples, at most getSize().
+    void copyHistory(float* samples, size_t count) const noexcept;
+
+    /// Replaces the sample history by \a samples, the most recent one last, and recomputes the bins from it. Samples older than \a samples are
+    /// zero, samples beyond getSize() are ignored.
+    void setHistory(gsl::span<const float> samples) noexcept;
+
+    /// Returns the Hann windowed magnitudes of the bins in [getFirstBin(), getFirstBin() + getNumBins()), on the same scale as
+    /// FftBackend::forwardMagnitudes with a (periodic) Hann window.
+    /// @param magnitudes getNumBins() output magnitudes.
+    void getMagnitudes(float* magnitudes) const noexcept;
+
+    /// Returns the DFT size.
+    auto getSize() const noexcept -> size_t { return m_size; }
+
+    /// Returns the first bin of interest.
+    auto getFirstBin() const noexcept -> size_t { return m_firstBin; }
+
+    /// Returns the number of bins of interest.
+    auto getNumBins() const noexcept -> size_t { return m_numBins; }
+
+    /// Constructs a sliding DFT.
+    /// @param size DFT size, must be a power of two and at least 4.
+    /// @param firstBin First bin of interest.
+    /// @param lastBin Last bin of interest (inclusive), at most size / 2.
+    SlidingDft(size_t size, size_t firstBin, size_t lastBin);
+
+  private:
+    /// Recomputes the bins from the sample history.
+    void resync() noexcept;
+
+    /// Returns the rectangular window bin \a k, which may lie just outside of the tracked bins at DC and Nyquist.
+    auto getBin(ptrdiff_t k) const noexcept -> std::complex<double>;
+
+    const size_t m_size;
+    const size_t m_firstBin;
+    const size_t m_numBins;
+
+    /// Tracked bins, the bins of interest extended by a single bin on either side for the window kernel.
+    size_t m_firstStateBin = 0;
+    size_t m_numStateBins = 0;
+
+    /// Rectangular window bins, as split real and imaginary arrays.
+    std::vector<double> m_re;
+    std::vector<double> m_im;
+
+    /// Per sample rotation of every tracked bin.
+    std::vector<double> m_rotationRe;
+    std::vector<double> m_rotationIm;
+
+    /// Sample history of the last getSize() samples.
+    std::vector<float> m_history;
+    size_t m_historyIndex = 0;
+
+    /// Number of samples since the last resync.
+    size_t m_samplesSinceResync = 0;
+
+    /// Resync FFT and work buffers.
+    std::unique_ptr<FftBackend> m_fft;
+    std::vector<float> m_frame;
+    std::vector<std::complex<float>> m_spectrum;
+};
+
+} // namespace spectrex
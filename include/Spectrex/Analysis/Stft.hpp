@@ -0,0 +1,120 @@
+#pragma once
+
+// Spectrex
+#include <Spectrex/Analysis/Fft.hpp>
+#include <Spectrex/Analysis/SlidingDft.hpp>
+#include <Spectrex/Analysis/TableCache.hpp>
+#include <Spectrex/Utility/Utility.hpp>
+
+// GSL
+#include <gsl/span>
+
+// Stdlib
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace spectrex {
+
+/// Short-time Fourier transform, producing a Hann windowed magnitude frame for a range of bins every hop.
+///
+/// Frames are computed using either a full FFT per hop, or a SlidingDft that updates the bins of interest with every sample. The cost of a full FFT
+/// per hop does not depend on the hop, whereas the cost of a sliding DFT grows with the hop and the number of bins. By default, the method with the
+/// lowest estimated cost per hop is chosen, so small hops (a StftOverlap close to 1, see getStftStride) or narrow bin ranges do not pay for a full
+/// FFT per hop. Both methods produce the same frames, up to rounding.
+class Stft final : public spectrex::NonCopyable
+{
+  public:
+    /// Method used to compute frames.
+    enum class Method
+    {
+        /// Chooses the method with the lowest estimated cost per hop.
+        Automatic,
+
+        /// Full FFT per hop.
+        Fft,
+
+        /// Sliding DFT, updated per sample.
+        SlidingDft
+    };
+
+    /// Function receiving the magnitudes of the bins of interest of a frame.
+    using FrameHandler = std::function<void(gsl::span<const float> magnitudes)>;
+
+    /// Returns the estimated cost per hop of a method, in (real) floating point operations.
+    /// @param method Method, either Method::Fft or Method::SlidingDft.
+    /// @param size Transform size.
+    /// @param hop Hop size in samples.
+    /// @param numBins Number of bins of interest.
+    static auto estimateCostPerHop(Method method, size_t size, size_t hop, size_t numBins) noexcept -> double;
+
+    /// Processes samples, calling \a handler for every completed frame.
+    void process(gsl::span<const float> samples, const FrameHandler& handler) noexcept;
+
+    /// Resets the sample history.
+    void reset() noexcept;
+
+    /// Continues the analysis of another transform, e.g. one with a different configuration, by taking over its most recent samples. The next
+    /// frame is computed getHop() samples from now, with the sample history up to then being the history of \a previous.
+    /// @param previous Transform to continue from.
+    void continueFrom(const Stft& previous) noexcept;
+
+    /// Copies the most recent samples of the sample history, oldest first.
+    /// @param samples \a count output samples.
+    /// @param count Number of samples, at most getSize().
+    void copyHistory(float* samples, size_t count) const noexcept;
+
+    /// Returns the number of samples until the next frame is completed, getHop() right after a frame.
+    auto getSamplesToNextFrame() const noexcept -> size_t { return m_hop - m_samplesSinceFrame; }
+
+    /// Returns the method used to compute frames, never Method::Automatic.
+    auto getMethod() const noexcept -> Method { return m_method; }
+
+    /// Returns the transform size.
+    auto getSize() const noexcept -> size_t { return m_size; }
+
+    /// Returns the hop size in samples.
+    auto getHop() const noexcept -> size_t { return m_hop; }
+
+    /// Returns the first bin of interest.
+    auto getFirstBin() const noexcept -> size_t { return m_firstBin; }
+
+    /// Returns the number of bins of interest.
+    auto getNumBins() const noexcept -> size_t { return m_numBins; }
+
+    /// Constructs a short-time Fourier transform.
+    /// @param size Transform size, must be a power of two and at least 4.
+    /// @param hop Hop size in samples, at least 1.
+    /// @param firstBin First bin of interest.
+    /// @param lastBin Last bin of interest (inclusive), at most size / 2.
+    /// @param method Method used to compute frames.
+    Stft(size_t size, size_t hop, size_t firstBin, size_t lastBin, Method method = Method::Automatic);
+
+  private:
+    const size_t m_size;
+    const size_t m_hop;
+    const size_t m_firstBin;
+    const size_t m_numBins;
+    const Method m_method;
+
+    /// Number of samples since the last frame.
+    size_t m_samplesSinceFrame = 0;
+
+    /// Magnitudes of the bins of interest of the current frame.
+    std::vector<float> m_magnitudes;
+
+    /// Linearized sample history, also used by continueFrom.
+    std::vector<float> m_frame;
+
+    /// Full FFT per hop: sample history, window and work buffers.
+    std::unique_ptr<FftBackend> m_fft;
+    std::vector<float> m_history;
+    size_t m_historyIndex = 0;
+    std::shared_ptr<const WindowTable> m_window;
+    std::vector<float> m_spectrum;
+
+    /// Sliding DFT.
+    std::unique_ptr<spectrex::SlidingDft> m_slidingDft;
+};
+
+} // namespace spectrex
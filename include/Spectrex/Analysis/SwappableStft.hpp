@@ -0,0 +1,73 @@
+#pragma once
+
+// Spectrex
+#include <Spectrex/Analysis/Stft.hpp>
+#include <Spectrex/Utility/Utility.hpp>
+
+// GSL
+#include <gsl/span>
+
+// Stdlib
+#include <atomic>
+#include <memory>
+
+namespace spectrex {
+
+/// Short-time Fourier transform whose configuration (size, hop, bins of interest and method) can be changed while processing, without ever
+/// allocating on or stalling the processing thread.
+///
+/// Configurations are double-buffered: configure builds the new transform (FFT plan, window and history buffers) on the calling thread and
+/// publishes it, process swaps it in at the next hop boundary, so no frame mixes configurations. The new transform continues from the most recent
+/// samples of the previous one, so frames keep coming at the usual rate instead of starting over from silence. The previous transform is handed
+/// back and released by the next configure (or releaseRetired), never by the processing thread.
+class SwappableStft final : public spectrex::NonCopyable
+{
+  public:
+    /// Prepares a new configuration, which process swaps in at the next hop boundary. Replaces a configuration that is still pending. Allocates.
+    /// @param size Transform size, must be a power of two and at least 4.
+    /// @param hop Hop size in samples, at least 1.
+    /// @param firstBin First bin of interest.
+    /// @param lastBin Last bin of interest (inclusive), at most size / 2.
+    /// @param method Method used to compute frames.
+    /// @thread configuring (any thread but the processing thread, one at a time)
+    void configure(size_t size, size_t hop, size_t firstBin, size_t lastBin, Stft::Method method = Stft::Method::Automatic);
+
+    /// Releases the transform retired by the last swap, if any. A new configuration is only swapped in once the previous one is released, which
+    /// configure does as well.
+    /// @thread configuring
+    void releaseRetired() noexcept;
+
+    /// Returns whether or not a configuration is waiting to be swapped in.
+    /// @thread any
+    auto isSwapPending() const noexcept -> bool { return m_pending.load(std::memory_order_acquire) != nullptr; }
+
+    /// Processes samples, calling \a handler for every completed frame. Swaps in a pending configuration at the next hop boundary.
+    /// @thread processing
+    void process(gsl::span<const float> samples, const Stft::FrameHandler& handler) noexcept;
+
+    /// Resets the sample history of the active configuration.
+    /// @thread processing
+    void reset() noexcept { m_active->reset(); }
+
+    /// Returns the active transform, e.g. to interpret the frames passed to the handler.
+    /// @thread processing
+    auto getActive() const noexcept -> const Stft& { return *m_active; }
+
+    /// Constructs a transform with an initial configuration, see configure.
+    SwappableStft(size_t size, size_t hop, size_t firstBin, size_t lastBin, Stft::Method method = Stft::Method::Automatic);
+
+    /// Destructor.
+    ~SwappableStft();
+
+  private:
+    /// Transform used by process.
+    std::unique_ptr<Stft> m_active;
+
+    /// Configured transform waiting to be swapped in, owned by whichever thread takes it out.
+    std::atomic<Stft*> m_pending = nullptr;
+
+    /// Swapped out transform waiting to be released, owned by whichever thread takes it out.
+    std::atomic<Stft*> m_retired = nullptr;
+};
+
+} // namespace spectrex
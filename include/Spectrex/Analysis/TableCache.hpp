@@ -0,0 +1,47 @@
+#pragma once
+
+// Spectrex
+#include <Spectrex/Analysis/Fft.hpp>
+#include <Spectrex/Processing/Parameters.hpp>
+#include <Spectrex/Utility/AlignedAllocator.hpp>
+
+// Stdlib
+#include <cstddef>
+#include <memory>
+
+namespace spectrex {
+
+/// Window coefficients, see TableCache::getWindow.
+using WindowTable = AlignedVector<float>;
+
+/// Process-wide cache of the immutable tables of the open analysis code, i.e. FFT plans and window tables.
+///
+/// Every table is built once and shared by all instances that use the same parameters, e.g. all analyzers of a session with the same transform
+/// size, which cuts the time to create many instances as well as resident memory. Tables are reference-counted: an entry is released as soon as
+/// the last instance holding it is destroyed, so the cache never keeps tables of parameters that are no longer used. Table storage is aligned to
+/// a cache line.
+///
+/// None of the tables depend on the sample rate, so it is not part of any key and instances running at different sample rates share tables.
+class TableCache final
+{
+  public:
+    /// Returns the plan of the built-in FFT of a transform size, building it if it is not in use yet. May allocate.
+    /// @param size Transform size, must be a power of two and at least 4.
+    /// @thread any
+    static auto getFftPlan(size_t size) -> std::shared_ptr<const FftPlan>;
+
+    /// Returns the coefficients of a periodic window, building them if they are not in use yet. May allocate. Window::WindowNone is a
+    /// rectangular window.
+    /// @param window Window function.
+    /// @param size Window size.
+    /// @thread any
+    static auto getWindow(Window window, size_t size) -> std::shared_ptr<const WindowTable>;
+
+    /// Returns the number of tables in use, e.g. for diagnostics.
+    /// @thread any
+    static auto getNumTables() -> size_t;
+
+    TableCache() = delete;
+};
+
+} // namespace spectrex
@@ -0,0 +1,174 @@
+#pragma once
+
+// Spectrex
+#include <Spectrex/Analysis/Fft.hpp>
+#include <Spectrex/Processing/Data.hpp>
+#include <Spectrex/Utility/Utility.hpp>
+
+// GSL
+#include <gsl/span>
+
+// Stdlib
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace spectrex {
+
+/// Point of a Vectorscope, a stereo sample pair rotated by 45 degrees into mid (vertical) and side (horizontal). Full scale stereo audio falls
+/// within [-1, 1] on both axes.
+struct VectorscopePoint
+{
+    /// Side, (left - right) / 2.
+    float Side = 0.0f;
+
+    /// Mid, (left + right) / 2.
+    float Mid = 0.0f;
+};
+
+/// State of a Vectorscope.
+struct VectorscopeInfo
+{
+    /// Phase correlation between -1 (out of phase) and 1 (mono), smoothed over Vectorscope::k_correlationTimeConstant. 0 for silence.
+    float Correlation = 0.0f;
+
+    /// Number of samples per point, see Vectorscope::Mode::Points.
+    size_t Decimation = 1;
+
+    /// Factor of the density cells, see Vectorscope::Mode::Density. The cells multiplied by this factor add up to about 1 once the history is
+    /// filled.
+    float DensityScale = 0.0f;
+
+    /// Number of samples processed since the last reset.
+    size_t NumSamples = 0;
+};
+
+/// Vectorscope (goniometer) and correlation meter of a stereo pair, reducing the audio to a display of fixed size whatever the sample rate.
+///
+/// Every sample pair is rotated into mid and side, and the correlation sums are accumulated, in a single vectorized pass (AVX2, or a scalar kernel
+/// on other instruction sets). The rotated points are then either decimated into a ring buffer of a fixed point budget (Mode::Points), which
+/// always covers at least a display frame at k_frameRate, or accumulated into a square 2D density histogram (Mode::Density) that decays over
+/// k_densityTimeConstant. Decay is applied by growing the weight of new samples instead of scaling all cells, so a sample costs a single cell
+/// update.
+class Vectorscope final : public spectrex::NonCopyable
+{
+  public:
+    /// Reduction of the points.
+    enum class Mode
+    {
+        /// A ring buffer of the most recent points, every Decimation-th sample pair.
+        Points,
+
+        /// A 2D density histogram of all sample pairs.
+        Density
+    };
+
+    /// Configuration of a vectorscope.
+    struct Config
+    {
+        /// Reduction of the points.
+        Mode ReductionMode = Mode::Points;
+
+        /// Number of points of Mode::Points.
+        size_t PointBudget = 2048;
+
+        /// Number of cells per side of the density histogram of Mode::Density.
+        size_t DensitySize = 128;
+
+        auto operator==(const Config& other) const noexcept -> bool
+        {
+            return ReductionMode == other.ReductionMode && PointBudget == other.PointBudget && DensitySize == other.DensitySize;
+        }
+        auto operator!=(const Config& other) const noexcept -> bool { return !(*this == other); }
+    };
+
+    /// Lowest display frame rate covered by the points of Mode::Points, in Hz.
+    static constexpr double k_frameRate = 30.0;
+
+    /// Time constant of the density histogram in seconds.
+    static constexpr double k_densityTimeConstant = 0.1;
+
+    /// Time constant of the correlation in seconds.
+    static constexpr double k_correlationTimeConstant = 0.3;
+
+    /// Handler function type definition of Mode::Points, receiving the state and the points in chronological order. As with
+    /// KProcessor::SyncHandler, the points are split in two whenever they wrap around the ring buffer. SyncInfo::RowIndex holds the absolute
+    /// index of the first point, the width is 1 and the height is the number of points. The points are only valid during the call.
+    using PointSyncHandler = std::function<
+      void(const VectorscopeInfo& info, SyncInfo<const VectorscopePoint> first, std::optional<SyncInfo<const VectorscopePoint>> second)>;
+
+    /// Handler function type definition of Mode::Density, receiving the state and the cells. The width and height are Config::DensitySize, side
+    /// increasing along a row and mid increasing with the row index. The cells are only valid during the call.
+    using DensitySyncHandler = std::function<void(const VectorscopeInfo& info, SyncInfo<const float> cells)>;
+
+    /// Processes samples of the left and right channel, both of the same length.
+    void process(AudioChannelView left, AudioChannelView right) noexcept;
+
+    /// Clears the points, density and correlation.
+    void reset() noexcept;
+
+    /// Returns the state.
+    auto getInfo() const noexcept -> VectorscopeInfo;
+
+    /// Passes the points to \a handler, in place. Does nothing unless the mode is Mode::Points.
+    void syncPoints(const PointSyncHandler& handler) const;
+
+    /// Passes the density histogram to \a handler, in place. Does nothing unless the mode is Mode::Density.
+    void syncDensity(const DensitySyncHandler& handler) const;
+
+    /// Returns the configuration.
+    auto getConfig() const noexcept -> const Config& { return m_config; }
+
+    /// Returns the instruction set of the kernel, either SimdLevel::Avx2 or SimdLevel::Scalar.
+    auto getSimdLevel() const noexcept -> SimdLevel { return m_simdLevel; }
+
+    /// Returns the memory used by the points or density histogram in bytes.
+    auto getMemorySize() const noexcept -> size_t;
+
+    /// Constructs a vectorscope.
+    /// @param sampleRate Sample rate in Hz.
+    /// @param config Configuration.
+    /// @param simdLevel Instruction set to use, falls back to the scalar kernel if it is not AVX2 or not supported by the CPU.
+    Vectorscope(float sampleRate, const Config& config, SimdLevel simdLevel = detectSimdLevel());
+
+  private:
+    /// Number of samples rotated at a time.
+    static constexpr size_t k_chunkSize = 64;
+
+    /// Adds a chunk of rotated points to the points or density histogram.
+    void addPoints(const float* side, const float* mid, const int32_t* cells, size_t numPoints) noexcept;
+
+    const float m_sampleRate;
+    const Config m_config;
+    const SimdLevel m_simdLevel;
+
+    /// Ring buffer of points, the number of points added since the last reset and the position of the next point.
+    std::vector<VectorscopePoint> m_points;
+    size_t m_numPoints = 0;
+    size_t m_pointIndex = 0;
+
+    /// Number of samples per point, and the number of samples until the next point.
+    const size_t m_decimation;
+    size_t m_decimationPhase = 0;
+
+    /// Density histogram, the weight of the next sample and its growth per sample.
+    std::vector<float> m_density;
+    float m_densityWeight = 1.0f;
+    const double m_densityGrowth;
+
+    /// Decayed sums of left * right, left * left and right * right, and their decay per sample.
+    double m_correlationSums[3] = {};
+    const double m_correlationDecay;
+
+    /// Number of samples of the last chunk, and the correlation decay and density growth over as many samples.
+    size_t m_chunkSize = 0;
+    double m_chunkDecay = 1.0;
+    float m_chunkGrowth = 1.0f;
+
+    /// Number of samples processed since the last reset.
+    size_t m_numSamples = 0;
+};
+
+} // namespace spectrex
@@ -0,0 +1,238 @@
+#pragma once
+
+// Spectrex
+#include <Spectrex/Analysis/Fft.hpp>
+#include <Spectrex/Processing/Data.hpp>
+#include <Spectrex/Utility/Utility.hpp>
+
+// GSL
+#include <gsl/span>
+
+// Stdlib
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace spectrex {
+
+/// State of a level of a WaveformPyramid.
+struct WaveformPyramidInfo
+{
+    /// Level index, 0 is the finest level.
+    size_t Level = 0;
+
+    /// Number of samples per bin.
+    size_t BinSize = 0;
+
+    /// Number of bins the level holds at most.
+    size_t Capacity = 0;
+
+    /// Absolute index of the newest bin plus one. Bin i covers samples [i * BinSize, (i + 1) * BinSize) since the last reset, the newest bin may be
+    /// incomplete.
+    size_t EndBin = 0;
+
+    /// Number of samples processed since the last reset.
+    size_t NumSamples = 0;
+};
+
+/// Band energies of a bin of a WaveformPyramid, as RMS amplitudes of the low, mid and high band, e.g. for DJ-style colored waveforms.
+struct WaveformBandBin
+{
+    /// RMS amplitude below WaveformPyramid::Crossover::LowMid.
+    float Low = 0.0f;
+
+    /// RMS amplitude between WaveformPyramid::Crossover::LowMid and WaveformPyramid::Crossover::MidHigh.
+    float Mid = 0.0f;
+
+    /// RMS amplitude above WaveformPyramid::Crossover::MidHigh.
+    float High = 0.0f;
+};
+
+/// Mipmapped min/max history of a waveform, so a view at any zoom level reads about one bin per pixel instead of scanning all samples it spans.
+///
+/// The finest level holds a WaveformBin for every k_baseBinSize samples, every next level merges \a factor bins of the previous level. All levels
+/// are updated incrementally as samples arrive, each being a ring buffer covering the same length of history. The newest bin of every coarser
+/// level is updated along with the finest level, so coarse levels are as current as the finest one.
+///
+/// WaveformBin::Frequency is estimated per finest level bin as selected by FrequencyMode, smoothed over k_frequencyTimeConstant. Coarser levels
+/// average the estimates of the bins they merge. The finest level bins, including their frequency estimate, are computed a bin at a time by
+/// vectorized kernels (AVX2) or scalar kernels on other instruction sets.
+///
+/// Optionally, every bin also has a WaveformBandBin, computed in the same pass by a 3-band Linkwitz-Riley (24 dB/octave) crossover and synchronized
+/// separately, see syncBands. The crossover consists of eight biquads: two for the low band, two for the high band and four for the mid band.
+/// They are evaluated as one vector, every biquad taking the output of its predecessor in the previous sample, which delays the bands by up to
+/// three samples but removes the serial dependency. Coarser levels hold the RMS of the bins they merge.
+class WaveformPyramid final : public spectrex::NonCopyable
+{
+  public:
+    /// Estimate of WaveformBin::Frequency, trading quality for cost.
+    enum class FrequencyMode
+    {
+        /// No estimate, the frequency is 0.
+        None,
+
+        /// Zero-crossing rate, i.e. the frequency of the dominant partial of tonal signals. Cheap, but noisy for broadband signals.
+        ZeroCrossing,
+
+        /// Spectral centroid (brightness) of a Hann windowed 32-point DFT over the last two bins. About three times the cost of
+        /// FrequencyMode::ZeroCrossing, but stable for any signal.
+        SpectralCentroid
+    };
+
+    /// Crossover frequencies of the band energies, see WaveformBandBin.
+    struct Crossover
+    {
+        /// Crossover frequency between the low and mid band in Hz.
+        float LowMid = 200.0f;
+
+        /// Crossover frequency between the mid and high band in Hz.
+        float MidHigh = 2000.0f;
+
+        auto operator==(const Crossover& other) const noexcept -> bool { return LowMid == other.LowMid && MidHigh == other.MidHigh; }
+        auto operator!=(const Crossover& other) const noexcept -> bool { return !(*this == other); }
+    };
+
+    /// Number of samples per bin of the finest level.
+    static constexpr size_t k_baseBinSize = 16;
+
+    /// Maximum number of levels.
+    static constexpr size_t k_maxNumLevels = 24;
+
+    /// Time constant of the frequency estimate in seconds.
+    static constexpr double k_frequencyTimeConstant = 0.01;
+
+    /// Handler function type definition, receiving the state of a level and its bins in chronological order. As with KProcessor::SyncHandler,
+    /// the bins are split in two whenever they wrap around the ring buffer. SyncInfo::RowIndex holds the absolute index of the first bin, the
+    /// width is 1 and the height is the number of bins. The bins are only valid during the call.
+    using SyncHandler =
+      std::function<void(const WaveformPyramidInfo& info, SyncInfo<const WaveformBin> first, std::optional<SyncInfo<const WaveformBin>> second)>;
+
+    /// Handler function type definition of the band energies, see SyncHandler. The band bins have the same indices as the bins.
+    using BandSyncHandler = std::function<
+      void(const WaveformPyramidInfo& info, SyncInfo<const WaveformBandBin> first, std::optional<SyncInfo<const WaveformBandBin>> second)>;
+
+    /// Processes samples.
+    void process(gsl::span<const float> samples) noexcept;
+
+    /// Clears the history.
+    void reset() noexcept;
+
+    /// Returns the level whose bin size is closest (on a logarithmic scale) to a pixel at \a pixelsPerSample.
+    auto findLevel(double pixelsPerSample) const noexcept -> size_t;
+
+    /// Returns the state of a level.
+    auto getInfo(size_t level) const noexcept -> WaveformPyramidInfo;
+
+    /// Passes the bins of a level to \a handler, in place.
+    void sync(size_t level, const SyncHandler& handler) const;
+
+    /// Passes the band energies of a level to \a handler, in place. Does nothing if the pyramid has no band energies.
+    void syncBands(size_t level, const BandSyncHandler& handler) const;
+
+    /// Returns whether or not the pyramid has band energies.
+    auto hasBands() const noexcept -> bool { return m_crossover.has_value(); }
+
+    /// Returns the number of levels.
+    auto getNumLevels() const noexcept -> size_t { return m_levels.size(); }
+
+    /// Returns the number of bins of a level merged into a bin of the next level.
+    auto getFactor() const noexcept -> size_t { return m_factor; }
+
+    /// Returns the frequency estimate.
+    auto getFrequencyMode() const noexcept -> FrequencyMode { return m_frequencyMode; }
+
+    /// Returns the instruction set of the kernels, either SimdLevel::Avx2 or SimdLevel::Scalar.
+    auto getSimdLevel() const noexcept -> SimdLevel { return m_simdLevel; }
+
+    /// Returns the memory used by the bins and band bins of all levels in bytes.
+    auto getMemorySize() const noexcept -> size_t;
+
+    /// Constructs a pyramid.
+    /// @param sampleRate Sample rate in Hz.
+    /// @param historySeconds Length of the history in seconds.
+    /// @param factor Number of bins of a level merged into a bin of the next level, at least 2 (typically 2 or 4).
+    /// @param frequencyMode Frequency estimate.
+    /// @param simdLevel Instruction set to use, falls back to the scalar kernels if it is not AVX2 or not supported by the CPU.
+    /// @param crossover Crossover of the band energies, none (the default) to not compute them.
+    WaveformPyramid(float sampleRate,
+                    double historySeconds,
+                    size_t factor,
+                    FrequencyMode frequencyMode = FrequencyMode::ZeroCrossing,
+                    SimdLevel simdLevel = detectSimdLevel(),
+                    std::optional<Crossover> crossover = std::nullopt);
+
+  private:
+    /// Level of the pyramid.
+    struct Level
+    {
+        /// Number of samples per bin.
+        size_t BinSize = 0;
+
+        /// Ring buffer of bins.
+        std::vector<WaveformBin> Bins;
+
+        /// Number of completed bins.
+        size_t NumCompleted = 0;
+
+        /// Number of finest level bins merged into the newest, incomplete bin.
+        size_t NumMerged = 0;
+
+        /// Sum of the frequency estimates merged into the newest bin.
+        float FrequencySum = 0.0f;
+
+        /// Ring buffer of band bins, empty without band energies.
+        std::vector<WaveformBandBin> BandBins;
+
+        /// Sum of the mean squares of the band bins merged into the newest band bin.
+        WaveformBandBin BandSum;
+    };
+
+    /// State of the crossover, one lane per biquad. Lanes 0 and 1 are the low band lowpasses, lanes 2 and 3 the high band highpasses, lanes 4
+    /// and 5 the mid band highpasses and lanes 6 and 7 the mid band lowpasses.
+    struct CrossoverState
+    {
+        /// Biquad coefficients, normalized by a0.
+        alignas(32) float B0[8] = {};
+        alignas(32) float B1[8] = {};
+        alignas(32) float B2[8] = {};
+        alignas(32) float A1[8] = {};
+        alignas(32) float A2[8] = {};
+
+        /// Transposed direct form II state and last output.
+        alignas(32) float S1[8] = {};
+        alignas(32) float S2[8] = {};
+        alignas(32) float Y[8] = {};
+    };
+
+    /// Computes a finest level bin from k_baseBinSize samples and adds it to all levels.
+    void processBin(const float* samples) noexcept;
+
+    /// Adds a completed bin of the finest level, and its band bin if the pyramid has band energies, to all levels.
+    void addBin(const WaveformBin& bin, const WaveformBandBin& bandBin) noexcept;
+
+    const float m_sampleRate;
+    const size_t m_factor;
+    const FrequencyMode m_frequencyMode;
+    const SimdLevel m_simdLevel;
+    const std::optional<Crossover> m_crossover;
+    std::vector<Level> m_levels;
+
+    /// Number of samples processed since the last reset.
+    size_t m_numSamples = 0;
+
+    /// Samples of the finest level bin in progress.
+    float m_binSamples[k_baseBinSize] = {};
+    size_t m_binFill = 0;
+
+    /// Frequency estimate state: sign of the last sample, the samples of the previous bin and the smoothed estimate.
+    bool m_lastPositive = false;
+    float m_previousSamples[k_baseBinSize] = {};
+    float m_frequency = 0.0f;
+    const float m_frequencySmoothing;
+
+    /// Crossover state of the band energies.
+    CrossoverState m_crossoverState;
+};
+
+} // namespace spectrex
@@ -0,0 +1,121 @@
+#pragma once
+
+// Spectrex
+#include <Spectrex/Analysis/Fft.hpp>
+#include <Spectrex/Analysis/FrequencyBand.hpp>
+#include <Spectrex/Analysis/TableCache.hpp>
+#include <Spectrex/Utility/Utility.hpp>
+
+// GSL
+#include <gsl/span>
+
+// Stdlib
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace spectrex {
+
+/// Band-limited short-time Fourier transform (zoom FFT), producing a Hann windowed magnitude frame for a frequency band every hop.
+///
+/// The band is mixed down to baseband with a complex oscillator, low-pass filtered and decimated by a power of two, and only the decimated signal is
+/// transformed. The resolution of a size N zoom FFT with decimation D equals that of a size N * D full band FFT, at a fraction of the cost, so e.g.
+/// the band required by components showing 20 to 500 Hz (see getRequiredBand) can be analyzed at about 1.5 Hz resolution using a 1024 point
+/// transform. For wide bands the decimation drops to 1 and a regular Stft is cheaper.
+class ZoomFft final : public spectrex::NonCopyable
+{
+  public:
+    /// Maximum decimation factor.
+    static constexpr size_t k_maxDecimation = 256;
+
+    /// Function receiving the magnitudes of the bins within the band of a frame.
+    using FrameHandler = std::function<void(gsl::span<const float> magnitudes)>;
+
+    /// Returns the decimation factor used for a band, the largest power of two that leaves enough bandwidth for the band and the anti-aliasing
+    /// filter.
+    /// @param sampleRate Sample rate in Hz.
+    /// @param band Frequency band.
+    static auto getDecimation(double sampleRate, const FrequencyBand& band) noexcept -> size_t;
+
+    /// Processes samples, calling \a handler for every completed frame.
+    void process(gsl::span<const float> samples, const FrameHandler& handler) noexcept;
+
+    /// Resets the oscillator, filter and sample history.
+    void reset() noexcept;
+
+    /// Returns the frequency of a bin within the band, in Hz.
+    auto getBinFrequency(size_t bin) const noexcept -> double;
+
+    /// Returns the distance between bins, in Hz.
+    auto getResolution() const noexcept -> double { return m_resolution; }
+
+    /// Returns the decimation factor.
+    auto getDecimation() const noexcept -> size_t { return m_decimation; }
+
+    /// Returns the transform size, in decimated samples.
+    auto getSize() const noexcept -> size_t { return m_size; }
+
+    /// Returns the hop size in (input) samples, a multiple of the decimation factor.
+    auto getHop() const noexcept -> size_t { return m_hop * m_decimation; }
+
+    /// Returns the number of bins within the band.
+    auto getNumBins() const noexcept -> size_t { return m_numBins; }
+
+    /// Constructs a zoom FFT.
+    /// @param sampleRate Sample rate in Hz.
+    /// @param band Frequency band, clamped to [0, sampleRate / 2].
+    /// @param size Transform size in decimated samples, must be a power of two and at least 4.
+    /// @param hop Hop size in (input) samples, rounded to a multiple of the decimation factor.
+    ZoomFft(double sampleRate, const FrequencyBand& band, size_t size, size_t hop);
+
+  private:
+    /// Computes the frame of the decimated sample history and calls \a handler.
+    void processFrame(const FrameHandler& handler) noexcept;
+
+    const double m_sampleRate;
+    const size_t m_decimation;
+    const size_t m_size;
+    const size_t m_hop;
+
+    /// Centre frequency of the band, mixed down to 0 Hz.
+    double m_centreFrequency = 0.0;
+
+    /// Bin distance, and the (shifted) transform bin of the first bin within the band.
+    double m_resolution = 0.0;
+    size_t m_firstBin = 0;
+    size_t m_numBins = 0;
+
+    /// Complex oscillator and its per sample rotation.
+    double m_oscillatorRe = 1.0;
+    double m_oscillatorIm = 0.0;
+    double m_rotationRe = 1.0;
+    double m_rotationIm = 0.0;
+    size_t m_samplesSinceNormalization = 0;
+
+    /// Anti-aliasing filter taps, and the mixed down history, stored twice so the filter can read contiguously.
+    std::vector<float> m_taps;
+    std::vector<float> m_mixedRe;
+    std::vector<float> m_mixedIm;
+    size_t m_mixedIndex = 0;
+
+    /// Number of input samples since the last decimated sample, and decimated samples since the last frame.
+    size_t m_phase = 0;
+    size_t m_samplesSinceFrame = 0;
+
+    /// Decimated sample history of the last getSize() samples.
+    std::vector<float> m_historyRe;
+    std::vector<float> m_historyIm;
+    size_t m_historyIndex = 0;
+
+    /// The complex transform is computed as two real transforms, of the real and imaginary part.
+    std::unique_ptr<FftBackend> m_fft;
+    std::shared_ptr<const WindowTable> m_window;
+    std::vector<float> m_frameRe;
+    std::vector<float> m_frameIm;
+    std::vector<std::complex<float>> m_spectrumRe;
+    std::vector<std::complex<float>> m_spectrumIm;
+    std::vector<float> m_magnitudes;
+};
+
+} // namespace spectrex
@@ -0,0 +1,136 @@
+#pragma once
+
+// Spectrex
+#include <Spectrex/Utility/Utility.hpp>
+#include <Spectrex/Utility/WakeupEvent.hpp>
+
+// JUCE
+#include <juce_core/juce_core.h>
+
+// Stdlib
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace spectrex {
+
+/// A unit of analysis work that is executed by the AnalysisScheduler, such as the consumer side of a MiniProcessor.
+class AnalysisTask
+{
+  public:
+    /// Returns whether or not the task has any pending work.
+    /// @thread worker
+    virtual auto hasPendingBlocks() noexcept -> bool = 0;
+
+    /// Performs up to \a maxBlocks processing blocks of pending work.
+    /// @param maxBlocks Maximum number of processing blocks to process.
+    /// @return Number of processing blocks actually processed.
+    /// @thread worker
+    virtual auto processPendingBlocks(int maxBlocks) noexcept -> int = 0;
+
+    virtual ~AnalysisTask() = default;
+
+  private:
+    friend class AnalysisScheduler;
+
+    /// Marks the task as being processed by a worker, so that it is never processed by two workers at once.
+    std::atomic_flag m_busy = ATOMIC_FLAG_INIT;
+};
+
+/// Process-wide scheduler that shares a fixed number of worker threads between many analysis tasks (e.g. MiniProcessor instances), instead of
+/// running a dedicated thread per task.
+///
+/// Every task is assigned to the queue of one worker. Workers visit the tasks in their own queue in a round-robin fashion and process at most
+/// k_maxBlocksPerTurn processing blocks per visit, so a single busy task can not starve the others. Whenever a worker has no work left in its own
+/// queue, it steals work from the queues of the other workers. Every queue has its own lock, so workers only contend while stealing. The time a
+/// task waits for a worker is therefore bounded by the number of tasks per worker times the duration of a single turn.
+///
+/// A notify wakes a single worker. Every worker that acquires a task wakes another one before processing it, so the wakeup fans out across the
+/// workers for as long as they find pending tasks, and tasks that become pending at once are processed in parallel.
+class AnalysisScheduler final : public spectrex::NonCopyable
+{
+  public:
+    /// Maximum number of processing blocks a worker processes for a single task before moving on to the next task.
+    static constexpr int k_maxBlocksPerTurn = 16;
+
+    /// Number of CPU cores that are left to the audio threads of the host when the number of workers is determined automatically.
+    static constexpr int k_numReservedAudioThreads = 1;
+
+    /// Timeout for worker wakeup in ms.
+    static constexpr int k_workerTimeoutMs = 15;
+
+    /// Returns the process-wide scheduler, creating it whenever it does not exist yet. The scheduler is destroyed as soon as the last reference to
+    /// it is released.
+    static auto getInstance() -> std::shared_ptr<AnalysisScheduler>;
+
+    /// Sets the number of workers used whenever the process-wide scheduler is created. Does not affect a scheduler that already exists.
+    /// @param numWorkers Number of workers, or 0 to use the number of CPU cores minus k_numReservedAudioThreads.
+    static void setNumWorkers(int numWorkers) noexcept;
+
+    /// Returns the number of workers of this scheduler.
+    auto getNumWorkers() const noexcept -> int { return (int)m_workers.size(); }
+
+    /// Adds a task to the scheduler. The task should outlive its registration.
+    void addTask(AnalysisTask& task);
+
+    /// Removes a task from the scheduler. Blocks until no worker is processing the task anymore.
+    void removeTask(AnalysisTask& task);
+
+    /// Signals that new work is available, waking up a worker that passes the wakeup on whenever it finds work, see AnalysisScheduler.
+    /// @thread any
+    void notify() noexcept { m_wakeupEvent.notify(); }
+
+    ~AnalysisScheduler();
+
+  private:
+    /// Worker thread.
+    class Worker : public juce::Thread
+    {
+      public:
+        void run() override;
+
+        Worker(AnalysisScheduler& owner, size_t index);
+        ~Worker();
+
+      private:
+        AnalysisScheduler& m_owner;
+        const size_t m_index;
+    };
+
+    /// Queue of the tasks assigned to a worker, on its own cache line so that workers scanning their own queue do not share a line.
+    struct alignas(k_cacheLineSize) Queue
+    {
+        /// Tasks of the queue.
+        std::vector<AnalysisTask*> Tasks;
+
+        /// Lock of the tasks, only held to look up or modify tasks, never while processing a task.
+        std::mutex Mutex;
+    };
+
+    /// Acquires the first task in \a queue (starting at \a offset) that has pending work and is not being processed by another worker. Locks
+    /// the queue while looking.
+    /// @return Acquired task, or nullptr if there is none.
+    static auto acquireTask(Queue& queue, size_t offset) noexcept -> AnalysisTask*;
+
+    explicit AnalysisScheduler(int numWorkers);
+
+    /// Requested number of workers for a new scheduler.
+    static std::atomic<int> s_numWorkers;
+
+    /// Per worker queues of tasks.
+    /// @thread worker
+    /// @thread message
+    std::vector<std::unique_ptr<Queue>> m_queues;
+
+    /// Queue a new task is assigned to, modulo the number of queues.
+    std::atomic<size_t> m_nextQueue = 0;
+
+    /// Event workers wait on for new work.
+    WakeupEvent m_wakeupEvent;
+
+    /// Worker threads.
+    std::vector<std::unique_ptr<Worker>> m_workers;
+};
+
+} // namespace spectrex
@@ -1,13 +1,26 @@
 #pragma once
 
 // Spectrex
-#include <Spectrex/Utility/RingBuffer.hpp>
+#include <Spectrex/Analysis/LoudnessMeter.hpp>
+#include <Spectrex/Analysis/Vectorscope.hpp>
+#include <Spectrex/Analysis/WaveformPyramid.hpp>
+#include <Spectrex/AnalysisScheduler.hpp>
+#include <Spectrex/Processing/Data.hpp>
+#include <Spectrex/Utility/SeqLock.hpp>
+#include <Spectrex/Utility/SpscRingBuffer.hpp>
+#include <Spectrex/Utility/WakeupEvent.hpp>
 
 // JUCE
 #include <juce_audio_processors/juce_audio_processors.h>
 
 // Stdlib
+#include <algorithm>
+#include <array>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
 
 namespace spectrex {
 
@@ -15,23 +28,271 @@ class KProcessor;
 
 /// MiniProcessor implements the minimum necessary processing functionality to connect Spectrex to a potential DAW or audio device. It is an open
 /// implementation that can be changed as necessary.
+///
+/// KProcessor analyzes (at most) a stereo pair of channels. To analyze more channels, e.g. 5.1 or 7.1.4 stems, the input channels are split up into
+/// consecutive stereo channel groups, each with its own KProcessor and audio transport. In shared scheduler mode, channel groups are scheduled as
+/// independent tasks so they are analyzed in parallel whenever there are enough workers.
 class MiniProcessor final
 {
   public:
+    /// Minimum processing batch size in samples, equal to KProcessor::getExpectedBlockSize().
+    static constexpr int k_minProcessingBlockSize = 32;
+
+    /// Maximum processing batch size in samples.
+    static constexpr int k_maxProcessingBlockSize = 2048;
+
+    /// Threading mode, determines which thread performs the analysis of the audio data.
+    enum class ThreadingMode
+    {
+        /// Every instance runs its own high priority processing thread.
+        DedicatedThread,
+
+        /// Instances share the workers of the process-wide AnalysisScheduler.
+        SharedScheduler
+    };
+
+    /// Audio-to-analysis latency statistics, i.e. the time between a processing block being handed over by the audio thread and the block being
+    /// analyzed.
+    struct LatencyInfo
+    {
+        /// Exponentially smoothed average latency in milliseconds.
+        double AverageMs = 0.0;
+
+        /// Maximum latency in milliseconds since construction or the last call to resetAnalysisLatency.
+        double MaximumMs = 0.0;
+    };
+
+    /// Analyses whose consumption is tracked separately by demand-driven analysis, see setIdleTimeout.
+    enum class AnalysisKind
+    {
+        /// Spectrogram and waveform analysis of the processors (KProcessor), the bulk of the processing cost.
+        Processors,
+
+        /// Side analyses of this class, i.e. the waveform pyramids, loudness meters and vectorscopes.
+        SideAnalyses
+    };
+
+    /// Numbers of samples the processors analyzed and skipped, counted per channel group, see setIdleTimeout.
+    struct DemandInfo
+    {
+        /// Samples fed to the processors.
+        uint64_t AnalyzedSamples = 0;
+
+        /// Samples drained from the audio transport without feeding them to the processors, because they were not consumed.
+        uint64_t SkippedSamples = 0;
+    };
+
+    /// Memory used per input channel, so hosts can budget before instantiating many channels.
+    struct MemoryInfo
+    {
+        /// Bytes used by the audio transport per channel. Fixed at construction.
+        size_t TransportBytes = 0;
+
+        /// Bytes used by the analysis data (spectrogram and waveform histories) per channel. Depends on the processor parameters and is only
+        /// known after preparation.
+        size_t AnalysisBytes = 0;
+    };
+
     /// Called before playback starts, to let the processor prepare itself. Corresponds to the juce::AudioProcessor::prepareToPlay function.
     void prepareToPlay(double sampleRate, int samplesPerBlock) noexcept;
     /// Renders the next block. Corresponds to the juce::AudioProcessor::processBlock function.
     void processBlock(juce::AudioPlayHead* playHead, juce::AudioSampleBuffer&, juce::MidiBuffer&) noexcept;
     /// Returns the current sample rate. Corresponds to the juce::AudioProcessor::getSampleRate function.
-    double getSampleRate() const noexcept { return m_sampleRate; }
+    double getSampleRate() const noexcept { return m_sampleRate.load(); }
+
+    /// Returns the underlying spectrex::KProcessor of the first channel group.
+    auto getProcessor() const noexcept -> spectrex::KProcessor& { return *m_channelGroups.front()->m_processor; }
+
+    /// Returns the underlying spectrex::KProcessor of a channel group.
+    /// @param group Channel group index, in the range [0, getNumChannelGroups()).
+    auto getProcessor(size_t group) const noexcept -> spectrex::KProcessor& { return *m_channelGroups[group]->m_processor; }
+
+    /// Returns the number of channel groups, i.e. the number of underlying KProcessor instances.
+    auto getNumChannelGroups() const noexcept -> size_t { return m_channelGroups.size(); }
+
+    /// Returns the maximum number of input channels that are analyzed.
+    auto getMaxNumChannels() const noexcept -> int { return m_maxNumChannels; }
+
+    /// Returns the underlying spectrex::KProcessor that analyzes an input channel, together with the Channel that selects the input channel in the
+    /// data synchronization functions of that processor, e.g. KProcessor::syncWaveform.
+    /// @param channel Input channel index, in the range [0, getMaxNumChannels()).
+    auto getProcessorForChannel(int channel) const noexcept -> std::pair<spectrex::KProcessor&, Channel>
+    {
+        return { getProcessor((size_t)channel / k_numGroupChannels), (Channel)(channel % k_numGroupChannels) };
+    }
 
-    /// Returns the underlying spectrex::KProcessor.
-    auto getProcessor() const noexcept -> spectrex::KProcessor& { return *m_processor; }
+    /// Returns the memory used per input channel.
+    auto getMemoryPerChannel() const noexcept -> MemoryInfo;
 
     /// Returns the most recent ppq in quarter notes given by the host.
     auto getLastPosInQtrs() const noexcept -> double { return m_lastTimeInQuarters.load(); }
 
-    MiniProcessor() noexcept;
+    /// Sets the number of samples that must be pending in the audio transport before the audio thread wakes up the processing thread while it is
+    /// still writing a host block. Regardless of the threshold, the processing thread is woken up at the end of every host block that left samples
+    /// pending, so the threshold only splits up host blocks larger than it. Wakeups are coalesced: waking up a processing thread that is still busy
+    /// does not make a system call. A value of 0 wakes up the processing thread for every processing block.
+    /// @param numSamples Wakeup threshold in samples.
+    void setWakeupThreshold(int numSamples) noexcept { m_wakeupThreshold = std::max(0, numSamples); }
+
+    /// Returns the number of samples that must be pending in the audio transport before the audio thread wakes up the processing thread while it
+    /// is still writing a host block.
+    auto getWakeupThreshold() const noexcept -> int { return m_wakeupThreshold.load(); }
+
+    /// Sets the maximum number of samples the processing thread analyzes as a single batch. Per batch bookkeeping, such as reading the host
+    /// position and resynchronizing the processor, is done only once, while the processor itself is still fed processing blocks of
+    /// KProcessor::getExpectedBlockSize() samples, so the analysis does not depend on the batch size. A processing block carrying a note on always
+    /// starts a batch of its own. Batches never wait for data, so larger batches do not add latency. Hosts running large buffers benefit from a
+    /// batch size matching their buffer size.
+    /// @param numSamples Batch size in samples, rounded up to a power of two in the range [k_minProcessingBlockSize, k_maxProcessingBlockSize].
+    void setProcessingBlockSize(int numSamples) noexcept;
+
+    /// Returns the maximum number of samples the processing thread analyzes as a single batch.
+    auto getProcessingBlockSize() const noexcept -> int { return m_processingBlockSize.load(); }
+
+    /// Returns the audio-to-analysis latency statistics, combined over all channel groups.
+    auto getAnalysisLatency() const noexcept -> LatencyInfo;
+
+    /// Resets the maximum of the audio-to-analysis latency statistics.
+    void resetAnalysisLatency() noexcept;
+
+    /// Returns the contention statistics of the transport state handoff from the audio thread to the processing thread(s). The number of retries
+    /// counts how often a processing thread read overlapped with the audio thread publishing a new transport state.
+    auto getTransportStatistics() const noexcept -> SeqLockStatistics { return m_transportState.getStatistics(); }
+
+    /// Returns the threading mode.
+    auto getThreadingMode() const noexcept -> ThreadingMode { return m_threadingMode; }
+
+    /// Sets up the waveform pyramid (see WaveformPyramid) of every input channel, kept up to date by the processing thread along with the analysis
+    /// of the processors. A waveform view then reads about one bin per pixel at any zoom level, see syncWaveformPyramid. Allocates, the pyramids
+    /// are rebuilt (cleared) whenever their configuration or the sample rate changes.
+    /// @param historySeconds Length of the history in seconds, 0 (the default) disables the pyramids.
+    /// @param factor Number of bins of a level merged into a bin of the next level, typically 2 or 4.
+    /// @param frequencyMode Estimate of WaveformBin::Frequency.
+    /// @thread message
+    void setWaveformPyramid(double historySeconds,
+                            int factor = 2,
+                            WaveformPyramid::FrequencyMode frequencyMode = WaveformPyramid::FrequencyMode::ZeroCrossing);
+
+    /// Synchronizes the waveform pyramid level of an input channel whose bins are closest in size to a pixel, see WaveformPyramid::sync. Does
+    /// nothing if the pyramids are disabled or the processor is not prepared yet.
+    /// @param channel Input channel index, in the range [0, getMaxNumChannels()).
+    /// @param pixelsPerSample Horizontal zoom of the view.
+    /// @param handler Handling function. Runs while the processing thread holds back the samples of the side analyses, so it should only
+    /// read the bins in view.
+    /// @thread consumer
+    void syncWaveformPyramid(int channel, double pixelsPerSample, const WaveformPyramid::SyncHandler& handler) const;
+
+    /// Enables or disables the band energies (see WaveformBandBin) of the waveform pyramids, computed in the same pass as the pyramids. Allocates,
+    /// the pyramids are rebuilt (cleared) if the bands change. Has no effect while the pyramids are disabled, see setWaveformPyramid.
+    /// @param enabled Whether or not to compute the band energies, disabled by default.
+    /// @param crossover Crossover frequencies of the bands.
+    /// @thread message
+    void setWaveformBands(bool enabled, WaveformPyramid::Crossover crossover = {});
+
+    /// Synchronizes the band energies of the waveform pyramid level of an input channel whose bins are closest in size to a pixel, see
+    /// syncWaveformPyramid and WaveformPyramid::syncBands. Does nothing if the pyramids or their band energies are disabled.
+    /// @param channel Input channel index, in the range [0, getMaxNumChannels()).
+    /// @param pixelsPerSample Horizontal zoom of the view.
+    /// @param handler Handling function. Runs while the processing thread holds back the samples of the side analyses, so it should only
+    /// read the band bins in view.
+    /// @thread consumer
+    void syncWaveformBands(int channel, double pixelsPerSample, const WaveformPyramid::BandSyncHandler& handler) const;
+
+    /// Enables or disables the loudness meter (see LoudnessMeter) of every channel group, kept up to date by the processing thread along with the
+    /// analysis of the processors. Allocates, the meters are rebuilt (reset) whenever the sample rate changes.
+    /// @param enabled Whether or not to measure loudness, disabled by default.
+    /// @thread message
+    void setLoudnessMeter(bool enabled);
+
+    /// Returns the loudness of the stereo pair of input channels \a channel belongs to, see LoudnessMeter::getInfo. Returns a default LoudnessInfo
+    /// if the meters are disabled or the processor is not prepared yet.
+    /// @param channel Input channel index, in the range [0, getMaxNumChannels()).
+    /// @thread consumer
+    auto getLoudness(int channel) const -> LoudnessInfo;
+
+    /// Restarts the loudness measurement of all channel groups, e.g. at the start of a program.
+    /// @thread consumer
+    void resetLoudness();
+
+    /// Enables or disables the vectorscope and correlation meter (see Vectorscope) of every channel group, kept up to date by the processing thread
+    /// along with the analysis of the processors. Allocates, the vectorscopes are rebuilt (cleared) whenever their configuration or the sample rate
+    /// changes.
+    /// @param enabled Whether or not to compute the vectorscopes, disabled by default.
+    /// @param config Reduction of the points.
+    /// @thread message
+    void setVectorscope(bool enabled, const Vectorscope::Config& config = {});
+
+    /// Synchronizes the vectorscope points of the stereo pair of input channels \a channel belongs to, see Vectorscope::syncPoints. Does nothing
+    /// if the vectorscopes are disabled, not in Vectorscope::Mode::Points or the processor is not prepared yet.
+    /// @param channel Input channel index, in the range [0, getMaxNumChannels()).
+    /// @param handler Handling function. Runs while the processing thread holds back the samples of the side analyses, so it should only
+    /// copy or draw the points.
+    /// @thread consumer
+    void syncVectorscopePoints(int channel, const Vectorscope::PointSyncHandler& handler) const;
+
+    /// Synchronizes the vectorscope density of the stereo pair of input channels \a channel belongs to, see Vectorscope::syncDensity. Does nothing
+    /// if the vectorscopes are disabled, not in Vectorscope::Mode::Density or the processor is not prepared yet.
+    /// @param channel Input channel index, in the range [0, getMaxNumChannels()).
+    /// @param handler Handling function. Runs while the processing thread holds back the samples of the side analyses, so it should only
+    /// copy or draw the cells.
+    /// @thread consumer
+    void syncVectorscopeDensity(int channel, const Vectorscope::DensitySyncHandler& handler) const;
+
+    /// Returns the state of the vectorscope of the stereo pair of input channels \a channel belongs to, e.g. the correlation for a correlation
+    /// meter, see Vectorscope::getInfo. Returns a default VectorscopeInfo if the vectorscopes are disabled or the processor is not prepared yet.
+    /// @param channel Input channel index, in the range [0, getMaxNumChannels()).
+    /// @thread consumer
+    auto getVectorscopeInfo(int channel) const -> VectorscopeInfo;
+
+    /// Registers a consumer of an analysis, e.g. an open editor or an attached KSpectrogramComponent. The analysis stays active as long as any
+    /// consumer is registered. Every call should be matched by a call to removeConsumer.
+    /// @param kind Analysis consumed.
+    /// @thread any
+    void addConsumer(AnalysisKind kind = AnalysisKind::Processors) noexcept { ++m_numConsumers[(size_t)kind]; }
+
+    /// Unregisters a consumer of an analysis, see addConsumer.
+    /// @param kind Analysis consumed.
+    /// @thread any
+    void removeConsumer(AnalysisKind kind = AnalysisKind::Processors) noexcept;
+
+    /// Marks an analysis as consumed, keeping it active for at least the idle timeout. Call this whenever analysis data of the processors is used,
+    /// e.g. along with every data synchronization (KProcessor::cacheSyncWaveformSpectrogram, KProcessor::syncSpectrogram, ...). The
+    /// synchronizations and getters of the side analyses of this class mark the side analyses as consumed themselves, but not the processors.
+    /// @param kind Analysis consumed.
+    /// @thread any
+    void markConsumed(AnalysisKind kind = AnalysisKind::Processors) const noexcept
+    {
+        m_lastConsumedTicks[(size_t)kind] = juce::Time::getHighResolutionTicks();
+    }
+
+    /// Sets the idle timeout of demand-driven analysis. Whenever no consumer of an analysis is registered and it was not consumed for this long,
+    /// it is no longer fed, so instances nobody looks at (e.g. closed editors) cost almost nothing, and an editor that only reads the side analyses
+    /// (e.g. a loudness meter or vectorscope) does not keep the processors analyzing. The audio transport is drained without analysis once neither
+    /// is active. Only the loudness meters, if enabled, keep measuring, as they measure the entire program. Once the processors are consumed
+    /// again, they are invalidated and prepared anew, so they continue from the current host position with cleared histories rather than stale
+    /// data. The waveform pyramids and vectorscopes are cleared likewise once the side analyses are consumed again.
+    /// @param seconds Idle timeout in seconds, 0 (the default) always analyzes.
+    /// @thread any
+    void setIdleTimeout(double seconds) noexcept;
+
+    /// Returns the idle timeout of demand-driven analysis in seconds, 0 if the analysis is always active.
+    /// @thread any
+    auto getIdleTimeout() const noexcept -> double;
+
+    /// Returns whether or not an analysis is active, i.e. whether or not it is fed processing blocks.
+    /// @param kind Analysis.
+    /// @thread any
+    auto isAnalysisActive(AnalysisKind kind = AnalysisKind::Processors) const noexcept -> bool;
+
+    /// Returns the numbers of samples the processors analyzed and skipped since construction, summed over the channel groups.
+    /// @thread any
+    auto getDemandStatistics() const noexcept -> DemandInfo;
+
+    /// Constructs a MiniProcessor.
+    /// @param threadingMode Threading mode, the shared scheduler is recommended for hosts running many instances at once.
+    /// @param maxNumChannels Maximum number of input channels to analyze, any further input channels are ignored. A mono input is mirrored into
+    /// a stereo pair.
+    explicit MiniProcessor(ThreadingMode threadingMode = ThreadingMode::DedicatedThread, int maxNumChannels = 2) noexcept;
     ~MiniProcessor();
 
   private:
@@ -42,7 +303,7 @@ class MiniProcessor final
       public:
         void run() override;
 
-        // Timeout for thread notify in ms
+        // Timeout for thread wakeup in ms
         static constexpr int k_processingThreadTimeoutMs = 15;
 
         ProcessingThread(MiniProcessor& owner);
@@ -53,61 +314,364 @@ class MiniProcessor final
     };
 
   private:
+    /// Gives the tests access to the processing side, so they can drive and measure it on the calling thread.
+    friend struct MiniProcessorTestAccess;
+
     /// The amount of ppq change before a complete resync event is triggered.
     static constexpr double k_resyncPpqThreshold = 1.0;
     /// Initial value of the ppq counter.
     static constexpr double k_PpqInitialState = -1.0f;
 
-    /// Underlying processor.
-    std::shared_ptr<spectrex::KProcessor> m_processor;
-
-    /// Current sample rate.
-    double m_sampleRate = 0;
-
     /// Number of elements (processing blocks) inside ring buffers. Should be "big enough" to accommodate for a heavily lagging processing thread.
     static constexpr int k_ringBufferElements = 4096;
 
-    /// Current number of effective channels that need to be processed.
-    /// @thread audio
-    /// @thread processing
-    std::atomic<int> m_numChannels = 0;
+    /// Number of channel lanes in the audio transport of a channel group.
+    static constexpr int k_numGroupChannels = 2;
+
+    /// Number of samples per channel lane the processing thread holds back from the side analyses while a consumer holds their lock, before it
+    /// waits for the consumer. Covers several batches of the maximum size.
+    static constexpr size_t k_sideAnalysisBacklogSize = 16384;
 
-    /// Ring buffer for audio and MIDI shared between audio and processing. threads.
+    /// Lock-free audio transport shared between audio (single producer) and processing (single consumer) threads, laid out as a struct of arrays.
     ///
-    /// Ideally this would be a SoA not AoS to avoid unpacking but RingBuffer does not allow for this currently.
+    /// Every channel has its own contiguous lane of samples. Information that only changes per block is kept in a separate metadata lane holding one
+    /// BlockData entry per processing block of KProcessor::getExpectedBlockSize() samples. A BlockData entry is published only after all samples of
+    /// its block have been published to the channel lanes, so the consumer drives its reads from the metadata lane.
     ///
     /// @thread audio
     /// @thread processing
-    struct SyncData
+    struct BlockData
     {
-        float left = 0;
-        float right = 0;
-        bool noteOn = false;
+        /// Bitmask of the samples within the block that carry a note on event.
+        uint32_t noteOnMask = 0;
+
+        /// Number of channel lanes holding samples of the block, a single channel is mirrored by the consumer.
+        uint32_t numChannels = 0;
+
+        /// High resolution ticks at which the block was handed over by the audio thread.
+        int64_t publishTicks = 0;
 
-        /// Data that is stored per block only, not per sample.
-        /// This is put into the ring buffer anyway to keep synchronization simple, at the expense of memory space.
+        /// Host position of the most recent sample in the block.
         double ppqPosition = 0;
         double ppqLoopEnd = 0; // Use infinite to encode no loop
     };
-    std::unique_ptr<RingBuffer<SyncData>> m_ringBuffer;
 
-    /// Playhead information (synchronized).
+    /// Host transport state that only changes per host block.
+    ///
+    /// @thread audio
+    /// @thread processing
+    struct TransportState
+    {
+        /// Whether or not the host provided playhead information.
+        bool valid = false;
+
+        bool isPlaying = false;
+        bool isLooping = false;
+        double bpm = 0;
+        int timeSigNumerator = 0;
+        int timeSigDenominator = 0;
+        double ppqLoopStart = 0;
+        double ppqLoopEnd = 0;
+    };
+
+    /// A stereo pair of input channels, analyzed by its own KProcessor and fed by its own audio transport.
+    class ChannelGroup final : public AnalysisTask
+    {
+      public:
+        /// Returns whether or not there are pending processing blocks in the audio transport.
+        /// @thread processing
+        auto hasPendingBlocks() noexcept -> bool override;
+
+        /// Processes up to \a maxBlocks pending processing blocks from the audio transport.
+        /// @return Number of processing blocks processed.
+        /// @thread processing
+        auto processPendingBlocks(int maxBlocks) noexcept -> int override;
+
+        /// Drains up to \a maxBlocks pending processing blocks from the audio transport without analyzing them.
+        /// @return Number of processing blocks drained.
+        /// @thread processing
+        auto skipPendingBlocks(int maxBlocks) noexcept -> int;
+
+        /// Feeds a batch of processing blocks to the side analyses. Never waits for a consumer holding the lock of the side analyses (e.g. while
+        /// its synchronization handler runs) as long as the samples fit into the backlog, which is fed first once the lock is acquired again.
+        /// @thread processing
+        /// @param numChannels Number of channel lanes holding samples, a single channel is mirrored in \a views.
+        /// @param isActive Whether or not the analysis is active, only the loudness meter is fed otherwise.
+        void processSideAnalyses(const std::array<AudioChannelView, k_numGroupChannels>& views, int numChannels, bool isActive) noexcept;
+
+        /// Feeds samples to the side analyses, holding their lock.
+        /// @thread processing
+        void feedSideAnalyses(const std::array<AudioChannelView, k_numGroupChannels>& views, int numChannels, bool isActive) noexcept;
+
+        /// Feeds the backlog to the side analyses and clears it, holding their lock.
+        /// @thread processing
+        void flushSideAnalysisBacklog() noexcept;
+
+        /// Clears the history of the side analyses, except for the loudness meter, which keeps measuring while the analysis is inactive.
+        /// @thread processing
+        void resetSideAnalyses() noexcept;
+
+        /// Prepares the processor anew at the current sample rate of the owner, clearing its histories. Serialized with prepareToPlay through
+        /// m_preparationMutex, so the sample rate the host set last is the one the processor ends up with.
+        /// @return Whether or not the histories were cleared.
+        /// @thread processing
+        auto reprepareProcessor() noexcept -> bool;
+
+        /// Updates the audio-to-analysis latency statistics with a processing block that was handed over at \a publishTicks.
+        /// @thread processing
+        void updateAnalysisLatency(int64_t publishTicks) noexcept;
+
+        /// Updates the play position of the processor from the host position of \a block.
+        /// @thread processing
+        void updatePosition(const BlockData& block, bool isPlaying) noexcept;
+
+        /// Writes a host block into the audio transport and publishes every processing block it completes.
+        /// @param channels Input channels of this group, read directly from the host buffer.
+        /// @param numChannels Number of input channels of this group, either 1 or 2.
+        /// @param blockData Metadata of the published processing blocks, except for the note on bitmask.
+        /// @return Number of published processing blocks, or -1 if the host block was dropped because the transport is full.
+        /// @thread audio
+        auto write(const float* const* channels,
+                   int numChannels,
+                   int numSamples,
+                   const juce::MidiBuffer& midiMessages,
+                   bool triggerEnabled,
+                   const BlockData& blockData) noexcept -> int;
+
+        ChannelGroup(MiniProcessor& owner, size_t index);
+
+        MiniProcessor& m_owner;
+
+        /// Index of this group.
+        const size_t m_index;
+
+        /// Underlying processor.
+        std::shared_ptr<spectrex::KProcessor> m_processor;
+
+        /// Number of input channels in this group of the most recent block, 0 if the group is not fed by the host.
+        /// @thread audio
+        /// @thread processing
+        std::atomic<int> m_numChannels = 0;
+
+        /// Audio transport.
+        std::array<std::unique_ptr<SpscRingBuffer<float>>, k_numGroupChannels> m_audioRingBuffers;
+        std::unique_ptr<SpscRingBuffer<BlockData>> m_blockRingBuffer;
+
+        /// Number of samples written into the current (incomplete) processing block.
+        /// @thread audio
+        uint32_t m_blockFill = 0;
+
+        /// Note on bitmask of the current (incomplete) processing block.
+        /// @thread audio
+        uint32_t m_blockNoteOnMask = 0;
+
+        /// Number of channel lanes of the current (incomplete) processing block.
+        /// @thread audio
+        uint32_t m_blockNumChannels = 0;
+
+        /// Last processed ppq.
+        /// @thread processing
+        double m_lastPpq = k_PpqInitialState;
+
+        /// Whether or not pending blocks have been skipped by the processor, respectively the waveform pyramids and vectorscope, because they
+        /// were inactive.
+        /// @thread processing
+        bool m_skippingProcessor = false;
+        bool m_skippingSideAnalyses = false;
+
+        /// Whether or not the processor needs to be prepared anew (see reprepareProcessor) before it analyzes the next processing block, e.g.
+        /// because it resumes after skipping blocks.
+        /// @thread processing
+        bool m_needsPreparation = false;
+
+        /// Numbers of samples per channel lane fed to the processor and skipped, see getDemandStatistics.
+        /// @thread processing
+        std::atomic<uint64_t> m_numAnalyzedSamples = 0;
+        std::atomic<uint64_t> m_numSkippedSamples = 0;
+
+        /// Audio-to-analysis latency statistics.
+        /// @thread processing
+        std::atomic<double> m_latencyAverageMs = 0.0;
+        std::atomic<double> m_latencyMaximumMs = 0.0;
+        std::atomic<bool> m_latencyResetRequested = false;
+
+        /// Analyses of the open implementation that run along with the processor. Written by the processing thread and read by consumers, both
+        /// while holding the mutex.
+        mutable std::mutex m_sideAnalysisMutex;
+
+        /// Waveform pyramid per channel lane, if enabled.
+        std::array<std::unique_ptr<WaveformPyramid>, k_numGroupChannels> m_waveformPyramids;
+
+        /// Loudness meter of the channel lanes, if enabled.
+        std::unique_ptr<LoudnessMeter> m_loudnessMeter;
+
+        /// Vectorscope of the channel lanes, if enabled.
+        std::unique_ptr<Vectorscope> m_vectorscope;
+
+        /// Samples not fed to the side analyses yet because a consumer held their lock, per channel lane, see processSideAnalyses.
+        /// @thread processing
+        std::array<std::vector<float>, k_numGroupChannels> m_sideAnalysisBacklog;
+
+        /// Number of samples per channel lane in the backlog, and the number of channels and analysis state they were processed with.
+        /// @thread processing
+        size_t m_sideAnalysisBacklogSize = 0;
+        int m_sideAnalysisBacklogChannels = 0;
+        bool m_sideAnalysisBacklogActive = false;
+    };
+
+    /// Wakes up the thread(s) processing this instance.
+    /// @thread audio
+    void wakeUp() noexcept;
+
+  private:
+    /// Configuration the side analyses of all channel groups are built with. The sample rate of an analysis is 0 while it is disabled, and so is
+    /// the rest of its configuration.
+    struct SideAnalysisConfig
+    {
+        struct WaveformPyramidConfig
+        {
+            float SampleRate = 0.0f;
+            double HistorySeconds = 0.0;
+            size_t Factor = 0;
+            WaveformPyramid::FrequencyMode FrequencyMode = WaveformPyramid::FrequencyMode::None;
+            std::optional<WaveformPyramid::Crossover> BandCrossover;
+
+            auto operator==(const WaveformPyramidConfig& other) const noexcept -> bool
+            {
+                return SampleRate == other.SampleRate && HistorySeconds == other.HistorySeconds && Factor == other.Factor &&
+                       FrequencyMode == other.FrequencyMode && BandCrossover == other.BandCrossover;
+            }
+            auto operator!=(const WaveformPyramidConfig& other) const noexcept -> bool { return !(*this == other); }
+        };
+
+        struct LoudnessMeterConfig
+        {
+            float SampleRate = 0.0f;
+
+            auto operator==(const LoudnessMeterConfig& other) const noexcept -> bool { return SampleRate == other.SampleRate; }
+            auto operator!=(const LoudnessMeterConfig& other) const noexcept -> bool { return !(*this == other); }
+        };
+
+        struct VectorscopeConfig
+        {
+            float SampleRate = 0.0f;
+            Vectorscope::Config Reduction;
+
+            auto operator==(const VectorscopeConfig& other) const noexcept -> bool
+            {
+                return SampleRate == other.SampleRate && Reduction == other.Reduction;
+            }
+            auto operator!=(const VectorscopeConfig& other) const noexcept -> bool { return !(*this == other); }
+        };
+
+        WaveformPyramidConfig WaveformPyramids;
+        LoudnessMeterConfig LoudnessMeters;
+        VectorscopeConfig Vectorscopes;
+    };
+
+    /// Rebuilds the side analyses of all channel groups whose configuration or sample rate changed, the others keep their history. Allocates, and
+    /// leaves the side analyses as they are if an allocation fails.
+    /// @thread message
+    /// @thread host
+    void updateSideAnalyses();
+
+    /// Releases the side analyses of all channel groups, e.g. whenever they cannot be rebuilt for a new sample rate.
+    /// @thread host
+    void releaseSideAnalyses() noexcept;
+
+    /// Serializes updateSideAnalyses, which is called from the host (prepareToPlay) as well as from the message thread (the setters). Only the
+    /// holder of this mutex replaces the side analyses.
+    std::mutex m_sideAnalysisUpdateMutex;
+
+    /// Configuration the side analyses are currently built with, guarded by m_sideAnalysisUpdateMutex.
+    SideAnalysisConfig m_sideAnalysisConfig;
+
+    /// Current sample rate.
+    std::atomic<double> m_sampleRate = 0.0;
+
+    /// Serializes preparing the processors at m_sampleRate, which is done by the host (prepareToPlay) as well as by the processing thread
+    /// whenever a processor resumes after skipping blocks (see ChannelGroup::reprepareProcessor).
+    std::mutex m_preparationMutex;
+
+    /// Waveform pyramid configuration, see setWaveformPyramid.
+    std::atomic<double> m_waveformPyramidSeconds = 0.0;
+    std::atomic<int> m_waveformPyramidFactor = 2;
+    std::atomic<WaveformPyramid::FrequencyMode> m_waveformPyramidFrequencyMode = WaveformPyramid::FrequencyMode::ZeroCrossing;
+
+    /// Band energy configuration of the waveform pyramids, see setWaveformBands.
+    std::atomic<bool> m_waveformBandsEnabled = false;
+    std::atomic<float> m_waveformBandsLowMid = WaveformPyramid::Crossover{}.LowMid;
+    std::atomic<float> m_waveformBandsMidHigh = WaveformPyramid::Crossover{}.MidHigh;
+
+    /// Loudness meter configuration, see setLoudnessMeter.
+    std::atomic<bool> m_loudnessMeterEnabled = false;
+
+    /// Vectorscope configuration, see setVectorscope.
+    std::atomic<bool> m_vectorscopeEnabled = false;
+    std::atomic<Vectorscope::Mode> m_vectorscopeMode = Vectorscope::Config{}.ReductionMode;
+    std::atomic<size_t> m_vectorscopePointBudget = Vectorscope::Config{}.PointBudget;
+    std::atomic<size_t> m_vectorscopeDensitySize = Vectorscope::Config{}.DensitySize;
+
+    /// Maximum number of input channels that are analyzed.
+    const int m_maxNumChannels;
+
+    /// Channel groups, the first group is always there.
+    std::vector<std::unique_ptr<ChannelGroup>> m_channelGroups;
+
+    /// Default wakeup threshold in samples, about 5 ms at 48 kHz.
+    static constexpr int k_defaultWakeupThreshold = 256;
+
+    /// Event the processing thread waits on for new data, in dedicated thread mode.
+    /// @thread audio
+    /// @thread processing
+    WakeupEvent m_wakeupEvent;
+
+    /// Wakeup threshold in samples.
+    std::atomic<int> m_wakeupThreshold = k_defaultWakeupThreshold;
+
+    /// Number of samples published (by the first channel group) since the processing thread was last woken up, within the current host block.
+    /// @thread audio
+    int m_samplesSinceWakeup = 0;
+
+    /// Default processing batch size in samples.
+    static constexpr int k_defaultProcessingBlockSize = 512;
+
+    /// Processing batch size in samples.
+    std::atomic<int> m_processingBlockSize = k_defaultProcessingBlockSize;
+
+    /// Smoothing coefficient of the average audio-to-analysis latency, per processing batch.
+    static constexpr double k_latencySmoothing = 0.01;
+
+    /// Number of registered consumers per AnalysisKind.
+    std::array<std::atomic<int>, 2> m_numConsumers{};
+
+    /// High resolution ticks at which every AnalysisKind was last consumed.
+    mutable std::array<std::atomic<int64_t>, 2> m_lastConsumedTicks{};
+
+    /// Idle timeout in high resolution ticks, 0 if the analysis is always active.
+    std::atomic<int64_t> m_idleTimeoutTicks = 0;
+
+    /// Playhead information, published by the audio thread once per host block.
     /// @thread audio
     /// @thread processing
-    juce::AudioPlayHead::CurrentPositionInfo m_playhead;
-    std::atomic<bool> m_playheadValid;
-    std::mutex m_playheadMutex;
+    SeqLock<TransportState> m_transportState;
 
     /// Last time in quarters according to playhead.
     /// @thread audio
     /// @thread processing
     std::atomic<double> m_lastTimeInQuarters = 0.0;
 
-    /// Temporary processing buffer.
+    /// Temporary processing buffer, only used to generate test signals.
     juce::AudioSampleBuffer m_processingBuffer;
 
-    /// Processing thread.
-    ProcessingThread m_processingThread;
+    /// Threading mode.
+    const ThreadingMode m_threadingMode;
+
+    /// Shared scheduler, in shared scheduler mode.
+    std::shared_ptr<AnalysisScheduler> m_scheduler;
+
+    /// Processing thread, in dedicated thread mode.
+    std::unique_ptr<ProcessingThread> m_processingThread;
 };
 
 } // namespace spectrex
@@ -0,0 +1,64 @@
+#pragma once
+
+// Spectrex
+#include <Spectrex/Processing/Data.hpp>
+#include <Spectrex/Utility/Utility.hpp>
+
+// GSL
+#include <gsl/span>
+
+// Stdlib
+#include <cstdint>
+
+namespace spectrex {
+
+class KProcessor;
+
+/// OfflineProcessor feeds entire buffers to a KProcessor as fast as possible, instead of at the pace of an audio device. It is an open
+/// implementation that can be changed as necessary.
+///
+/// The processor is fed exactly like MiniProcessor feeds it in realtime, in processing blocks of KProcessor::getExpectedBlockSize() samples, so
+/// the spectrogram and waveform histories of all complete processing blocks end up identical. A KProcessor analyzes its input strictly in
+/// order, so a single buffer is analyzed on the calling thread; processBatch analyzes many buffers (e.g. a library of stems) in parallel, one
+/// processor per buffer.
+class OfflineProcessor final
+{
+  public:
+    /// A single buffer to analyze.
+    struct Job
+    {
+        /// Processor to feed, which should not be fed by anything else while the job is being processed.
+        KProcessor* Processor = nullptr;
+
+        /// Audio (left channel) input data.
+        AudioChannelView Left;
+
+        /// Audio (right channel) input data, mirrored from the left channel if empty.
+        AudioChannelView Right;
+
+        /// Sample rate of the input data, or 0 to keep the sample rate the processor is configured with.
+        float SampleRate = 0.0f;
+
+        /// Set after processing, true if the processor could be prepared and the input was analyzed.
+        bool Succeeded = false;
+    };
+
+    /// Analyzes a single buffer on the calling thread. The processor is prepared and started at position 0 first. Any trailing samples that do
+    /// not fill an entire processing block are not analyzed, just like MiniProcessor holds them back until the block is complete.
+    /// @param processor Processor to feed.
+    /// @param left Audio (left channel) input data.
+    /// @param right Audio (right channel) input data, mirrored from the left channel if empty.
+    /// @return False if the processor could not be prepared, otherwise true.
+    static auto process(KProcessor& processor, AudioChannelView left, AudioChannelView right) noexcept -> bool;
+
+    /// Analyzes a batch of buffers, distributing the jobs across threads. Blocks until all jobs are finished. Whenever threads cannot be started,
+    /// the jobs are analyzed by fewer threads, down to the calling thread alone.
+    /// @param jobs Jobs to analyze, every job should have a distinct processor.
+    /// @param numThreads Number of threads including the calling thread, or 0 to use the number of CPU cores.
+    /// @return Number of jobs that succeeded.
+    static auto processBatch(gsl::span<Job> jobs, int numThreads = 0) noexcept -> size_t;
+
+    OfflineProcessor() = delete;
+};
+
+} // namespace spectrex
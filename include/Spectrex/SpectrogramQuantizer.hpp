@@ -0,0 +1,53 @@
+#pragma once
+
+// Spectrex
+#include <Spectrex/Processing/Processor.hpp>
+#include <Spectrex/Utility/Quantize.hpp>
+#include <Spectrex/Utility/Utility.hpp>
+
+// Stdlib
+#include <cstdint>
+
+namespace spectrex {
+
+/// SpectrogramQuantizer synchronizes the spectrogram history of a KProcessor as 16-bit values instead of floats. It is an open implementation
+/// that can be changed as necessary.
+///
+/// Only the rows that are synchronized are quantized, straight from the processor's history into the consumer's storage (e.g. a mapped pixel
+/// buffer), so a consumer that mirrors the history (e.g. in a pixel buffer and texture) needs half the memory and upload bandwidth, and nothing is
+/// staged in between. Use one instance per processor, the format can be chosen per instance.
+/// @thread consumer
+class SpectrogramQuantizer final : public spectrex::NonCopyable
+{
+  public:
+    /// Handler function type definition, see KProcessor::SyncHandler. Receives the float SyncInfos of the processor, whose rows are quantized
+    /// with quantizeRows.
+    using SyncHandler = KProcessor::SyncHandler<float>;
+
+    /// Data synchronization function for the spectrogram, see KProcessor::syncSpectrogram. A clear condition is also passed to \a handler
+    /// whenever the format changed since the last synchronization, as previously quantized data is no longer valid.
+    /// @param processor Processor to synchronize.
+    /// @param handler Handling function, quantizing the rows it mirrors with quantizeRows.
+    void syncSpectrogram(KProcessor& processor, const SyncHandler& handler);
+
+    /// Quantizes the rows of a valid SyncInfo to getFormat().
+    /// @param info SyncInfo passed to the handler of syncSpectrogram.
+    /// @param destination Destination of the info.Width * info.Height quantized values, e.g. row info.RowIndex of a mapped pixel buffer.
+    void quantizeRows(const SyncInfo<float>& info, uint16_t* destination) const noexcept;
+
+    /// Sets the format of the quantized data.
+    void setFormat(QuantizedFormat format) noexcept;
+
+    /// Returns the format of the quantized data.
+    auto getFormat() const noexcept -> QuantizedFormat { return m_format; }
+
+    /// Constructs a quantizer.
+    /// @param format Format of the quantized data.
+    explicit SpectrogramQuantizer(QuantizedFormat format = QuantizedFormat::Half) noexcept;
+
+  private:
+    QuantizedFormat m_format;
+    bool m_formatChanged = false;
+};
+
+} // namespace spectrex
@@ -0,0 +1,49 @@
+#pragma once
+
+// spectrex
+#include "Utility.hpp"
+
+// Stdlib
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace spectrex {
+
+/// Standard allocator returning storage aligned to \a Alignment bytes, e.g. so vectorized kernels never straddle cache lines at the start of a table.
+template<typename T, size_t Alignment = k_cacheLineSize>
+struct AlignedAllocator
+{
+    static_assert(Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two of at least alignof(T)");
+
+    using value_type = T;
+
+    template<typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept
+    {
+    }
+
+    auto allocate(size_t n) -> T* { return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{ Alignment })); }
+
+    void deallocate(T* p, size_t) noexcept { ::operator delete(p, std::align_val_t{ Alignment }); }
+
+    template<typename U>
+    auto operator==(const AlignedAllocator<U, Alignment>&) const noexcept -> bool
+    {
+        return true;
+    }
+};
+
+/// Vector with storage aligned to a cache line.
+template<typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+} // namespace spectrex
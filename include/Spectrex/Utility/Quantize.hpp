@@ -0,0 +1,151 @@
+#pragma once
+
+// Stdlib
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace spectrex {
+
+/// 16-bit format of quantized magnitudes.
+enum class QuantizedFormat
+{
+    /// IEEE 754 half-precision float, e.g. for GL_R16F textures. Precision is relative (about 0.01 dB), but magnitudes below about -84 dBFS lose
+    /// precision as subnormals.
+    Half,
+
+    /// Magnitude in dB, linearly mapped from [k_logUint16MinDb, k_logUint16MaxDb] onto [1, 65535], e.g. for GL_R16 textures. Code 0 is
+    /// reserved for a magnitude of exactly 0, so silence stays distinguishable from quiet signals. Precision is about 0.003 dB over the entire
+    /// range.
+    LogUint16
+};
+
+/// dB value of the lowest non-zero LogUint16 code, 1. Magnitudes below it are clamped to it, only a magnitude of 0 encodes as code 0.
+constexpr float k_logUint16MinDb = -160.0f;
+
+/// dB value of the highest LogUint16 code.
+constexpr float k_logUint16MaxDb = 32.0f;
+
+namespace detail {
+
+/// Returns the bits of \a value reinterpreted as a \a To of the same size.
+template<typename To, typename From>
+inline auto
+bitCast(const From& value) noexcept -> To
+{
+    static_assert(sizeof(To) == sizeof(From), "bitCast requires types of the same size");
+    To result;
+    std::memcpy(&result, &value, sizeof(To));
+    return result;
+}
+
+} // namespace detail
+
+/// Converts a float to a half-precision float, rounding to nearest even.
+inline auto
+floatToHalf(float value) noexcept -> uint16_t
+{
+    auto bits = detail::bitCast<uint32_t>(value);
+    const auto sign = bits & 0x80000000u;
+    bits ^= sign;
+
+    uint32_t half = 0;
+    if (bits >= 0x47800000u) {
+        // Overflow to infinity, or NaN
+        half = bits > 0x7f800000u ? 0x7e00u : 0x7c00u;
+    } else if (bits < 0x38800000u) {
+        // Subnormal or zero, let the floating point unit do the rounding
+        constexpr uint32_t magic = 126u << 23;
+        const auto sum = detail::bitCast<float>(bits) + detail::bitCast<float>(magic);
+        half = detail::bitCast<uint32_t>(sum) - magic;
+    } else {
+        // Normal, rebias the exponent and round the mantissa to nearest even
+        const auto odd = (bits >> 13) & 1u;
+        bits += (uint32_t)(15 - 127) * (1u << 23) + 0xfffu + odd;
+        half = bits >> 13;
+    }
+
+    return (uint16_t)(half | (sign >> 16));
+}
+
+/// Converts a half-precision float to a float.
+inline auto
+halfToFloat(uint16_t half) noexcept -> float
+{
+    constexpr uint32_t exponentMask = 0x7c00u << 13;
+
+    auto bits = (uint32_t)(half & 0x7fffu) << 13;
+    const auto exponent = bits & exponentMask;
+    bits += (uint32_t)(127 - 15) << 23;
+
+    if (exponent == exponentMask) {
+        // Infinity or NaN
+        bits += (uint32_t)(128 - 16) << 23;
+    } else if (exponent == 0) {
+        // Subnormal or zero, renormalize
+        constexpr uint32_t magic = 113u << 23;
+        bits += 1u << 23;
+        bits = detail::bitCast<uint32_t>(detail::bitCast<float>(bits) - detail::bitCast<float>(magic));
+    }
+
+    return detail::bitCast<float>(bits | ((uint32_t)(half & 0x8000u) << 16));
+}
+
+/// Encodes a magnitude as LogUint16.
+inline auto
+magnitudeToLogUint16(float magnitude) noexcept -> uint16_t
+{
+    if (!(magnitude > 0.0f)) {
+        return 0;
+    }
+
+    const auto db = 20.0f * std::log10(magnitude);
+    const auto normalized = (db - k_logUint16MinDb) / (k_logUint16MaxDb - k_logUint16MinDb);
+    return (uint16_t)(1 + std::lround(std::clamp(normalized, 0.0f, 1.0f) * 65534.0f));
+}
+
+/// Decodes a LogUint16 magnitude.
+inline auto
+logUint16ToMagnitude(uint16_t code) noexcept -> float
+{
+    if (code == 0) {
+        return 0.0f;
+    }
+
+    const auto db = k_logUint16MinDb + (float)(code - 1) / 65534.0f * (k_logUint16MaxDb - k_logUint16MinDb);
+    return std::pow(10.0f, db / 20.0f);
+}
+
+/// Quantizes a number of magnitudes.
+/// @param format Format to quantize to.
+/// @param input Magnitudes.
+/// @param output Quantized magnitudes.
+/// @param count Number of magnitudes.
+inline void
+quantize(QuantizedFormat format, const float* input, uint16_t* output, size_t count) noexcept
+{
+    if (format == QuantizedFormat::Half) {
+        std::transform(input, input + count, output, floatToHalf);
+    } else {
+        std::transform(input, input + count, output, magnitudeToLogUint16);
+    }
+}
+
+/// Dequantizes a number of magnitudes.
+/// @param format Format of the quantized magnitudes.
+/// @param input Quantized magnitudes.
+/// @param output Magnitudes.
+/// @param count Number of magnitudes.
+inline void
+dequantize(QuantizedFormat format, const uint16_t* input, float* output, size_t count) noexcept
+{
+    if (format == QuantizedFormat::Half) {
+        std::transform(input, input + count, output, halfToFloat);
+    } else {
+        std::transform(input, input + count, output, logUint16ToMagnitude);
+    }
+}
+
+} // namespace spectrex
@@ -3,12 +3,34 @@
 // spectrex
 #include "Utility.hpp"
 
+// GSL
+#include <gsl/span>
+
 // Stdlib
+#include <algorithm>
+#include <cstring>
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace spectrex {
 
+/// Readable region of a ring buffer. Memory starts at \a First and continues at \a Second whenever the region wraps around the end of the
+/// underlying storage, similar to the first/second split of SyncInfo.
+/// @tparam T Type of data.
+template<typename T>
+struct RingBufferRegion
+{
+    /// Oldest part of the region, which is always there (but may be empty).
+    gsl::span<const T> First;
+
+    /// Newest part of the region, which only exists when the region wraps around.
+    std::optional<gsl::span<const T>> Second;
+
+    /// Returns the total number of elements in this region.
+    auto size() const noexcept -> size_t { return First.size() + (Second ? Second->size() : 0); }
+};
+
 /// Generic circular ring buffer implementation.
 template<typename T>
 class RingBuffer final : public spectrex::NonCopyable
@@ -22,7 +44,7 @@ class RingBuffer final : public spectrex::NonCopyable
     }
 
     /// Gets the "previous" value before the head.
-    void getPreviousValue(T& output) const { output = m_buffer[(m_head - 1) % m_capacity]; }
+    void getPreviousValue(T& output) const { output = m_buffer[wrap(m_head + m_capacity - 1)]; }
 
     /// Resets the ring buffer to its initial state without clearing the internal buffer.
     void resetIndices() noexcept { m_tail = m_head = 0; }
@@ -31,33 +53,63 @@ class RingBuffer final : public spectrex::NonCopyable
     void advance(int offset) noexcept
     {
         if (m_capacity > 0) {
-            m_head = (m_head + offset) % m_capacity;
+            m_head = wrap(m_head + offset);
         }
     }
 
     /// Skips the ring buffer by the given number of elements.
-    void skip(int n) noexcept { m_tail = (m_tail + n) % m_capacity; }
+    void skip(int n) noexcept { m_tail = wrap(m_tail + n); }
 
     /// Pushes a new value into the ring buffer.
     void push(const T& value)
     {
         m_buffer[m_head] = value;
-        m_head = (m_head + 1) % m_capacity;
+        m_head = wrap(m_head + 1);
     }
 
-    /// Reads a number of elements from the ring buffer.
+    /// Writes a number of elements into the ring buffer using at most two block copies. Like push, this overwrites the oldest elements whenever the
+    /// ring buffer is full.
+    void write(gsl::span<const T> values) noexcept
+    {
+        // Only the most recent m_capacity elements can survive the write, they end where as many pushes would end
+        if (values.size() > m_capacity) {
+            m_head = wrap(m_head + values.size() - m_capacity);
+            values = values.subspan(values.size() - m_capacity);
+        }
+
+        const auto nFirst = std::min(m_capacity - m_head, values.size());
+        std::memcpy(m_buffer.data() + m_head, values.data(), nFirst * sizeof(T));
+        std::memcpy(m_buffer.data(), values.data() + nFirst, (values.size() - nFirst) * sizeof(T));
+        m_head = wrap(m_head + values.size());
+    }
+
+    /// Reads a number of elements from the ring buffer using at most two block copies.
     void read(T* dst, int n) noexcept
     {
-        const auto nCopy = std::min((size_t)(m_capacity - m_tail), (size_t)n);
-        memcpy(dst, m_buffer.data() + m_tail, nCopy * sizeof(T));
-        m_tail = (m_tail + nCopy) % m_capacity;
+        const auto nFirst = std::min(m_capacity - m_tail, (size_t)n);
+        std::memcpy(dst, m_buffer.data() + m_tail, nFirst * sizeof(T));
+        std::memcpy(dst + nFirst, m_buffer.data(), (n - nFirst) * sizeof(T));
+        m_tail = wrap(m_tail + n);
+    }
+
+    /// Returns the currently readable elements in place, without consuming them. The region stays valid until the next write or commitRead.
+    auto peekContiguous() const noexcept -> RingBufferRegion<T>
+    {
+        RingBufferRegion<T> region;
 
-        if (n > 0) {
-            n -= nCopy;
-            read(dst + nCopy, n);
+        const auto n = (size_t)getReadSpace();
+        const auto nFirst = std::min(m_capacity - m_tail, n);
+        region.First = gsl::span<const T>(m_buffer.data() + m_tail, nFirst);
+        if (n > nFirst) {
+            region.Second = gsl::span<const T>(m_buffer.data(), n - nFirst);
         }
+
+        return region;
     }
 
+    /// Consumes a number of elements, typically after processing them in place using peekContiguous.
+    void commitRead(size_t n) noexcept { m_tail = wrap(m_tail + n); }
+
     /// Returns the number of available elements to read from the ring buffer.
     int getReadSpace() const noexcept
     {
@@ -77,6 +129,7 @@ class RingBuffer final : public spectrex::NonCopyable
     /// Constructs a ring buffer.
     explicit RingBuffer(size_t capacity, T defaultValue)
       : m_capacity(capacity)
+      , m_mask((capacity & (capacity - 1)) == 0 ? capacity - 1 : 0)
       , m_buffer(capacity, defaultValue)
       , m_head(0)
       , m_tail(0)
@@ -84,8 +137,14 @@ class RingBuffer final : public spectrex::NonCopyable
     }
 
   private:
+    /// Wraps an index into the storage, using a mask instead of a modulo for power-of-two capacities.
+    auto wrap(size_t index) const noexcept -> size_t { return m_mask != 0 ? index & m_mask : index % m_capacity; }
+
     const size_t m_capacity;
 
+    /// Mask of a power-of-two capacity, 0 otherwise.
+    const size_t m_mask;
+
     std::vector<T> m_buffer;
 
     size_t m_head = 0;
@@ -0,0 +1,138 @@
+#pragma once
+
+// spectrex
+#include "Utility.hpp"
+
+// Stdlib
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace spectrex {
+
+/// Contention statistics of a SeqLock.
+struct SeqLockStatistics
+{
+    /// Number of values stored.
+    uint64_t NumWrites = 0;
+
+    /// Number of values loaded.
+    uint64_t NumReads = 0;
+
+    /// Number of times a load had to retry because it overlapped with a store.
+    uint64_t NumRetries = 0;
+};
+
+/// Sequence lock to publish a small value from a single (realtime) writer thread to any number of reader threads.
+///
+/// The writer never waits: a store bumps the sequence counter to an odd value, writes the value and bumps the sequence counter to an even value
+/// again. Readers retry whenever they observe an odd sequence counter, or whenever the sequence counter changed while they were reading. The value
+/// is kept as relaxed atomic words, so torn reads are detected rather than being a data race.
+///
+/// Since readers retry instead of blocking the writer, the number of retries is a direct measure of contention and is exposed via getStatistics.
+template<typename T>
+class SeqLock final : public spectrex::NonCopyable
+{
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock requires a trivially copyable value type");
+
+  public:
+    /// Number of retries after which a reader yields, to let a preempted writer finish its store.
+    static constexpr uint64_t k_retriesBeforeYield = 16;
+
+    /// Publishes a new value.
+    /// @thread writer
+    void store(const T& value) noexcept
+    {
+        Words words{};
+        std::memcpy(words.data(), &value, sizeof(T));
+
+        const auto sequence = m_sequence.load(std::memory_order_relaxed);
+        m_sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (size_t i = 0; i < k_numWords; ++i) {
+            m_words[i].store(words[i], std::memory_order_relaxed);
+        }
+
+        m_sequence.store(sequence + 2, std::memory_order_release);
+        m_numWrites.store(m_numWrites.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    /// Returns the most recently published value, retrying for as long as a store is in progress.
+    /// @thread reader
+    auto load() const noexcept -> T
+    {
+        Words words;
+        uint64_t numRetries = 0;
+
+        for (;;) {
+            const auto sequence = m_sequence.load(std::memory_order_acquire);
+
+            if ((sequence & 1) == 0) {
+                for (size_t i = 0; i < k_numWords; ++i) {
+                    words[i] = m_words[i].load(std::memory_order_relaxed);
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+
+                if (m_sequence.load(std::memory_order_relaxed) == sequence) {
+                    break;
+                }
+            }
+
+            if (++numRetries >= k_retriesBeforeYield) {
+                std::this_thread::yield();
+            }
+        }
+
+        m_numReads.fetch_add(1, std::memory_order_relaxed);
+        if (numRetries > 0) {
+            m_numRetries.fetch_add(numRetries, std::memory_order_relaxed);
+        }
+
+        T value;
+        std::memcpy(static_cast<void*>(&value), words.data(), sizeof(T));
+
+        return value;
+    }
+
+    /// Returns the contention statistics since construction.
+    /// @thread any
+    auto getStatistics() const noexcept -> SeqLockStatistics
+    {
+        SeqLockStatistics statistics;
+        statistics.NumWrites = m_numWrites.load(std::memory_order_relaxed);
+        statistics.NumReads = m_numReads.load(std::memory_order_relaxed);
+        statistics.NumRetries = m_numRetries.load(std::memory_order_relaxed);
+
+        return statistics;
+    }
+
+    /// Constructs a sequence lock holding a default constructed value.
+    SeqLock() noexcept { store(T{}); }
+
+    /// Constructs a sequence lock.
+    /// @param initialValue Value returned by load until the first store.
+    explicit SeqLock(const T& initialValue) noexcept { store(initialValue); }
+
+  private:
+    /// Number of words the value is stored in.
+    static constexpr size_t k_numWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    using Words = std::array<uint64_t, k_numWords>;
+
+    /// Sequence counter, odd while a store is in progress.
+    alignas(k_cacheLineSize) std::atomic<uint64_t> m_sequence{ 0 };
+
+    /// Value, as individually atomic words.
+    std::array<std::atomic<uint64_t>, k_numWords> m_words{};
+
+    /// Statistics, written by the writer and the readers respectively.
+    std::atomic<uint64_t> m_numWrites{ 0 };
+    alignas(k_cacheLineSize) mutable std::atomic<uint64_t> m_numReads{ 0 };
+    mutable std::atomic<uint64_t> m_numRetries{ 0 };
+};
+
+} // namespace spectrex
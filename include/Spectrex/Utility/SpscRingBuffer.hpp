@@ -0,0 +1,198 @@
+#pragma once
+
+// spectrex
+#include "RingBuffer.hpp"
+#include "Utility.hpp"
+
+// GSL
+#include <gsl/span>
+
+// Stdlib
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace spectrex {
+
+/// Lock-free single-producer/single-consumer circular ring buffer.
+///
+/// Unlike RingBuffer, this class is safe to share between exactly one producer thread and exactly one consumer thread. Indices are monotonically
+/// increasing counters published with release semantics and observed with acquire semantics, so any element written before a publish is visible to
+/// the other thread after it observes the new index.
+///
+/// The producer and consumer indices live on separate cache lines. Each side additionally keeps a cached copy of the opposite index, which is only
+/// refreshed when the cached value suggests the buffer is full (producer) or empty (consumer). On the hot path the producer therefore never reads the
+/// consumer's cache line and vice versa.
+///
+/// The buffer never overwrites unread data: whenever it is full, push and write will reject (part of) the input.
+template<typename T>
+class SpscRingBuffer final : public spectrex::NonCopyable
+{
+    static_assert(std::is_trivially_copyable<T>::value, "SpscRingBuffer requires a trivially copyable element type");
+
+  public:
+    /// Resets the ring buffer to its initial state. Must not be called while either the producer or the consumer is active.
+    void reset() noexcept
+    {
+        m_producer.Head.store(0, std::memory_order_relaxed);
+        m_producer.CachedTail = 0;
+        m_consumer.Tail.store(0, std::memory_order_relaxed);
+        m_consumer.CachedHead = 0;
+    }
+
+    /// Returns the total number of elements the ring buffer can hold.
+    auto getCapacity() const noexcept -> size_t { return m_capacity; }
+
+    /// Pushes a new value into the ring buffer.
+    /// @return False if the ring buffer is full and the value was dropped, otherwise true.
+    /// @thread producer
+    auto push(const T& value) noexcept -> bool
+    {
+        const auto head = m_producer.Head.load(std::memory_order_relaxed);
+
+        if (head - m_producer.CachedTail == m_capacity) {
+            m_producer.CachedTail = m_consumer.Tail.load(std::memory_order_acquire);
+
+            if (head - m_producer.CachedTail == m_capacity) {
+                return false;
+            }
+        }
+
+        m_buffer[wrap(head)] = value;
+        m_producer.Head.store(head + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /// Writes a number of elements into the ring buffer using at most two block copies, publishing them all at once.
+    /// @return Number of elements actually written, which is less than the number of \a values if the ring buffer is full.
+    /// @thread producer
+    auto write(gsl::span<const T> values) noexcept -> size_t
+    {
+        const auto head = m_producer.Head.load(std::memory_order_relaxed);
+
+        if (m_capacity - (head - m_producer.CachedTail) < values.size()) {
+            m_producer.CachedTail = m_consumer.Tail.load(std::memory_order_acquire);
+        }
+
+        const auto n = std::min(values.size(), m_capacity - (head - m_producer.CachedTail));
+
+        const auto index = wrap(head);
+        const auto nFirst = std::min(m_capacity - index, n);
+        std::memcpy(m_buffer.data() + index, values.data(), nFirst * sizeof(T));
+        std::memcpy(m_buffer.data(), values.data() + nFirst, (n - nFirst) * sizeof(T));
+
+        m_producer.Head.store(head + n, std::memory_order_release);
+
+        return n;
+    }
+
+    /// Reads a number of elements from the ring buffer using at most two block copies.
+    /// @return Number of elements actually read, which is less than \a n if not enough elements were available.
+    /// @thread consumer
+    auto read(T* dst, size_t n) noexcept -> size_t
+    {
+        const auto region = peekContiguous(n);
+        std::memcpy(dst, region.First.data(), region.First.size() * sizeof(T));
+        if (region.Second) {
+            std::memcpy(dst + region.First.size(), region.Second->data(), region.Second->size() * sizeof(T));
+        }
+
+        commitRead(region.size());
+
+        return region.size();
+    }
+
+    /// Returns (up to \a maxElements of) the currently readable elements in place, without consuming them. The region stays valid and is not
+    /// overwritten by the producer until it is consumed using commitRead.
+    /// @thread consumer
+    auto peekContiguous(size_t maxElements = std::numeric_limits<size_t>::max()) noexcept -> RingBufferRegion<T>
+    {
+        const auto tail = m_consumer.Tail.load(std::memory_order_relaxed);
+
+        if (m_consumer.CachedHead - tail < maxElements) {
+            m_consumer.CachedHead = m_producer.Head.load(std::memory_order_acquire);
+        }
+
+        const auto n = std::min(maxElements, m_consumer.CachedHead - tail);
+
+        RingBufferRegion<T> region;
+
+        const auto index = wrap(tail);
+        const auto nFirst = std::min(m_capacity - index, n);
+        region.First = gsl::span<const T>(m_buffer.data() + index, nFirst);
+        if (n > nFirst) {
+            region.Second = gsl::span<const T>(m_buffer.data(), n - nFirst);
+        }
+
+        return region;
+    }
+
+    /// Consumes a number of elements, typically after processing them in place using peekContiguous. Hands the storage back to the producer.
+    /// @param n Number of elements, should not exceed the number of elements returned by the last peekContiguous.
+    /// @thread consumer
+    void commitRead(size_t n) noexcept
+    {
+        m_consumer.Tail.store(m_consumer.Tail.load(std::memory_order_relaxed) + n, std::memory_order_release);
+    }
+
+    /// Returns the number of available elements to read from the ring buffer.
+    /// @thread consumer
+    auto getReadSpace() noexcept -> size_t
+    {
+        m_consumer.CachedHead = m_producer.Head.load(std::memory_order_acquire);
+
+        return m_consumer.CachedHead - m_consumer.Tail.load(std::memory_order_relaxed);
+    }
+
+    /// Returns the number of elements that can be written into the ring buffer without dropping any.
+    /// @thread producer
+    auto getWriteSpace() noexcept -> size_t
+    {
+        m_producer.CachedTail = m_consumer.Tail.load(std::memory_order_acquire);
+
+        return m_capacity - (m_producer.Head.load(std::memory_order_relaxed) - m_producer.CachedTail);
+    }
+
+    /// Constructs a ring buffer.
+    /// @param capacity Number of elements the ring buffer can hold.
+    /// @param defaultValue Value the storage is initialized with.
+    explicit SpscRingBuffer(size_t capacity, T defaultValue)
+      : m_capacity(capacity)
+      , m_mask((capacity & (capacity - 1)) == 0 ? capacity - 1 : 0)
+      , m_buffer(capacity, defaultValue)
+    {
+        KASSERT(capacity > 0, "Capacity must be non-zero");
+    }
+
+  private:
+    /// State written by the producer, read by the consumer only when its cached head runs out.
+    struct alignas(k_cacheLineSize) ProducerState
+    {
+        std::atomic<size_t> Head{ 0 };
+        size_t CachedTail = 0;
+    };
+
+    /// State written by the consumer, read by the producer only when its cached tail runs out.
+    struct alignas(k_cacheLineSize) ConsumerState
+    {
+        std::atomic<size_t> Tail{ 0 };
+        size_t CachedHead = 0;
+    };
+
+    /// Wraps a monotonic index into the storage, using a mask instead of a modulo for power-of-two capacities.
+    auto wrap(size_t index) const noexcept -> size_t { return m_mask != 0 ? index & m_mask : index % m_capacity; }
+
+    const size_t m_capacity;
+    const size_t m_mask;
+
+    std::vector<T> m_buffer;
+
+    ProducerState m_producer;
+    ConsumerState m_consumer;
+};
+
+} // namespace spectrex
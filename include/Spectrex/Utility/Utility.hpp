@@ -15,8 +15,14 @@
 #define KASSERT(condition, msg) assert(condition)
 #endif
 
+// Stdlib
+#include <cstddef>
+
 namespace spectrex {
 
+/// Assumed size of a cache line in bytes, used to keep data written by different threads on separate cache lines.
+constexpr size_t k_cacheLineSize = 64;
+
 /// Utility class to enforce non-copyable semantics.
 struct NonCopyable
 {
@@ -0,0 +1,146 @@
+#pragma once
+
+// spectrex
+#include "Utility.hpp"
+
+// Stdlib
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <dispatch/dispatch.h>
+#else
+#include <condition_variable>
+#include <mutex>
+#endif
+
+namespace spectrex {
+
+/// Auto-reset event to wake up a waiting thread from a (realtime) signalling thread.
+///
+/// Signals are coalesced: any number of notify calls before the next wait result in a single wakeup. A notify only performs a system call whenever
+/// a thread is actually waiting, so notifying a thread that is still busy is just two atomic operations. The system call never takes a lock: on
+/// Linux this is built directly on a futex, on Windows on an auto-reset event object (available since Windows 7), and on macOS on a dispatch
+/// semaphore. The event object and the semaphore may wake up a waiter early (wait then returns false, as on a timeout). Only the fallback of
+/// other platforms uses a condition variable, whose notify locks a mutex shared with the waiter and is therefore not realtime safe.
+class WakeupEvent final : public spectrex::NonCopyable
+{
+  public:
+#if defined(__APPLE__)
+    WakeupEvent() noexcept
+      : m_semaphore(dispatch_semaphore_create(0))
+    {
+    }
+
+    ~WakeupEvent()
+    {
+        // Dispatch objects are released automatically whenever they are Objective-C objects
+#if !OS_OBJECT_USE_OBJC
+        dispatch_release(m_semaphore);
+#endif
+    }
+#elif defined(_WIN32)
+    WakeupEvent() noexcept
+      : m_event(CreateEventW(nullptr, FALSE, FALSE, nullptr))
+    {
+    }
+
+    ~WakeupEvent() { CloseHandle(m_event); }
+#endif
+
+    /// Signals the event, waking up a waiting thread if there is one.
+    /// @thread any
+    void notify() noexcept
+    {
+        // Both operations are sequentially consistent, pairing with the ones in wait, so that either the waiter observes the signal, or this
+        // observes the waiter
+        if (m_signaled.exchange(1) != 0 || m_numWaiters.load() == 0) {
+            return;
+        }
+
+#if defined(__linux__)
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&m_signaled), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#elif defined(_WIN32)
+        SetEvent(m_event);
+#elif defined(__APPLE__)
+        dispatch_semaphore_signal(m_semaphore);
+#else
+        std::lock_guard<std::mutex> lock{ m_mutex };
+        m_condition.notify_one();
+#endif
+    }
+
+    /// Waits for the event to be signaled, or for the timeout to expire, and resets the event.
+    /// @param timeoutMs Timeout in milliseconds.
+    /// @return True if the event was signaled, false on timeout.
+    /// @thread waiter
+    auto wait(int timeoutMs) noexcept -> bool
+    {
+#if defined(__linux__)
+        m_numWaiters.fetch_add(1);
+        if (m_signaled.load() == 0) {
+            // Returns immediately whenever the event was signaled in the meantime
+            timespec timeout{ timeoutMs / 1000, (timeoutMs % 1000) * 1000000L };
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&m_signaled), FUTEX_WAIT_PRIVATE, 0, &timeout, nullptr, 0);
+        }
+        m_numWaiters.fetch_sub(1);
+#elif defined(_WIN32)
+        m_numWaiters.fetch_add(1);
+        if (m_signaled.load() == 0) {
+            // A set of the event object that was not waited for returns the next wait early
+            WaitForSingleObject(m_event, (DWORD)timeoutMs);
+        }
+        m_numWaiters.fetch_sub(1);
+#elif defined(__APPLE__)
+        m_numWaiters.fetch_add(1);
+        if (m_signaled.load() == 0) {
+            // A signal of the semaphore that was not waited for returns the next wait early
+            dispatch_semaphore_wait(m_semaphore, dispatch_time(DISPATCH_TIME_NOW, (int64_t)timeoutMs * 1000000));
+        }
+        m_numWaiters.fetch_sub(1);
+#else
+        {
+            std::unique_lock<std::mutex> lock{ m_mutex };
+            m_numWaiters.fetch_add(1);
+            m_condition.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this] { return m_signaled.load() != 0; });
+            m_numWaiters.fetch_sub(1);
+        }
+#endif
+
+        return m_signaled.exchange(0) != 0;
+    }
+
+  private:
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "Futex word must be a plain 32-bit integer");
+
+    /// Signal state, 1 if signaled, otherwise 0. Doubles as the futex word on Linux.
+    std::atomic<uint32_t> m_signaled{ 0 };
+
+    /// Number of threads currently (about to be) waiting.
+    std::atomic<uint32_t> m_numWaiters{ 0 };
+
+#if defined(__APPLE__)
+    dispatch_semaphore_t m_semaphore;
+#elif defined(_WIN32)
+    HANDLE m_event;
+#elif !defined(__linux__)
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+#endif
+};
+
+} // namespace spectrex
@@ -0,0 +1,236 @@
+#include <Spectrex/Analysis/ConstantQ.hpp>
+
+// Stdlib
+#include <algorithm>
+#include <cmath>
+
+namespace spectrex {
+
+namespace {
+
+/// Number of taps of the half-band anti-aliasing filter.
+constexpr size_t k_numFilterTaps = 63;
+
+/// Kernel coefficients below this fraction of the largest coefficient of
+/// their bin are dropped.
+constexpr double k_kernelThreshold = 0.0054;
+
+} // namespace
+
+ConstantQ::ConstantQ(double sampleRate,
+                     double minFrequency,
+                     double maxFrequency,
+                     size_t binsPerOctave,
+                     size_t hop)
+  : m_sampleRate(sampleRate)
+  , m_binsPerOctave(std::max<size_t>(1, binsPerOctave))
+  , m_hop(std::max<size_t>(1, hop))
+{
+    const auto pi = std::acos(-1.0);
+    maxFrequency = std::min(maxFrequency, k_maxRelativeFrequency * sampleRate);
+    KASSERT(minFrequency > 0.0 && minFrequency <= maxFrequency,
+            "Frequency range must not be empty");
+
+    const auto bins = (double)m_binsPerOctave;
+    m_numBins =
+      (size_t)std::floor(bins * std::log2(maxFrequency / minFrequency) + 1e-9) +
+      1;
+    m_topFrequency =
+      minFrequency * std::exp2((double)(m_numBins - 1) / bins);
+    m_octaves.resize((m_numBins + m_binsPerOctave - 1) / m_binsPerOctave);
+
+    // Every bin spans one bin spacing, so its window length follows from the
+    // quality factor; the lowest bin of the top octave sets the FFT size
+    const auto q = 1.0 / (std::exp2(1.0 / bins) - 1.0);
+    const auto lowestFrequency =
+      m_topFrequency * std::exp2(-(double)(m_binsPerOctave - 1) / bins);
+    m_size = 4;
+    while ((double)m_size < std::ceil(q * sampleRate / lowestFrequency)) {
+        m_size *= 2;
+    }
+
+    m_fft = FftBackendRegistry::create(m_size);
+    m_frame.resize(m_size);
+    m_spectrum.resize(m_size / 2 + 1);
+    m_magnitudes.resize(m_numBins);
+
+    // Spectral kernel of the top octave. Every bin is a Hann windowed complex
+    // exponential, aligned to the end of the frame to minimize latency. Its
+    // transform is computed as two real transforms, of which only the
+    // positive frequencies are kept, since the kernel has (almost) no energy
+    // at negative frequencies
+    std::vector<float> kernelRe(m_size);
+    std::vector<float> kernelIm(m_size);
+    std::vector<std::complex<float>> spectrumRe(m_size / 2 + 1);
+    std::vector<std::complex<float>> spectrumIm(m_size / 2 + 1);
+    std::vector<std::complex<double>> kernel(m_size / 2 + 1);
+
+    m_kernelOffsets.push_back(0);
+    for (size_t b = 0; b < m_binsPerOctave; ++b) {
+        const auto frequency = m_topFrequency * std::exp2(-(double)b / bins);
+        const auto length = std::min(
+          m_size, (size_t)std::lround(q * sampleRate / frequency));
+        const auto start = m_size - length;
+
+        auto windowSum = 0.0;
+        std::fill(kernelRe.begin(), kernelRe.end(), 0.0f);
+        std::fill(kernelIm.begin(), kernelIm.end(), 0.0f);
+        for (size_t i = 0; i < length; ++i) {
+            const auto window =
+              0.5 - 0.5 * std::cos(2.0 * pi * (double)i / (double)length);
+            const auto phase = 2.0 * pi * frequency * (double)i / sampleRate;
+            kernelRe[start + i] = (float)(window * std::cos(phase));
+            kernelIm[start + i] = (float)(window * std::sin(phase));
+            windowSum += window;
+        }
+
+        m_fft->forward(kernelRe.data(), spectrumRe.data());
+        m_fft->forward(kernelIm.data(), spectrumIm.data());
+
+        auto maxMagnitude = 0.0;
+        for (size_t k = 0; k <= m_size / 2; ++k) {
+            const auto re = std::complex<double>(spectrumRe[k]);
+            const auto im = std::complex<double>(spectrumIm[k]);
+            kernel[k] = re + std::complex<double>(0.0, 1.0) * im;
+            maxMagnitude = std::max(maxMagnitude, std::abs(kernel[k]));
+        }
+
+        // By Parseval, the inner product of a frame with the kernel is the
+        // inner product of their spectra divided by N. Fold that, the window
+        // gain and the factor 2 of a real sinusoid into the coefficients, so
+        // a sinusoid of amplitude A reads A
+        const auto scale = 2.0 / ((double)m_size * windowSum);
+        for (size_t k = 0; k <= m_size / 2; ++k) {
+            if (std::abs(kernel[k]) >= k_kernelThreshold * maxMagnitude) {
+                m_kernelBins.push_back((uint32_t)k);
+                m_kernelCoefficients.emplace_back(std::conj(kernel[k]) * scale);
+            }
+        }
+        m_kernelOffsets.push_back((uint32_t)m_kernelBins.size());
+    }
+
+    // Half-band Blackman windowed sinc, every other tap apart from the centre
+    // is zero
+    const auto centre = (double)(k_numFilterTaps - 1) / 2.0;
+    auto filterSum = 0.0;
+    m_filterTaps.resize(k_numFilterTaps);
+    for (size_t i = 0; i < k_numFilterTaps; ++i) {
+        const auto x = (double)i - centre;
+        const auto sinc =
+          x == 0.0 ? 0.5 : std::sin(0.5 * pi * x) / (pi * x);
+        const auto phase = 2.0 * pi * (double)i / (double)(k_numFilterTaps - 1);
+        const auto window =
+          0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+        m_filterTaps[i] = (float)(sinc * window);
+        filterSum += sinc * window;
+    }
+    for (auto& tap : m_filterTaps) {
+        tap = (float)(tap / filterSum);
+    }
+
+    for (auto& octave : m_octaves) {
+        octave.History.resize(m_size);
+        octave.FilterHistory.resize(2 * k_numFilterTaps);
+    }
+}
+
+void
+ConstantQ::reset() noexcept
+{
+    for (auto& octave : m_octaves) {
+        std::fill(octave.History.begin(), octave.History.end(), 0.0f);
+        octave.HistoryIndex = 0;
+        std::fill(
+          octave.FilterHistory.begin(), octave.FilterHistory.end(), 0.0f);
+        octave.FilterIndex = 0;
+        octave.Decimate = false;
+    }
+
+    m_samplesSinceFrame = 0;
+}
+
+auto
+ConstantQ::getBinFrequency(size_t bin) const noexcept -> double
+{
+    return m_topFrequency *
+           std::exp2(-(double)(m_numBins - 1 - bin) / (double)m_binsPerOctave);
+}
+
+void
+ConstantQ::process(gsl::span<const float> samples,
+                   const FrameHandler& handler) noexcept
+{
+    const auto numOctaves = m_octaves.size();
+    const auto* taps = m_filterTaps.data();
+
+    for (const auto sample : samples) {
+        // Feed the sample through the octaves, every decimation stage only
+        // passes on every other sample
+        auto value = sample;
+        for (size_t o = 0; o < numOctaves; ++o) {
+            auto& octave = m_octaves[o];
+            octave.History[octave.HistoryIndex] = value;
+            octave.HistoryIndex = (octave.HistoryIndex + 1) & (m_size - 1);
+
+            if (o + 1 == numOctaves) {
+                break;
+            }
+
+            auto& index = octave.FilterIndex;
+            octave.FilterHistory[index] = value;
+            octave.FilterHistory[index + k_numFilterTaps] = value;
+            index = index + 1 == k_numFilterTaps ? 0 : index + 1;
+
+            octave.Decimate = !octave.Decimate;
+            if (octave.Decimate) {
+                break;
+            }
+
+            const auto* history = octave.FilterHistory.data() + index;
+            value = 0.0f;
+            for (size_t i = 0; i < k_numFilterTaps; ++i) {
+                value += taps[i] * history[i];
+            }
+        }
+
+        if (++m_samplesSinceFrame < m_hop) {
+            continue;
+        }
+        m_samplesSinceFrame = 0;
+
+        for (size_t o = 0; o < numOctaves; ++o) {
+            processOctave(o);
+        }
+        handler(m_magnitudes);
+    }
+}
+
+void
+ConstantQ::processOctave(size_t octave) noexcept
+{
+    const auto& state = m_octaves[octave];
+
+    // Linearize the history, oldest sample first
+    std::copy(state.History.begin() + state.HistoryIndex,
+              state.History.end(),
+              m_frame.begin());
+    std::copy(state.History.begin(),
+              state.History.begin() + state.HistoryIndex,
+              m_frame.begin() + (m_size - state.HistoryIndex));
+
+    m_fft->forward(m_frame.data(), m_spectrum.data());
+
+    // The bins of every octave are the bins of the top octave, an octave
+    // lower at half the sample rate
+    const auto topBin = m_numBins - 1 - octave * m_binsPerOctave;
+    const auto numBins = std::min(m_binsPerOctave, topBin + 1);
+    for (size_t b = 0; b < numBins; ++b) {
+        auto bin = std::complex<float>();
+        for (auto k = m_kernelOffsets[b]; k < m_kernelOffsets[b + 1]; ++k) {
+            bin += m_spectrum[m_kernelBins[k]] * m_kernelCoefficients[k];
+        }
+        m_magnitudes[topBin - b] = std::abs(bin);
+    }
+}
+
+} // namespace spectrex
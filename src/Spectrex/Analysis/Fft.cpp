@@ -0,0 +1,708 @@
+#include <Spectrex/Analysis/Fft.hpp>
+
+// Spectrex
+#include <Spectrex/Analysis/TableCache.hpp>
+
+// Stdlib
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) ||            \
+  defined(_M_IX86)
+#define SPECTREX_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define SPECTREX_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+// Functions using AVX2 need to be compiled for it explicitly, whereas the rest
+// of the library is compiled for the baseline instruction set
+#if defined(SPECTREX_SIMD_X86) && !defined(_MSC_VER)
+#define SPECTREX_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define SPECTREX_TARGET_SSE __attribute__((target("sse2")))
+#else
+#define SPECTREX_TARGET_AVX2
+#define SPECTREX_TARGET_SSE
+#endif
+
+namespace spectrex {
+
+namespace {
+
+/// Performs the radix-2 decimation in time stages with a half size of
+/// \a firstHalf and up, one butterfly at a time.
+void
+stagesScalar(float* re,
+             float* im,
+             const float* twRe,
+             const float* twIm,
+             size_t n,
+             size_t firstHalf) noexcept
+{
+    for (size_t half = firstHalf; half < n; half *= 2) {
+        for (size_t b = 0; b < n; b += 2 * half) {
+            for (size_t j = 0; j < half; ++j) {
+                const auto wr = twRe[half + j];
+                const auto wi = twIm[half + j];
+                const auto br = re[b + j + half];
+                const auto bi = im[b + j + half];
+                const auto tr = br * wr - bi * wi;
+                const auto ti = br * wi + bi * wr;
+                re[b + j + half] = re[b + j] - tr;
+                im[b + j + half] = im[b + j] - ti;
+                re[b + j] += tr;
+                im[b + j] += ti;
+            }
+        }
+    }
+}
+
+#if defined(SPECTREX_SIMD_X86)
+
+/// Loads \a n complex values from \a input in bit-reversed order, windowed
+/// whenever \a window is not null, eight at a time. The permutation is its own
+/// inverse, so element i is gathered from sample pair bitReversal[i], and the
+/// work buffers are written contiguously.
+SPECTREX_TARGET_AVX2 void
+loadAvx2(const float* input,
+         const float* window,
+         const uint32_t* bitReversal,
+         float* re,
+         float* im,
+         size_t n) noexcept
+{
+    const auto one = _mm256_set1_epi32(1);
+    for (size_t i = 0; i < n; i += 8) {
+        const auto even = _mm256_slli_epi32(
+          _mm256_loadu_si256((const __m256i*)(bitReversal + i)), 1);
+        const auto odd = _mm256_add_epi32(even, one);
+        auto evenSamples = _mm256_i32gather_ps(input, even, 4);
+        auto oddSamples = _mm256_i32gather_ps(input, odd, 4);
+        if (window != nullptr) {
+            evenSamples =
+              _mm256_mul_ps(evenSamples, _mm256_i32gather_ps(window, even, 4));
+            oddSamples =
+              _mm256_mul_ps(oddSamples, _mm256_i32gather_ps(window, odd, 4));
+        }
+        _mm256_storeu_ps(re + i, evenSamples);
+        _mm256_storeu_ps(im + i, oddSamples);
+    }
+}
+
+/// Computes the magnitudes of the real-input bins from 1 up, eight bins at a
+/// time, see BuiltinFft::split.
+/// @return First bin that is not computed yet.
+SPECTREX_TARGET_AVX2 auto
+splitMagnitudesAvx2(const float* re,
+                    const float* im,
+                    const float* splitRe,
+                    const float* splitIm,
+                    size_t n,
+                    float* magnitudes) noexcept -> size_t
+{
+    const auto half = _mm256_set1_ps(0.5f);
+    const auto reverse = _mm256_set_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+    size_t k = 1;
+    for (; k + 8 <= n; k += 8) {
+        // Bins n - k down to n - k - 7
+        const auto mirrorRe =
+          _mm256_permutevar8x32_ps(_mm256_loadu_ps(re + n - k - 7), reverse);
+        const auto mirrorIm =
+          _mm256_permutevar8x32_ps(_mm256_loadu_ps(im + n - k - 7), reverse);
+        const auto binRe = _mm256_loadu_ps(re + k);
+        const auto binIm = _mm256_loadu_ps(im + k);
+
+        const auto evenRe = _mm256_mul_ps(half, _mm256_add_ps(binRe, mirrorRe));
+        const auto evenIm = _mm256_mul_ps(half, _mm256_sub_ps(binIm, mirrorIm));
+        const auto oddRe = _mm256_mul_ps(half, _mm256_add_ps(binIm, mirrorIm));
+        const auto oddIm = _mm256_mul_ps(half, _mm256_sub_ps(mirrorRe, binRe));
+
+        const auto wr = _mm256_loadu_ps(splitRe + k);
+        const auto wi = _mm256_loadu_ps(splitIm + k);
+        const auto outRe = _mm256_add_ps(
+          evenRe, _mm256_fmsub_ps(oddRe, wr, _mm256_mul_ps(oddIm, wi)));
+        const auto outIm = _mm256_add_ps(
+          evenIm, _mm256_fmadd_ps(oddRe, wi, _mm256_mul_ps(oddIm, wr)));
+
+        _mm256_storeu_ps(
+          magnitudes + k,
+          _mm256_sqrt_ps(_mm256_fmadd_ps(
+            outRe, outRe, _mm256_mul_ps(outIm, outIm))));
+    }
+
+    return k;
+}
+
+/// Computes the magnitudes of the real-input bins from 1 up, four bins at a
+/// time, see BuiltinFft::split.
+/// @return First bin that is not computed yet.
+SPECTREX_TARGET_SSE auto
+splitMagnitudesSse(const float* re,
+                   const float* im,
+                   const float* splitRe,
+                   const float* splitIm,
+                   size_t n,
+                   float* magnitudes) noexcept -> size_t
+{
+    const auto half = _mm_set1_ps(0.5f);
+
+    size_t k = 1;
+    for (; k + 4 <= n; k += 4) {
+        // Bins n - k down to n - k - 3
+        const auto loadedRe = _mm_loadu_ps(re + n - k - 3);
+        const auto loadedIm = _mm_loadu_ps(im + n - k - 3);
+        const auto mirrorRe =
+          _mm_shuffle_ps(loadedRe, loadedRe, _MM_SHUFFLE(0, 1, 2, 3));
+        const auto mirrorIm =
+          _mm_shuffle_ps(loadedIm, loadedIm, _MM_SHUFFLE(0, 1, 2, 3));
+        const auto binRe = _mm_loadu_ps(re + k);
+        const auto binIm = _mm_loadu_ps(im + k);
+
+        const auto evenRe = _mm_mul_ps(half, _mm_add_ps(binRe, mirrorRe));
+        const auto evenIm = _mm_mul_ps(half, _mm_sub_ps(binIm, mirrorIm));
+        const auto oddRe = _mm_mul_ps(half, _mm_add_ps(binIm, mirrorIm));
+        const auto oddIm = _mm_mul_ps(half, _mm_sub_ps(mirrorRe, binRe));
+
+        const auto wr = _mm_loadu_ps(splitRe + k);
+        const auto wi = _mm_loadu_ps(splitIm + k);
+        const auto outRe = _mm_add_ps(
+          evenRe, _mm_sub_ps(_mm_mul_ps(oddRe, wr), _mm_mul_ps(oddIm, wi)));
+        const auto outIm = _mm_add_ps(
+          evenIm, _mm_add_ps(_mm_mul_ps(oddRe, wi), _mm_mul_ps(oddIm, wr)));
+
+        _mm_storeu_ps(magnitudes + k,
+                      _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(outRe, outRe),
+                                             _mm_mul_ps(outIm, outIm))));
+    }
+
+    return k;
+}
+
+/// Performs the stages with a half size of 4 and up, four butterflies at a
+/// time.
+SPECTREX_TARGET_SSE void
+stagesSse(float* re,
+          float* im,
+          const float* twRe,
+          const float* twIm,
+          size_t n) noexcept
+{
+    for (size_t half = 4; half < n; half *= 2) {
+        for (size_t b = 0; b < n; b += 2 * half) {
+            for (size_t j = 0; j < half; j += 4) {
+                const auto wr = _mm_loadu_ps(twRe + half + j);
+                const auto wi = _mm_loadu_ps(twIm + half + j);
+                const auto ar = _mm_loadu_ps(re + b + j);
+                const auto ai = _mm_loadu_ps(im + b + j);
+                const auto br = _mm_loadu_ps(re + b + j + half);
+                const auto bi = _mm_loadu_ps(im + b + j + half);
+                const auto tr =
+                  _mm_sub_ps(_mm_mul_ps(br, wr), _mm_mul_ps(bi, wi));
+                const auto ti =
+                  _mm_add_ps(_mm_mul_ps(br, wi), _mm_mul_ps(bi, wr));
+                _mm_storeu_ps(re + b + j, _mm_add_ps(ar, tr));
+                _mm_storeu_ps(im + b + j, _mm_add_ps(ai, ti));
+                _mm_storeu_ps(re + b + j + half, _mm_sub_ps(ar, tr));
+                _mm_storeu_ps(im + b + j + half, _mm_sub_ps(ai, ti));
+            }
+        }
+    }
+}
+
+/// Performs the stages with a half size of 8 and up, eight butterflies at a
+/// time.
+SPECTREX_TARGET_AVX2 void
+stagesAvx2(float* re,
+           float* im,
+           const float* twRe,
+           const float* twIm,
+           size_t n) noexcept
+{
+    for (size_t half = 8; half < n; half *= 2) {
+        for (size_t b = 0; b < n; b += 2 * half) {
+            for (size_t j = 0; j < half; j += 8) {
+                const auto wr = _mm256_loadu_ps(twRe + half + j);
+                const auto wi = _mm256_loadu_ps(twIm + half + j);
+                const auto ar = _mm256_loadu_ps(re + b + j);
+                const auto ai = _mm256_loadu_ps(im + b + j);
+                const auto br = _mm256_loadu_ps(re + b + j + half);
+                const auto bi = _mm256_loadu_ps(im + b + j + half);
+                const auto tr = _mm256_fmsub_ps(br, wr, _mm256_mul_ps(bi, wi));
+                const auto ti = _mm256_fmadd_ps(br, wi, _mm256_mul_ps(bi, wr));
+                _mm256_storeu_ps(re + b + j, _mm256_add_ps(ar, tr));
+                _mm256_storeu_ps(im + b + j, _mm256_add_ps(ai, ti));
+                _mm256_storeu_ps(re + b + j + half, _mm256_sub_ps(ar, tr));
+                _mm256_storeu_ps(im + b + j + half, _mm256_sub_ps(ai, ti));
+            }
+        }
+    }
+}
+
+#endif // SPECTREX_SIMD_X86
+
+#if defined(SPECTREX_SIMD_NEON)
+
+/// Performs the stages with a half size of 4 and up, four butterflies at a
+/// time.
+void
+stagesNeon(float* re,
+           float* im,
+           const float* twRe,
+           const float* twIm,
+           size_t n) noexcept
+{
+    for (size_t half = 4; half < n; half *= 2) {
+        for (size_t b = 0; b < n; b += 2 * half) {
+            for (size_t j = 0; j < half; j += 4) {
+                const auto wr = vld1q_f32(twRe + half + j);
+                const auto wi = vld1q_f32(twIm + half + j);
+                const auto ar = vld1q_f32(re + b + j);
+                const auto ai = vld1q_f32(im + b + j);
+                const auto br = vld1q_f32(re + b + j + half);
+                const auto bi = vld1q_f32(im + b + j + half);
+                const auto tr = vmlsq_f32(vmulq_f32(br, wr), bi, wi);
+                const auto ti = vmlaq_f32(vmulq_f32(br, wi), bi, wr);
+                vst1q_f32(re + b + j, vaddq_f32(ar, tr));
+                vst1q_f32(im + b + j, vaddq_f32(ai, ti));
+                vst1q_f32(re + b + j + half, vsubq_f32(ar, tr));
+                vst1q_f32(im + b + j + half, vsubq_f32(ai, ti));
+            }
+        }
+    }
+}
+
+/// Computes the magnitudes of the real-input bins from 1 up, four bins at a
+/// time, see BuiltinFft::split.
+/// @return First bin that is not computed yet.
+auto
+splitMagnitudesNeon(const float* re,
+                    const float* im,
+                    const float* splitRe,
+                    const float* splitIm,
+                    size_t n,
+                    float* magnitudes) noexcept -> size_t
+{
+    const auto reverse = [](float32x4_t v) {
+        const auto swapped = vrev64q_f32(v);
+        return vcombine_f32(vget_high_f32(swapped), vget_low_f32(swapped));
+    };
+
+    size_t k = 1;
+    for (; k + 4 <= n; k += 4) {
+        // Bins n - k down to n - k - 3
+        const auto mirrorRe = reverse(vld1q_f32(re + n - k - 3));
+        const auto mirrorIm = reverse(vld1q_f32(im + n - k - 3));
+        const auto binRe = vld1q_f32(re + k);
+        const auto binIm = vld1q_f32(im + k);
+
+        const auto evenRe = vmulq_n_f32(vaddq_f32(binRe, mirrorRe), 0.5f);
+        const auto evenIm = vmulq_n_f32(vsubq_f32(binIm, mirrorIm), 0.5f);
+        const auto oddRe = vmulq_n_f32(vaddq_f32(binIm, mirrorIm), 0.5f);
+        const auto oddIm = vmulq_n_f32(vsubq_f32(mirrorRe, binRe), 0.5f);
+
+        const auto wr = vld1q_f32(splitRe + k);
+        const auto wi = vld1q_f32(splitIm + k);
+        const auto outRe = vaddq_f32(
+          evenRe, vmlsq_f32(vmulq_f32(oddRe, wr), oddIm, wi));
+        const auto outIm = vaddq_f32(
+          evenIm, vmlaq_f32(vmulq_f32(oddRe, wi), oddIm, wr));
+
+        vst1q_f32(magnitudes + k,
+                  vsqrtq_f32(vmlaq_f32(vmulq_f32(outRe, outRe), outIm, outIm)));
+    }
+
+    return k;
+}
+
+#endif // SPECTREX_SIMD_NEON
+
+/// Returns the number of floats processed at a time by an instruction set.
+auto
+getVectorWidth(SimdLevel level) noexcept -> size_t
+{
+    switch (level) {
+        case SimdLevel::Avx2:
+            return 8;
+        case SimdLevel::Sse:
+        case SimdLevel::Neon:
+            return 4;
+        default:
+            return 1;
+    }
+}
+
+/// Returns whether or not the CPU supports an instruction set.
+auto
+isSupported(SimdLevel level) noexcept -> bool
+{
+    switch (level) {
+        case SimdLevel::Scalar:
+            return true;
+
+#if defined(SPECTREX_SIMD_X86)
+#if defined(_MSC_VER)
+        case SimdLevel::Sse: {
+            int info[4];
+            __cpuid(info, 1);
+            return (info[3] & (1 << 26)) != 0;
+        }
+        case SimdLevel::Avx2: {
+            int info[4];
+            __cpuid(info, 1);
+            const auto hasFma = (info[2] & (1 << 12)) != 0;
+            const auto hasOsxsave = (info[2] & (1 << 27)) != 0;
+            if (!hasFma || !hasOsxsave || (_xgetbv(0) & 0x6) != 0x6) {
+                return false;
+            }
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+        }
+#else
+        case SimdLevel::Sse:
+            return __builtin_cpu_supports("sse2");
+        case SimdLevel::Avx2:
+            return __builtin_cpu_supports("avx2") &&
+                   __builtin_cpu_supports("fma");
+#endif
+#endif // SPECTREX_SIMD_X86
+
+#if defined(SPECTREX_SIMD_NEON)
+        case SimdLevel::Neon:
+            return true;
+#endif
+
+        default:
+            return false;
+    }
+}
+
+} // namespace
+
+auto
+detectSimdLevel() noexcept -> SimdLevel
+{
+    static const SimdLevel level = []() noexcept {
+        for (auto candidate :
+             { SimdLevel::Avx2, SimdLevel::Neon, SimdLevel::Sse }) {
+            if (isSupported(candidate)) {
+                return candidate;
+            }
+        }
+        return SimdLevel::Scalar;
+    }();
+
+    return level;
+}
+
+auto
+getSimdLevelName(SimdLevel level) noexcept -> const char*
+{
+    switch (level) {
+        case SimdLevel::Sse:
+            return "sse";
+        case SimdLevel::Avx2:
+            return "avx2";
+        case SimdLevel::Neon:
+            return "neon";
+        default:
+            return "scalar";
+    }
+}
+
+FftBackend::FftBackend(size_t size)
+  : m_size(size)
+{
+    KASSERT(size >= 4 && (size & (size - 1)) == 0,
+            "FFT size must be a power of two");
+}
+
+void
+FftBackend::forwardMagnitudes(const float* input,
+                              const float* window,
+                              float* magnitudes) noexcept
+{
+    // Lazily allocate the work buffers, so backends that override this
+    // function do not pay for them
+    if (m_windowed.empty()) {
+        m_windowed.resize(getSize());
+        m_spectrum.resize(getNumBins());
+    }
+
+    for (size_t i = 0; i < getSize(); ++i) {
+        m_windowed[i] = input[i] * window[i];
+    }
+
+    forward(m_windowed.data(), m_spectrum.data());
+
+    for (size_t k = 0; k < getNumBins(); ++k) {
+        magnitudes[k] = std::abs(m_spectrum[k]);
+    }
+}
+
+FftPlan::FftPlan(size_t size)
+  : Size(size)
+  , BitReversal(size / 2)
+  , TwiddlesRe(size / 2)
+  , TwiddlesIm(size / 2)
+  , SplitRe(size / 2)
+  , SplitIm(size / 2)
+{
+    const auto pi = std::acos(-1.0);
+    const auto halfSize = size / 2;
+
+    // Bit-reversal permutation
+    size_t numBits = 0;
+    while (((size_t)1 << numBits) < halfSize) {
+        ++numBits;
+    }
+    for (size_t i = 0; i < halfSize; ++i) {
+        uint32_t reversed = 0;
+        for (size_t bit = 0; bit < numBits; ++bit) {
+            reversed |= (uint32_t)((i >> bit) & 1) << (numBits - 1 - bit);
+        }
+        BitReversal[i] = reversed;
+    }
+
+    // Butterfly twiddles per stage, in double precision to avoid accumulating
+    // rounding errors
+    for (size_t half = 1; half < halfSize; half *= 2) {
+        for (size_t j = 0; j < half; ++j) {
+            const auto angle = -pi * (double)j / (double)half;
+            TwiddlesRe[half + j] = (float)std::cos(angle);
+            TwiddlesIm[half + j] = (float)std::sin(angle);
+        }
+    }
+
+    // Split pass twiddles
+    for (size_t k = 0; k < halfSize; ++k) {
+        const auto angle = -2.0 * pi * (double)k / (double)size;
+        SplitRe[k] = (float)std::cos(angle);
+        SplitIm[k] = (float)std::sin(angle);
+    }
+}
+
+BuiltinFft::BuiltinFft(size_t size, SimdLevel simdLevel)
+  : FftBackend(size)
+  , m_simdLevel(isSupported(simdLevel) ? simdLevel : SimdLevel::Scalar)
+  , m_halfSize(size / 2)
+  , m_plan(TableCache::getFftPlan(size))
+  , m_re(m_halfSize)
+  , m_im(m_halfSize)
+{
+}
+
+auto
+BuiltinFft::getName() const noexcept -> const char*
+{
+    switch (m_simdLevel) {
+        case SimdLevel::Sse:
+            return "builtin-sse";
+        case SimdLevel::Avx2:
+            return "builtin-avx2";
+        case SimdLevel::Neon:
+            return "builtin-neon";
+        default:
+            return "builtin-scalar";
+    }
+}
+
+void
+BuiltinFft::load(const float* input, const float* window) noexcept
+{
+    // Even samples form the real parts and odd samples the imaginary parts of
+    // the complex transform
+    const auto* bitReversal = m_plan->BitReversal.data();
+#if defined(SPECTREX_SIMD_X86)
+    if (m_simdLevel == SimdLevel::Avx2 && m_halfSize >= 8) {
+        loadAvx2(input, window, bitReversal, m_re.data(), m_im.data(),
+                 m_halfSize);
+        return;
+    }
+#endif
+    if (window != nullptr) {
+        for (size_t i = 0; i < m_halfSize; ++i) {
+            const auto r = bitReversal[i];
+            m_re[r] = input[2 * i] * window[2 * i];
+            m_im[r] = input[2 * i + 1] * window[2 * i + 1];
+        }
+    } else {
+        for (size_t i = 0; i < m_halfSize; ++i) {
+            const auto r = bitReversal[i];
+            m_re[r] = input[2 * i];
+            m_im[r] = input[2 * i + 1];
+        }
+    }
+}
+
+void
+BuiltinFft::transform() noexcept
+{
+    auto* re = m_re.data();
+    auto* im = m_im.data();
+    const auto* twRe = m_plan->TwiddlesRe.data();
+    const auto* twIm = m_plan->TwiddlesIm.data();
+    const auto n = m_halfSize;
+
+    // The first stages are too narrow for the vector width, and are performed
+    // one butterfly at a time within every vector wide chunk
+    const auto width = std::min(n, getVectorWidth(m_simdLevel));
+    for (size_t b = 0; b < n; b += width) {
+        stagesScalar(re + b, im + b, twRe, twIm, width, 1);
+    }
+
+    // Remaining stages are vectorized
+    switch (m_simdLevel) {
+#if defined(SPECTREX_SIMD_X86)
+        case SimdLevel::Avx2:
+            stagesAvx2(re, im, twRe, twIm, n);
+            break;
+        case SimdLevel::Sse:
+            stagesSse(re, im, twRe, twIm, n);
+            break;
+#endif
+#if defined(SPECTREX_SIMD_NEON)
+        case SimdLevel::Neon:
+            stagesNeon(re, im, twRe, twIm, n);
+            break;
+#endif
+        default:
+            stagesScalar(re, im, twRe, twIm, n, width);
+            break;
+    }
+}
+
+auto
+BuiltinFft::split(size_t k) const noexcept -> std::complex<float>
+{
+    // Bins 0 and N/2 only depend on the first complex bin
+    if (k == 0) {
+        return { m_re[0] + m_im[0], 0.0f };
+    }
+    if (k == m_halfSize) {
+        return { m_re[0] - m_im[0], 0.0f };
+    }
+
+    // Separate the transforms of the even and odd samples, and combine them
+    const auto mirror = m_halfSize - k;
+    const auto evenRe = 0.5f * (m_re[k] + m_re[mirror]);
+    const auto evenIm = 0.5f * (m_im[k] - m_im[mirror]);
+    const auto oddRe = 0.5f * (m_im[k] + m_im[mirror]);
+    const auto oddIm = -0.5f * (m_re[k] - m_re[mirror]);
+
+    const auto wr = m_plan->SplitRe[k];
+    const auto wi = m_plan->SplitIm[k];
+
+    return { evenRe + oddRe * wr - oddIm * wi,
+             evenIm + oddRe * wi + oddIm * wr };
+}
+
+void
+BuiltinFft::forward(const float* input, std::complex<float>* output) noexcept
+{
+    load(input, nullptr);
+    transform();
+
+    for (size_t k = 0; k <= m_halfSize; ++k) {
+        output[k] = split(k);
+    }
+}
+
+void
+BuiltinFft::forwardMagnitudes(const float* input,
+                              const float* window,
+                              float* magnitudes) noexcept
+{
+    load(input, window);
+    transform();
+
+    // Bins 1 up to the last complete vector are split in vectors, bin 0 and
+    // the remaining bins one at a time
+    const auto* re = m_re.data();
+    const auto* im = m_im.data();
+    const auto* splitRe = m_plan->SplitRe.data();
+    const auto* splitIm = m_plan->SplitIm.data();
+    const auto n = m_halfSize;
+    size_t first = 1;
+    switch (m_simdLevel) {
+#if defined(SPECTREX_SIMD_X86)
+        case SimdLevel::Avx2:
+            first =
+              splitMagnitudesAvx2(re, im, splitRe, splitIm, n, magnitudes);
+            break;
+        case SimdLevel::Sse:
+            first =
+              splitMagnitudesSse(re, im, splitRe, splitIm, n, magnitudes);
+            break;
+#endif
+#if defined(SPECTREX_SIMD_NEON)
+        case SimdLevel::Neon:
+            first =
+              splitMagnitudesNeon(re, im, splitRe, splitIm, n, magnitudes);
+            break;
+#endif
+        default:
+            break;
+    }
+
+    magnitudes[0] = std::abs(split(0).real());
+    for (size_t k = first; k <= m_halfSize; ++k) {
+        const auto bin = split(k);
+        magnitudes[k] =
+          std::sqrt(bin.real() * bin.real() + bin.imag() * bin.imag());
+    }
+}
+
+namespace {
+
+/// Current backend factory.
+struct Registry
+{
+    std::mutex Mutex;
+    FftBackendFactory Factory;
+};
+
+auto
+getRegistry() -> Registry&
+{
+    static Registry registry;
+    return registry;
+}
+
+} // namespace
+
+void
+FftBackendRegistry::setFactory(FftBackendFactory factory)
+{
+    auto& registry = getRegistry();
+
+    std::lock_guard<std::mutex> lock{ registry.Mutex };
+    registry.Factory = std::move(factory);
+}
+
+auto
+FftBackendRegistry::create(size_t size) -> std::unique_ptr<FftBackend>
+{
+    FftBackendFactory factory;
+    {
+        auto& registry = getRegistry();
+
+        std::lock_guard<std::mutex> lock{ registry.Mutex };
+        factory = registry.Factory;
+    }
+
+    if (factory) {
+        if (auto backend = factory(size)) {
+            return backend;
+        }
+    }
+
+    return std::make_unique<BuiltinFft>(size);
+}
+
+} // namespace spectrex
@@ -0,0 +1,229 @@
+#include <Spectrex/Analysis/LogBinRemap.hpp>
+
+// Stdlib
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) ||            \
+  defined(_M_IX86)
+#define SPECTREX_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(SPECTREX_SIMD_X86) && !defined(_MSC_VER)
+#define SPECTREX_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+#define SPECTREX_TARGET_AVX2
+#endif
+
+namespace spectrex {
+
+namespace {
+
+/// Computes a slice of analyzer bins, one entry at a time.
+void
+applySliceScalar(const float* magnitudes,
+                 const int32_t* indices,
+                 const float* weights,
+                 size_t length,
+                 float* output) noexcept
+{
+    constexpr auto n = LogBinRemap::k_sliceSize;
+
+    float sums[n] = {};
+    for (size_t e = 0; e < length; ++e) {
+        for (size_t b = 0; b < n; ++b) {
+            sums[b] += magnitudes[indices[e * n + b]] * weights[e * n + b];
+        }
+    }
+    std::copy(sums, sums + n, output);
+}
+
+#if defined(SPECTREX_SIMD_X86)
+
+/// Computes a slice of analyzer bins, gathering an entry of all 8 analyzer
+/// bins at a time.
+SPECTREX_TARGET_AVX2 void
+applySliceAvx2(const float* magnitudes,
+               const int32_t* indices,
+               const float* weights,
+               size_t length,
+               float* output) noexcept
+{
+    constexpr auto n = LogBinRemap::k_sliceSize;
+
+    auto sums = _mm256_setzero_ps();
+    for (size_t e = 0; e < length; ++e) {
+        const auto index = _mm256_loadu_si256(
+          reinterpret_cast<const __m256i*>(indices + e * n));
+        const auto weight = _mm256_loadu_ps(weights + e * n);
+        const auto magnitude = _mm256_i32gather_ps(magnitudes, index, 4);
+        sums = _mm256_fmadd_ps(magnitude, weight, sums);
+    }
+    _mm256_storeu_ps(output, sums);
+}
+
+#endif // SPECTREX_SIMD_X86
+
+} // namespace
+
+LogBinRemap::LogBinRemap(SimdLevel simdLevel)
+  : m_simdLevel(simdLevel == SimdLevel::Avx2 &&
+                    detectSimdLevel() == SimdLevel::Avx2
+                  ? SimdLevel::Avx2
+                  : SimdLevel::Scalar)
+{
+}
+
+auto
+LogBinRemap::configure(const Config& config) -> bool
+{
+    if (config == m_config) {
+        return false;
+    }
+
+    m_config = config;
+    rebuild();
+    return true;
+}
+
+auto
+LogBinRemap::getBinFrequency(size_t bin) const noexcept -> double
+{
+    const auto nyquist = (double)m_config.SampleRate / 2.0;
+    const auto minFrequency =
+      std::clamp((double)m_config.MinFrequency, 1.0, nyquist);
+    const auto maxFrequency =
+      std::clamp((double)m_config.MaxFrequency, minFrequency, nyquist);
+
+    return minFrequency *
+           std::pow(maxFrequency / minFrequency,
+                    ((double)bin + 0.5) / (double)m_config.NumBins);
+}
+
+void
+LogBinRemap::rebuild()
+{
+    m_sliceOffsets.clear();
+    m_sliceLengths.clear();
+    m_indices.clear();
+    m_weights.clear();
+
+    const auto numBins = (size_t)m_config.NumBins;
+    const auto numFftBins = m_config.NumFftBins;
+    if (numBins == 0 || numFftBins < 2) {
+        return;
+    }
+
+    const auto nyquist = (double)m_config.SampleRate / 2.0;
+    const auto minFrequency =
+      std::clamp((double)m_config.MinFrequency, 1.0, nyquist);
+    const auto maxFrequency =
+      std::clamp((double)m_config.MaxFrequency, minFrequency, nyquist);
+    const auto binWidth = nyquist / (double)(numFftBins - 1);
+    const auto gain = std::exp2((double)m_config.DbScale);
+
+    // Weights of a single analyzer bin, as FFT bin indices and weights
+    std::vector<std::vector<std::pair<int32_t, float>>> rows(numBins);
+    const auto edge = [&](double position) {
+        return minFrequency *
+               std::pow(maxFrequency / minFrequency,
+                        position / (double)numBins) /
+               binWidth;
+    };
+    for (size_t bin = 0; bin < numBins; ++bin) {
+        const auto lower = edge((double)bin);
+        const auto upper = edge((double)bin + 1.0);
+
+        // Tilt and dB scale at the centre of the analyzer bin
+        const auto octaves = std::log2(
+          getBinFrequency(bin) / (double)m_config.TiltReferenceFrequency);
+        const auto tiltDb = (double)m_config.TiltDbPerOctave * octaves;
+        const auto scale = gain * std::pow(10.0, tiltDb / 20.0);
+
+        auto& row = rows[bin];
+        const auto last = (double)(numFftBins - 1);
+        if (upper - lower < 1.0) {
+            // Narrower than an FFT bin, interpolate at the centre
+            const auto centre = std::min((lower + upper) / 2.0, last);
+            const auto index = std::min((size_t)centre, numFftBins - 2);
+            const auto fraction = centre - (double)index;
+            row.emplace_back((int32_t)index, (float)((1.0 - fraction) * scale));
+            row.emplace_back((int32_t)index + 1, (float)(fraction * scale));
+        } else {
+            // Average the FFT bins, weighted by their overlap
+            const auto first = (size_t)std::max(0.0, std::floor(lower + 0.5));
+            const auto end = (size_t)std::min(last, std::floor(upper + 0.5));
+            for (auto index = first; index <= end; ++index) {
+                const auto overlap =
+                  std::min(upper, (double)index + 0.5) -
+                  std::max(lower, (double)index - 0.5);
+                if (overlap > 0.0) {
+                    row.emplace_back(
+                      (int32_t)index,
+                      (float)(overlap / (upper - lower) * scale));
+                }
+            }
+        }
+    }
+
+    // Interleave slices of k_sliceSize analyzer bins, padding every bin to
+    // the widest one of its slice with zero weights, and the last slice with
+    // empty bins
+    const auto numSlices = (numBins + k_sliceSize - 1) / k_sliceSize;
+    for (size_t slice = 0; slice < numSlices; ++slice) {
+        const auto begin = slice * k_sliceSize;
+        const auto end = std::min(begin + k_sliceSize, numBins);
+
+        size_t length = 0;
+        for (auto bin = begin; bin < end; ++bin) {
+            length = std::max(length, rows[bin].size());
+        }
+
+        const auto offset = m_weights.size();
+        m_sliceOffsets.push_back((uint32_t)offset);
+        m_sliceLengths.push_back((uint32_t)length);
+        m_indices.resize(offset + length * k_sliceSize, 0);
+        m_weights.resize(offset + length * k_sliceSize, 0.0f);
+
+        for (auto bin = begin; bin < end; ++bin) {
+            const auto& row = rows[bin];
+            for (size_t e = 0; e < row.size(); ++e) {
+                const auto i = offset + e * k_sliceSize + (bin - begin);
+                m_indices[i] = row[e].first;
+                m_weights[i] = row[e].second;
+            }
+        }
+    }
+}
+
+void
+LogBinRemap::apply(const float* magnitudes, float* output) const noexcept
+{
+    const auto numBins = (size_t)m_config.NumBins;
+    auto* applySlice = applySliceScalar;
+#if defined(SPECTREX_SIMD_X86)
+    if (m_simdLevel == SimdLevel::Avx2) {
+        applySlice = applySliceAvx2;
+    }
+#endif
+
+    for (size_t slice = 0; slice < m_sliceOffsets.size(); ++slice) {
+        const auto offset = m_sliceOffsets[slice];
+        const auto begin = slice * k_sliceSize;
+
+        // The last slice may be partial
+        float sums[k_sliceSize];
+        auto* target = begin + k_sliceSize <= numBins ? output + begin : sums;
+        applySlice(magnitudes,
+                   m_indices.data() + offset,
+                   m_weights.data() + offset,
+                   m_sliceLengths[slice],
+                   target);
+        if (target == sums) {
+            std::copy(sums, sums + (numBins - begin), output + begin);
+        }
+    }
+}
+
+} // namespace spectrex
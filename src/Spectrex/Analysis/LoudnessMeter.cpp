@@ -0,0 +1,475 @@
+#include <Spectrex/Analysis/LoudnessMeter.hpp>
+
+// Stdlib
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) ||            \
+  defined(_M_IX86)
+#define SPECTREX_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(SPECTREX_SIMD_X86) && !defined(_MSC_VER)
+#define SPECTREX_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+#define SPECTREX_TARGET_AVX2
+#endif
+
+namespace spectrex {
+
+namespace {
+
+constexpr auto k_numChannels = LoudnessMeter::k_maxNumChannels;
+constexpr auto k_factor = LoudnessMeter::k_truePeakFactor;
+constexpr auto k_taps = LoudnessMeter::k_truePeakTaps;
+
+/// Returns the loudness of a mean square of K-weighted audio, in LUFS.
+auto
+toLoudness(double meanSquare) noexcept -> float
+{
+    if (!(meanSquare > 0.0)) {
+        return -std::numeric_limits<float>::infinity();
+    }
+    return (float)(-0.691 + 10.0 * std::log10(meanSquare));
+}
+
+/// Returns a linear amplitude in dB.
+auto
+toDb(float amplitude) noexcept -> float
+{
+    if (!(amplitude > 0.0f)) {
+        return -std::numeric_limits<float>::infinity();
+    }
+    return 20.0f * std::log10(amplitude);
+}
+
+/// K-weights samples of both channels, the highpasses taking the shelf output
+/// of the previous sample, and sums the squares of the K-weighted samples.
+template<typename State>
+void
+kWeightScalar(const float* left,
+              const float* right,
+              size_t numSamples,
+              State& state,
+              float* sums) noexcept
+{
+    sums[0] = 0.0f;
+    sums[1] = 0.0f;
+    for (size_t i = 0; i < numSamples; ++i) {
+        const float input[4] = { left[i], right[i], state.Y[0], state.Y[1] };
+        for (size_t l = 0; l < 4; ++l) {
+            const auto y = state.B0[l] * input[l] + state.S1[l];
+            state.S1[l] =
+              state.B1[l] * input[l] - state.A1[l] * y + state.S2[l];
+            state.S2[l] = state.B2[l] * input[l] - state.A2[l] * y;
+            state.Y[l] = y;
+        }
+
+        sums[0] += state.Y[2] * state.Y[2];
+        sums[1] += state.Y[3] * state.Y[3];
+    }
+}
+
+/// Computes the true peak of samples of both channels, one phase and channel
+/// after the other.
+template<typename State>
+void
+truePeakScalar(const float* left,
+               const float* right,
+               size_t numSamples,
+               State& state,
+               float* peaks) noexcept
+{
+    peaks[0] = 0.0f;
+    peaks[1] = 0.0f;
+    for (size_t i = 0; i < numSamples; ++i) {
+        const auto position = state.Position;
+        const float samples[2] = { left[i], right[i] };
+        for (size_t c = 0; c < k_numChannels; ++c) {
+            state.History[c][position] = samples[c];
+            state.History[c][position + k_taps] = samples[c];
+        }
+        state.Position = (position + 1) % k_taps;
+
+        for (size_t c = 0; c < k_numChannels; ++c) {
+            const auto* window = state.History[c] + position + 1;
+            for (size_t p = 0; p < k_factor; ++p) {
+                float sum = 0.0f;
+                for (size_t j = 0; j < k_taps; ++j) {
+                    sum += window[j] * state.Taps[j][c * k_factor + p];
+                }
+                peaks[c] = std::max(peaks[c], std::abs(sum));
+            }
+        }
+    }
+}
+
+#if defined(SPECTREX_SIMD_X86)
+
+/// K-weights samples of both channels, all four biquads at once, and sums the
+/// squares of the K-weighted samples.
+template<typename State>
+SPECTREX_TARGET_AVX2 void
+kWeightAvx2(const float* left,
+            const float* right,
+            size_t numSamples,
+            State& state,
+            float* sums) noexcept
+{
+    const auto b0 = _mm_load_ps(state.B0);
+    const auto b1 = _mm_load_ps(state.B1);
+    const auto b2 = _mm_load_ps(state.B2);
+    const auto a1 = _mm_load_ps(state.A1);
+    const auto a2 = _mm_load_ps(state.A2);
+    auto s1 = _mm_load_ps(state.S1);
+    auto s2 = _mm_load_ps(state.S2);
+    auto y = _mm_load_ps(state.Y);
+
+    auto squares = _mm_setzero_ps();
+    for (size_t i = 0; i < numSamples; ++i) {
+        // Lanes 0 and 1 take the samples, lanes 2 and 3 the shelf outputs
+        const auto samples =
+          _mm_unpacklo_ps(_mm_load_ss(left + i), _mm_load_ss(right + i));
+        const auto input = _mm_blend_ps(_mm_movelh_ps(y, y), samples, 0x3);
+        y = _mm_fmadd_ps(b0, input, s1);
+        s1 = _mm_fmadd_ps(b1, input, _mm_fnmadd_ps(a1, y, s2));
+        s2 = _mm_fnmadd_ps(a2, y, _mm_mul_ps(b2, input));
+        squares = _mm_fmadd_ps(y, y, squares);
+    }
+
+    _mm_store_ps(state.S1, s1);
+    _mm_store_ps(state.S2, s2);
+    _mm_store_ps(state.Y, y);
+
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, squares);
+    sums[0] = lanes[2];
+    sums[1] = lanes[3];
+}
+
+/// Computes the true peak of samples of both channels, all phases of both
+/// channels at once.
+template<typename State>
+SPECTREX_TARGET_AVX2 void
+truePeakAvx2(const float* left,
+             const float* right,
+             size_t numSamples,
+             State& state,
+             float* peaks) noexcept
+{
+    const auto signMask = _mm256_set1_ps(-0.0f);
+
+    auto peak = _mm256_setzero_ps();
+    for (size_t i = 0; i < numSamples; ++i) {
+        const auto position = state.Position;
+        state.History[0][position] = left[i];
+        state.History[0][position + k_taps] = left[i];
+        state.History[1][position] = right[i];
+        state.History[1][position + k_taps] = right[i];
+        state.Position = (position + 1) % k_taps;
+
+        const auto* leftWindow = state.History[0] + position + 1;
+        const auto* rightWindow = state.History[1] + position + 1;
+        auto sum = _mm256_setzero_ps();
+        for (size_t j = 0; j < k_taps; ++j) {
+            const auto samples =
+              _mm256_set_m128(_mm_broadcast_ss(rightWindow + j),
+                              _mm_broadcast_ss(leftWindow + j));
+            sum = _mm256_fmadd_ps(samples, _mm256_load_ps(state.Taps[j]), sum);
+        }
+        peak = _mm256_max_ps(peak, _mm256_andnot_ps(signMask, sum));
+    }
+
+    // Maximum of the phases of every channel
+    const __m128 channels[] = { _mm256_castps256_ps128(peak),
+                                _mm256_extractf128_ps(peak, 1) };
+    for (size_t c = 0; c < k_numChannels; ++c) {
+        auto phases =
+          _mm_max_ps(channels[c], _mm_movehl_ps(channels[c], channels[c]));
+        phases = _mm_max_ss(phases, _mm_shuffle_ps(phases, phases, 1));
+        peaks[c] = _mm_cvtss_f32(phases);
+    }
+}
+
+#endif // SPECTREX_SIMD_X86
+
+/// Returns the K-weighting coefficients (b0, b1, b2, a1 and a2, normalized by
+/// a0) of the high shelf (false) or highpass (true) at a sample rate, as
+/// specified by ITU-R BS.1770 for 48 kHz.
+auto
+getKWeightingCoefficients(double sampleRate, bool highpass)
+  -> std::array<float, 5>
+{
+    const auto pi = std::acos(-1.0);
+
+    if (!highpass) {
+        const auto k = std::tan(pi * 1681.974450955533 / sampleRate);
+        const auto q = 0.7071752369554196;
+        const auto vh = std::pow(10.0, 3.999843853973347 / 20.0);
+        const auto vb = std::pow(vh, 0.4996667741545416);
+        const auto a0 = 1.0 + k / q + k * k;
+        return { (float)((vh + vb * k / q + k * k) / a0),
+                 (float)(2.0 * (k * k - vh) / a0),
+                 (float)((vh - vb * k / q + k * k) / a0),
+                 (float)(2.0 * (k * k - 1.0) / a0),
+                 (float)((1.0 - k / q + k * k) / a0) };
+    }
+
+    const auto k = std::tan(pi * 38.13547087602444 / sampleRate);
+    const auto q = 0.5003270373238773;
+    const auto a0 = 1.0 + k / q + k * k;
+    return { 1.0f,
+             -2.0f,
+             1.0f,
+             (float)(2.0 * (k * k - 1.0) / a0),
+             (float)((1.0 - k / q + k * k) / a0) };
+}
+
+} // namespace
+
+LoudnessMeter::LoudnessMeter(float sampleRate, SimdLevel simdLevel)
+  : m_sampleRate(sampleRate)
+  , m_simdLevel(simdLevel == SimdLevel::Avx2 &&
+                    detectSimdLevel() == SimdLevel::Avx2
+                  ? SimdLevel::Avx2
+                  : SimdLevel::Scalar)
+  , m_segmentSize(
+      std::max<size_t>(1, (size_t)std::lround(0.1 * (double)sampleRate)))
+{
+    for (size_t c = 0; c < k_maxNumChannels; ++c) {
+        for (const auto highpass : { false, true }) {
+            const auto l = c + (highpass ? k_maxNumChannels : 0);
+            const auto coefficients =
+              getKWeightingCoefficients((double)sampleRate, highpass);
+            m_filterState.B0[l] = coefficients[0];
+            m_filterState.B1[l] = coefficients[1];
+            m_filterState.B2[l] = coefficients[2];
+            m_filterState.A1[l] = coefficients[3];
+            m_filterState.A2[l] = coefficients[4];
+        }
+    }
+
+    // Blackman windowed sinc, centered on tap 24 of 49 so phase 0 passes the
+    // samples through. The last tap is 0 and left out.
+    const auto pi = std::acos(-1.0);
+    constexpr auto numTaps = k_truePeakFactor * k_truePeakTaps;
+    constexpr auto centre = (double)numTaps / 2.0;
+    double prototype[numTaps];
+    for (size_t m = 0; m < numTaps; ++m) {
+        const auto t = ((double)m - centre) / (double)k_truePeakFactor;
+        const auto sinc = t == 0.0 ? 1.0 : std::sin(pi * t) / (pi * t);
+        const auto phase = 2.0 * pi * (double)m / (double)numTaps;
+        const auto window =
+          0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+        prototype[m] = sinc * window;
+    }
+
+    // Every phase has unity gain at DC. Tap j of a phase weights the sample
+    // k_truePeakTaps - 1 - j samples ago.
+    for (size_t p = 0; p < k_truePeakFactor; ++p) {
+        double sum = 0.0;
+        for (size_t k = 0; k < k_truePeakTaps; ++k) {
+            sum += prototype[k * k_truePeakFactor + p];
+        }
+        for (size_t k = 0; k < k_truePeakTaps; ++k) {
+            const auto j = k_truePeakTaps - 1 - k;
+            const auto tap = (float)(prototype[k * k_truePeakFactor + p] / sum);
+            for (size_t c = 0; c < k_maxNumChannels; ++c) {
+                m_truePeakState.Taps[j][c * k_truePeakFactor + p] = tap;
+            }
+        }
+    }
+}
+
+void
+LoudnessMeter::reset() noexcept
+{
+    for (size_t l = 0; l < k_numBiquads; ++l) {
+        m_filterState.S1[l] = 0.0f;
+        m_filterState.S2[l] = 0.0f;
+        m_filterState.Y[l] = 0.0f;
+    }
+    for (auto& history : m_truePeakState.History) {
+        std::fill(std::begin(history), std::end(history), 0.0f);
+    }
+    m_truePeakState.Position = 0;
+
+    m_segmentFill = 0;
+    m_segmentSum = 0.0;
+    m_segmentPeak = 0.0f;
+    m_segments.fill(0.0);
+    m_numSegments = 0;
+
+    for (auto* histogram : { &m_momentaryHistogram, &m_shortTermHistogram }) {
+        std::fill(histogram->Counts.begin(), histogram->Counts.end(), 0u);
+        std::fill(
+          histogram->MeanSquares.begin(), histogram->MeanSquares.end(), 0.0);
+    }
+
+    m_info = LoudnessInfo{};
+}
+
+void
+LoudnessMeter::process(gsl::span<const AudioChannelView> channels) noexcept
+{
+    const auto numChannels = std::min(channels.size(), k_maxNumChannels);
+    if (numChannels == 0) {
+        return;
+    }
+
+    auto* kWeight = kWeightScalar<FilterState>;
+    auto* truePeak = truePeakScalar<TruePeakState>;
+#if defined(SPECTREX_SIMD_X86)
+    if (m_simdLevel == SimdLevel::Avx2) {
+        kWeight = kWeightAvx2<FilterState>;
+        truePeak = truePeakAvx2<TruePeakState>;
+    }
+#endif
+
+    // A single channel runs through the lanes of both, the second is ignored
+    const auto* left = channels[0].data();
+    const auto* right = numChannels > 1 ? channels[1].data() : left;
+    const auto numSamples = channels[0].size();
+
+    size_t offset = 0;
+    while (offset < numSamples) {
+        const auto n =
+          std::min(numSamples - offset, m_segmentSize - m_segmentFill);
+
+        float sums[k_maxNumChannels];
+        float peaks[k_maxNumChannels];
+        kWeight(left + offset, right + offset, n, m_filterState, sums);
+        truePeak(left + offset, right + offset, n, m_truePeakState, peaks);
+        for (size_t c = 0; c < numChannels; ++c) {
+            m_segmentSum += (double)sums[c];
+            m_segmentPeak = std::max(m_segmentPeak, peaks[c]);
+        }
+
+        offset += n;
+        m_segmentFill += n;
+        if (m_segmentFill == m_segmentSize) {
+            completeSegment();
+        }
+    }
+}
+
+void
+LoudnessMeter::completeSegment() noexcept
+{
+    m_segments[m_numSegments % k_shortTermSegments] =
+      m_segmentSum / (double)m_segmentSize;
+    ++m_numSegments;
+
+    m_info.Seconds =
+      (double)(m_numSegments * m_segmentSize) / (double)m_sampleRate;
+    m_info.TruePeak = toDb(m_segmentPeak);
+    m_info.MaxTruePeak = std::max(m_info.MaxTruePeak, m_info.TruePeak);
+
+    m_segmentFill = 0;
+    m_segmentSum = 0.0;
+    m_segmentPeak = 0.0f;
+
+    // Mean square of the last segments, once the window is full
+    const auto getMeanSquare = [this](size_t numSegments) {
+        if (m_numSegments < numSegments) {
+            return 0.0;
+        }
+
+        double sum = 0.0;
+        for (size_t s = 0; s < numSegments; ++s) {
+            sum += m_segments[(m_numSegments - 1 - s) % k_shortTermSegments];
+        }
+        return sum / (double)numSegments;
+    };
+    const auto count = [](Histogram& histogram, double meanSquare) {
+        const auto loudness = toLoudness(meanSquare);
+        if (loudness >= k_absoluteGate) {
+            const auto bin = std::min(
+              (size_t)((loudness - k_absoluteGate) / k_histogramStep),
+              k_histogramSize - 1);
+            ++histogram.Counts[bin];
+            histogram.MeanSquares[bin] += meanSquare;
+        }
+        return loudness;
+    };
+
+    m_info.Momentary =
+      count(m_momentaryHistogram, getMeanSquare(k_momentarySegments));
+    m_info.MaxMomentary = std::max(m_info.MaxMomentary, m_info.Momentary);
+
+    m_info.ShortTerm =
+      count(m_shortTermHistogram, getMeanSquare(k_shortTermSegments));
+    m_info.MaxShortTerm = std::max(m_info.MaxShortTerm, m_info.ShortTerm);
+}
+
+auto
+LoudnessMeter::getInfo() const noexcept -> LoudnessInfo
+{
+    // Lower edge of a histogram bin, in LUFS
+    const auto getBinLoudness = [](size_t bin) {
+        return k_absoluteGate + (float)bin * k_histogramStep;
+    };
+
+    // Mean square of the values from bin \a first on, and their number
+    const auto getMeanSquare =
+      [](const Histogram& histogram, size_t first, uint64_t& count) {
+          double sum = 0.0;
+          count = 0;
+          for (auto bin = first; bin < k_histogramSize; ++bin) {
+              sum += histogram.MeanSquares[bin];
+              count += histogram.Counts[bin];
+          }
+          return count > 0 ? sum / (double)count : 0.0;
+      };
+
+    // First bin above a gate relative to the loudness of all values, the bin
+    // holding the gate is included
+    const auto getGatedBin = [&](const Histogram& histogram, float gate) {
+        uint64_t count = 0;
+        const auto threshold =
+          toLoudness(getMeanSquare(histogram, 0, count)) + gate;
+
+        size_t first = 0;
+        while (first + 1 < k_histogramSize &&
+               getBinLoudness(first + 1) <= threshold) {
+            ++first;
+        }
+        return first;
+    };
+
+    auto info = m_info;
+
+    // Integrated loudness: momentary loudness gated 10 LU below the mean
+    uint64_t count = 0;
+    const auto firstIntegrated = getGatedBin(m_momentaryHistogram, -10.0f);
+    const auto meanSquare =
+      getMeanSquare(m_momentaryHistogram, firstIntegrated, count);
+    if (count > 0) {
+        info.Integrated = toLoudness(meanSquare);
+    }
+
+    // Loudness range: difference of the 10th and 95th percentile of the
+    // short-term loudness gated 20 LU below the mean
+    const auto firstRange = getGatedBin(m_shortTermHistogram, -20.0f);
+    getMeanSquare(m_shortTermHistogram, firstRange, count);
+    if (count > 0) {
+        const auto getPercentile = [&](double percentile) {
+            const auto rank =
+              (uint64_t)std::llround((double)(count - 1) * percentile);
+            uint64_t sum = 0;
+            for (auto bin = firstRange; bin < k_histogramSize; ++bin) {
+                sum += m_shortTermHistogram.Counts[bin];
+                if (sum > rank) {
+                    return getBinLoudness(bin) + k_histogramStep / 2.0f;
+                }
+            }
+            return getBinLoudness(k_histogramSize - 1);
+        };
+        info.LoudnessRange = getPercentile(0.95) - getPercentile(0.10);
+    }
+
+    return info;
+}
+
+} // namespace spectrex
@@ -0,0 +1,159 @@
+#include <Spectrex/Analysis/PartitionedFft.hpp>
+
+// Stdlib
+#include <algorithm>
+#include <cmath>
+
+namespace spectrex {
+
+namespace {
+
+/// Returns the base-2 logarithm of a power of two.
+auto
+getNumBits(size_t value) noexcept -> size_t
+{
+    size_t result = 0;
+    while (((size_t)1 << result) < value) {
+        ++result;
+    }
+    return result;
+}
+
+/// Returns the number of chunks covering \a count items.
+auto
+countChunks(size_t count) noexcept -> size_t
+{
+    return (count + PartitionedFft::k_chunkSize - 1) /
+           PartitionedFft::k_chunkSize;
+}
+
+} // namespace
+
+PartitionedFft::PartitionedFft(size_t size)
+  : m_size(size)
+  , m_halfSize(size / 2)
+  , m_numLoadChunks(countChunks(m_halfSize))
+  , m_numStageChunks(countChunks(m_halfSize / 2))
+  , m_numChunks(m_numLoadChunks + getNumBits(m_halfSize) * m_numStageChunks +
+                countChunks(m_halfSize + 1))
+  , m_plan(TableCache::getFftPlan(size))
+  , m_chunk(m_numChunks)
+  , m_re(m_halfSize)
+  , m_im(m_halfSize)
+  , m_magnitudes(m_halfSize + 1)
+{
+    KASSERT(size >= 4 && (size & (size - 1)) == 0,
+            "FFT size must be a power of two");
+}
+
+void
+PartitionedFft::start(gsl::span<const float> input,
+                      size_t first,
+                      const float* window) noexcept
+{
+    KASSERT(input.size() >= m_size && (input.size() & (input.size() - 1)) == 0,
+            "Input size must be a power of two of at least the FFT size");
+
+    m_input = input;
+    m_first = first;
+    m_window = window;
+    m_chunk = 0;
+}
+
+auto
+PartitionedFft::step(size_t maxChunks) noexcept -> bool
+{
+    const auto end = std::min(m_numChunks, m_chunk + maxChunks);
+    for (; m_chunk < end; ++m_chunk) {
+        performChunk(m_chunk);
+    }
+
+    return !isBusy();
+}
+
+void
+PartitionedFft::finish() noexcept
+{
+    step(getNumRemainingChunks());
+}
+
+void
+PartitionedFft::performChunk(size_t chunk) noexcept
+{
+    auto* re = m_re.data();
+    auto* im = m_im.data();
+
+    // Load pass: even samples form the real parts and odd samples the
+    // imaginary parts of the complex transform, in bit-reversed order
+    if (chunk < m_numLoadChunks) {
+        const auto* input = m_input.data();
+        const auto mask = m_input.size() - 1;
+        const auto begin = chunk * k_chunkSize;
+        const auto end = std::min(begin + k_chunkSize, m_halfSize);
+        for (auto i = begin; i < end; ++i) {
+            const auto r = m_plan->BitReversal[i];
+            const auto even = input[(m_first + 2 * i) & mask];
+            const auto odd = input[(m_first + 2 * i + 1) & mask];
+            re[r] = even * m_window[2 * i];
+            im[r] = odd * m_window[2 * i + 1];
+        }
+        return;
+    }
+    chunk -= m_numLoadChunks;
+
+    // Butterfly stages, same as BuiltinFft: butterfly t of the stage with
+    // half size h combines elements b + j and b + j + h, with b = 2h (t / h)
+    // and j = t % h
+    const auto numStages = getNumBits(m_halfSize);
+    if (chunk < numStages * m_numStageChunks) {
+        const auto half = (size_t)1 << (chunk / m_numStageChunks);
+        const auto* twRe = m_plan->TwiddlesRe.data() + half;
+        const auto* twIm = m_plan->TwiddlesIm.data() + half;
+
+        const auto first = (chunk % m_numStageChunks) * k_chunkSize;
+        const auto last = std::min(first + k_chunkSize, m_halfSize / 2);
+        for (auto t = first; t < last;) {
+            const auto j0 = t % half;
+            const auto b = 2 * (t - j0);
+            const auto count = std::min(half - j0, last - t);
+            for (auto j = j0; j < j0 + count; ++j) {
+                const auto br = re[b + j + half];
+                const auto bi = im[b + j + half];
+                const auto tr = br * twRe[j] - bi * twIm[j];
+                const auto ti = br * twIm[j] + bi * twRe[j];
+                re[b + j + half] = re[b + j] - tr;
+                im[b + j + half] = im[b + j] - ti;
+                re[b + j] += tr;
+                im[b + j] += ti;
+            }
+            t += count;
+        }
+        return;
+    }
+    chunk -= numStages * m_numStageChunks;
+
+    // Split pass into magnitudes
+    const auto begin = chunk * k_chunkSize;
+    const auto end = std::min(begin + k_chunkSize, m_halfSize + 1);
+    for (auto k = begin; k < end; ++k) {
+        if (k == 0 || k == m_halfSize) {
+            // Bins 0 and N/2 only depend on the first complex bin
+            m_magnitudes[k] = std::abs(k == 0 ? re[0] + im[0] : re[0] - im[0]);
+            continue;
+        }
+
+        const auto mirror = m_halfSize - k;
+        const auto evenRe = 0.5f * (re[k] + re[mirror]);
+        const auto evenIm = 0.5f * (im[k] - im[mirror]);
+        const auto oddRe = 0.5f * (im[k] + im[mirror]);
+        const auto oddIm = -0.5f * (re[k] - re[mirror]);
+
+        const auto wr = m_plan->SplitRe[k];
+        const auto wi = m_plan->SplitIm[k];
+        const auto binRe = evenRe + oddRe * wr - oddIm * wi;
+        const auto binIm = evenIm + oddRe * wi + oddIm * wr;
+        m_magnitudes[k] = std::sqrt(binRe * binRe + binIm * binIm);
+    }
+}
+
+} // namespace spectrex
@@ -0,0 +1,94 @@
+#include <Spectrex/Analysis/PartitionedStft.hpp>
+
+// Stdlib
+#include <algorithm>
+
+namespace spectrex {
+
+namespace {
+
+/// Returns the smallest power of two of at least \a value.
+auto
+getNextPowerOfTwo(size_t value) noexcept -> size_t
+{
+    size_t result = 1;
+    while (result < value) {
+        result *= 2;
+    }
+    return result;
+}
+
+} // namespace
+
+PartitionedStft::PartitionedStft(size_t size,
+                                 size_t hop,
+                                 size_t firstBin,
+                                 size_t lastBin,
+                                 bool spread)
+  : m_size(size)
+  , m_hop(std::max<size_t>(1, hop))
+  , m_firstBin(std::min(firstBin, size / 2))
+  , m_numBins(std::min(lastBin, size / 2) + 1 - m_firstBin)
+  , m_spread(spread)
+  , m_history(getNextPowerOfTwo(size + m_hop))
+  , m_window(TableCache::getWindow(Window::WindowHann, size))
+  , m_fft(size)
+{
+}
+
+void
+PartitionedStft::reset() noexcept
+{
+    m_fft.cancel();
+    m_samplesSinceFrame = 0;
+    std::fill(m_history.begin(), m_history.end(), 0.0f);
+    m_historyIndex = 0;
+}
+
+void
+PartitionedStft::process(gsl::span<const float> samples,
+                         const FrameHandler& handler) noexcept
+{
+    const auto mask = m_history.size() - 1;
+    const auto deliver = [&] {
+        handler(gsl::span<const float>(m_fft.getMagnitudes() + m_firstBin,
+                                       m_numBins));
+    };
+
+    while (!samples.empty()) {
+        const auto samplesToFrame = m_hop - m_samplesSinceFrame;
+        const auto n = std::min(samples.size(), samplesToFrame);
+        for (const auto sample : samples.first(n)) {
+            m_history[m_historyIndex] = sample;
+            m_historyIndex = (m_historyIndex + 1) & mask;
+        }
+        samples = samples.subspan(n);
+        m_samplesSinceFrame += n;
+
+        // Perform work of the frame in progress in proportion to the
+        // samples, so it is done by the time the next frame comes due
+        if (m_fft.isBusy()) {
+            const auto numChunks =
+              (m_fft.getNumRemainingChunks() * n + samplesToFrame - 1) /
+              samplesToFrame;
+            if (m_fft.step(numChunks)) {
+                deliver();
+            }
+        }
+
+        if (m_samplesSinceFrame < m_hop) {
+            continue;
+        }
+        m_samplesSinceFrame = 0;
+
+        // Start the frame that came due, oldest sample first
+        m_fft.start(
+          m_history, (m_historyIndex - m_size) & mask, m_window->data());
+        if (!m_spread) {
+            m_fft.finish();
+            deliver();
+        }
+    }
+}
+
+} // namespace spectrex
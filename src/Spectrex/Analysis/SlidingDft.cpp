@@ -0,0 +1,146 @@
+#include <Spectrex/Analysis/SlidingDft.hpp>
+
+// Stdlib
+#include <algorithm>
+#include <cmath>
+
+namespace spectrex {
+
+SlidingDft::SlidingDft(size_t size, size_t firstBin, size_t lastBin)
+  : m_size(size)
+  , m_firstBin(std::min(firstBin, size / 2))
+  , m_numBins(std::min(lastBin, size / 2) + 1 - m_firstBin)
+  , m_history(size)
+  , m_fft(FftBackendRegistry::create(size))
+  , m_frame(size)
+  , m_spectrum(size / 2 + 1)
+{
+    KASSERT(firstBin <= lastBin, "Bin range must not be empty");
+
+    // Track one additional bin on either side for the window kernel, the
+    // bins beyond DC and Nyquist follow from conjugate symmetry
+    m_firstStateBin = m_firstBin > 0 ? m_firstBin - 1 : 0;
+    m_numStateBins =
+      std::min(m_firstBin + m_numBins, size / 2) + 1 - m_firstStateBin;
+
+    m_re.resize(m_numStateBins);
+    m_im.resize(m_numStateBins);
+    m_rotationRe.resize(m_numStateBins);
+    m_rotationIm.resize(m_numStateBins);
+
+    const auto pi = std::acos(-1.0);
+    for (size_t b = 0; b < m_numStateBins; ++b) {
+        const auto angle =
+          2.0 * pi * (double)(m_firstStateBin + b) / (double)size;
+        m_rotationRe[b] = std::cos(angle);
+        m_rotationIm[b] = std::sin(angle);
+    }
+}
+
+void
+SlidingDft::reset() noexcept
+{
+    std::fill(m_re.begin(), m_re.end(), 0.0);
+    std::fill(m_im.begin(), m_im.end(), 0.0);
+    std::fill(m_history.begin(), m_history.end(), 0.0f);
+    m_historyIndex = 0;
+    m_samplesSinceResync = 0;
+}
+
+void
+SlidingDft::process(gsl::span<const float> samples) noexcept
+{
+    auto* re = m_re.data();
+    auto* im = m_im.data();
+    const auto* rotationRe = m_rotationRe.data();
+    const auto* rotationIm = m_rotationIm.data();
+
+    for (const auto sample : samples) {
+        // The new sample enters the window, the oldest sample leaves it
+        const auto delta = (double)sample - (double)m_history[m_historyIndex];
+        m_history[m_historyIndex] = sample;
+        m_historyIndex = (m_historyIndex + 1) & (m_size - 1);
+
+        // S_k(n) = e^(i 2 pi k / N) * (S_k(n - 1) + x(n) - x(n - N))
+        for (size_t b = 0; b < m_numStateBins; ++b) {
+            const auto r = re[b] + delta;
+            const auto i = im[b];
+            re[b] = r * rotationRe[b] - i * rotationIm[b];
+            im[b] = r * rotationIm[b] + i * rotationRe[b];
+        }
+
+        if (++m_samplesSinceResync == k_resyncInterval * m_size) {
+            resync();
+        }
+    }
+}
+
+void
+SlidingDft::copyHistory(float* samples, size_t count) const noexcept
+{
+    const auto start = (m_historyIndex + m_size - count) & (m_size - 1);
+    const auto first = std::min(count, m_size - start);
+    std::copy_n(m_history.begin() + start, first, samples);
+    std::copy_n(m_history.begin(), count - first, samples + first);
+}
+
+void
+SlidingDft::setHistory(gsl::span<const float> samples) noexcept
+{
+    const auto count = std::min(samples.size(), m_size);
+    std::fill(m_history.begin(), m_history.end() - count, 0.0f);
+    std::copy(samples.end() - count, samples.end(), m_history.end() - count);
+    m_historyIndex = 0;
+
+    resync();
+}
+
+void
+SlidingDft::resync() noexcept
+{
+    // Linearize the history, oldest sample first
+    std::copy(m_history.begin() + m_historyIndex, m_history.end(),
+              m_frame.begin());
+    std::copy(m_history.begin(), m_history.begin() + m_historyIndex,
+              m_frame.begin() + (m_size - m_historyIndex));
+
+    m_fft->forward(m_frame.data(), m_spectrum.data());
+
+    for (size_t b = 0; b < m_numStateBins; ++b) {
+        m_re[b] = m_spectrum[m_firstStateBin + b].real();
+        m_im[b] = m_spectrum[m_firstStateBin + b].imag();
+    }
+
+    m_samplesSinceResync = 0;
+}
+
+auto
+SlidingDft::getBin(ptrdiff_t k) const noexcept -> std::complex<double>
+{
+    const auto half = (ptrdiff_t)m_size / 2;
+
+    if (k < 0) {
+        return std::conj(getBin(-k));
+    }
+    if (k > half) {
+        return std::conj(getBin((ptrdiff_t)m_size - k));
+    }
+
+    const auto b = (size_t)k - m_firstStateBin;
+    return { m_re[b], m_im[b] };
+}
+
+void
+SlidingDft::getMagnitudes(float* magnitudes) const noexcept
+{
+    // Hann window as a frequency domain kernel:
+    // Y_k = 0.5 * S_k - 0.25 * (S_(k - 1) + S_(k + 1))
+    for (size_t b = 0; b < m_numBins; ++b) {
+        const auto k = (ptrdiff_t)(m_firstBin + b);
+        const auto bin =
+          0.5 * getBin(k) - 0.25 * (getBin(k - 1) + getBin(k + 1));
+        magnitudes[b] = (float)std::sqrt(std::norm(bin));
+    }
+}
+
+} // namespace spectrex
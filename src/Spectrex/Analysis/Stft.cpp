@@ -0,0 +1,158 @@
+#include <Spectrex/Analysis/Stft.hpp>
+
+// Stdlib
+#include <algorithm>
+#include <cmath>
+
+namespace spectrex {
+
+auto
+Stft::estimateCostPerHop(Method method,
+                         size_t size,
+                         size_t hop,
+                         size_t numBins) noexcept -> double
+{
+    // A real FFT of size N costs about 2.5 N log2(N) operations, on top of
+    // that every sample is windowed, loaded and split, and every bin turned
+    // into a magnitude
+    const auto fftCost =
+      (double)size * (2.5 * std::log2((double)size) + 4.0);
+
+    if (method == Method::SlidingDft) {
+        // Every sample costs a complex rotation (6 operations) per tracked
+        // bin, every frame costs a window kernel and magnitude per bin, and
+        // the periodic resync is spread out over all samples
+        const auto numStateBins = (double)numBins + 2.0;
+        return (double)hop * numStateBins * 6.0 + (double)numBins * 12.0 +
+               fftCost * (double)hop /
+                 (double)(SlidingDft::k_resyncInterval * size);
+    }
+
+    return fftCost;
+}
+
+Stft::Stft(size_t size,
+           size_t hop,
+           size_t firstBin,
+           size_t lastBin,
+           Method method)
+  : m_size(size)
+  , m_hop(std::max<size_t>(1, hop))
+  , m_firstBin(std::min(firstBin, size / 2))
+  , m_numBins(std::min(lastBin, size / 2) + 1 - m_firstBin)
+  , m_method(
+      method != Method::Automatic ? method
+      : estimateCostPerHop(Method::SlidingDft, size, m_hop, m_numBins) <
+          estimateCostPerHop(Method::Fft, size, m_hop, m_numBins)
+        ? Method::SlidingDft
+        : Method::Fft)
+  , m_magnitudes(m_numBins)
+  , m_frame(size)
+{
+    if (m_method == Method::SlidingDft) {
+        m_slidingDft = std::make_unique<spectrex::SlidingDft>(
+          size, m_firstBin, m_firstBin + m_numBins - 1);
+        return;
+    }
+
+    m_fft = FftBackendRegistry::create(size);
+    m_history.resize(size);
+    m_spectrum.resize(size / 2 + 1);
+
+    // Periodic Hann window, matching the frequency domain window of the
+    // sliding DFT
+    m_window = TableCache::getWindow(Window::WindowHann, size);
+}
+
+void
+Stft::reset() noexcept
+{
+    m_samplesSinceFrame = 0;
+
+    if (m_slidingDft != nullptr) {
+        m_slidingDft->reset();
+    } else {
+        std::fill(m_history.begin(), m_history.end(), 0.0f);
+        m_historyIndex = 0;
+    }
+}
+
+void
+Stft::continueFrom(const Stft& previous) noexcept
+{
+    // Most recent samples of the previous history, zero padded if it is
+    // shorter
+    const auto count = std::min(m_size, previous.m_size);
+    std::fill(m_frame.begin(), m_frame.end() - count, 0.0f);
+    previous.copyHistory(m_frame.data() + (m_size - count), count);
+
+    if (m_slidingDft != nullptr) {
+        m_slidingDft->setHistory(m_frame);
+    } else {
+        std::copy(m_frame.begin(), m_frame.end(), m_history.begin());
+        m_historyIndex = 0;
+    }
+
+    m_samplesSinceFrame = 0;
+}
+
+void
+Stft::copyHistory(float* samples, size_t count) const noexcept
+{
+    if (m_slidingDft != nullptr) {
+        m_slidingDft->copyHistory(samples, count);
+        return;
+    }
+
+    const auto start = (m_historyIndex + m_size - count) & (m_size - 1);
+    const auto first = std::min(count, m_size - start);
+    std::copy_n(m_history.begin() + start, first, samples);
+    std::copy_n(m_history.begin(), count - first, samples + first);
+}
+
+void
+Stft::process(gsl::span<const float> samples,
+              const FrameHandler& handler) noexcept
+{
+    while (!samples.empty()) {
+        const auto n = std::min(samples.size(), m_hop - m_samplesSinceFrame);
+        const auto chunk = samples.first(n);
+        samples = samples.subspan(n);
+
+        if (m_slidingDft != nullptr) {
+            m_slidingDft->process(chunk);
+        } else {
+            for (const auto sample : chunk) {
+                m_history[m_historyIndex] = sample;
+                m_historyIndex = (m_historyIndex + 1) & (m_size - 1);
+            }
+        }
+
+        m_samplesSinceFrame += n;
+        if (m_samplesSinceFrame < m_hop) {
+            continue;
+        }
+        m_samplesSinceFrame = 0;
+
+        // Complete frame
+        if (m_slidingDft != nullptr) {
+            m_slidingDft->getMagnitudes(m_magnitudes.data());
+        } else {
+            // Linearize the history, oldest sample first
+            std::copy(m_history.begin() + m_historyIndex, m_history.end(),
+                      m_frame.begin());
+            std::copy(m_history.begin(), m_history.begin() + m_historyIndex,
+                      m_frame.begin() + (m_size - m_historyIndex));
+
+            m_fft->forwardMagnitudes(
+              m_frame.data(), m_window->data(), m_spectrum.data());
+            std::copy(m_spectrum.begin() + m_firstBin,
+                      m_spectrum.begin() + m_firstBin + m_numBins,
+                      m_magnitudes.begin());
+        }
+
+        handler(m_magnitudes);
+    }
+}
+
+} // namespace spectrex
@@ -0,0 +1,71 @@
+#include <Spectrex/Analysis/SwappableStft.hpp>
+
+// Stdlib
+#include <algorithm>
+
+namespace spectrex {
+
+SwappableStft::SwappableStft(size_t size,
+                             size_t hop,
+                             size_t firstBin,
+                             size_t lastBin,
+                             Stft::Method method)
+  : m_active(std::make_unique<Stft>(size, hop, firstBin, lastBin, method))
+{
+}
+
+SwappableStft::~SwappableStft()
+{
+    delete m_pending.exchange(nullptr);
+    delete m_retired.exchange(nullptr);
+}
+
+void
+SwappableStft::configure(size_t size,
+                         size_t hop,
+                         size_t firstBin,
+                         size_t lastBin,
+                         Stft::Method method)
+{
+    releaseRetired();
+
+    // Build the new transform here, so the processing thread only swaps
+    // pointers. A configuration that was not swapped in yet is superseded.
+    auto next = std::make_unique<Stft>(size, hop, firstBin, lastBin, method);
+    delete m_pending.exchange(next.release(), std::memory_order_acq_rel);
+}
+
+void
+SwappableStft::releaseRetired() noexcept
+{
+    delete m_retired.exchange(nullptr, std::memory_order_acq_rel);
+}
+
+void
+SwappableStft::process(gsl::span<const float> samples,
+                       const Stft::FrameHandler& handler) noexcept
+{
+    while (!samples.empty()) {
+        // Swap at a hop boundary, once the previously retired transform is
+        // released, so the processing thread never frees memory
+        const auto atBoundary =
+          m_active->getSamplesToNextFrame() == m_active->getHop();
+        if (atBoundary &&
+            m_retired.load(std::memory_order_acquire) == nullptr) {
+            if (auto* next =
+                  m_pending.exchange(nullptr, std::memory_order_acq_rel)) {
+                next->continueFrom(*m_active);
+                m_retired.store(m_active.release(), std::memory_order_release);
+                m_active.reset(next);
+            }
+        }
+
+        // Process up to the next hop boundary
+        const auto n =
+          std::min(samples.size(), m_active->getSamplesToNextFrame());
+        m_active->process(samples.first(n), handler);
+        samples = samples.subspan(n);
+    }
+}
+
+} // namespace spectrex
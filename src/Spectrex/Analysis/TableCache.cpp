@@ -0,0 +1,120 @@
+#include <Spectrex/Analysis/TableCache.hpp>
+
+// Stdlib
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace spectrex {
+
+namespace {
+
+/// Tables of one kind, held weakly so they are released along with their
+/// last user.
+template<typename Key, typename Table>
+struct Cache
+{
+    std::mutex Mutex;
+    std::map<Key, std::weak_ptr<const Table>> Entries;
+
+    /// Returns the table of \a key, building it using \a build if it is not
+    /// in use.
+    template<typename Build>
+    auto get(const Key& key, Build&& build) -> std::shared_ptr<const Table>
+    {
+        std::lock_guard<std::mutex> lock{ Mutex };
+
+        if (const auto it = Entries.find(key); it != Entries.end()) {
+            if (auto table = it->second.lock()) {
+                return table;
+            }
+        }
+
+        // Drop the entries of released tables, before adding a new one
+        for (auto it = Entries.begin(); it != Entries.end();) {
+            it = it->second.expired() ? Entries.erase(it) : std::next(it);
+        }
+
+        std::shared_ptr<const Table> table = build();
+        Entries[key] = table;
+        return table;
+    }
+
+    /// Returns the number of tables in use.
+    auto getNumTables() -> size_t
+    {
+        std::lock_guard<std::mutex> lock{ Mutex };
+
+        return (size_t)std::count_if(
+          Entries.begin(), Entries.end(), [](const auto& entry) {
+              return !entry.second.expired();
+          });
+    }
+};
+
+auto
+getFftPlans() -> Cache<size_t, FftPlan>&
+{
+    static Cache<size_t, FftPlan> cache;
+    return cache;
+}
+
+auto
+getWindows() -> Cache<std::pair<Window, size_t>, WindowTable>&
+{
+    static Cache<std::pair<Window, size_t>, WindowTable> cache;
+    return cache;
+}
+
+/// Computes the coefficients of a periodic window.
+auto
+makeWindow(Window window, size_t size) -> std::shared_ptr<WindowTable>
+{
+    const auto pi = std::acos(-1.0);
+
+    auto table = std::make_shared<WindowTable>(size, 1.0f);
+    for (size_t i = 0; i < size; ++i) {
+        const auto phase = 2.0 * pi * (double)i / (double)size;
+        switch (window) {
+            case Window::WindowHann:
+                (*table)[i] = (float)(0.5 - 0.5 * std::cos(phase));
+                break;
+            case Window::WindowBlackman:
+                (*table)[i] = (float)(0.42 - 0.5 * std::cos(phase) +
+                                      0.08 * std::cos(2.0 * phase));
+                break;
+            default:
+                break;
+        }
+    }
+
+    return table;
+}
+
+} // namespace
+
+auto
+TableCache::getFftPlan(size_t size) -> std::shared_ptr<const FftPlan>
+{
+    return getFftPlans().get(
+      size, [&] { return std::make_shared<FftPlan>(size); });
+}
+
+auto
+TableCache::getWindow(Window window, size_t size)
+  -> std::shared_ptr<const WindowTable>
+{
+    return getWindows().get(std::make_pair(window, size),
+                            [&] { return makeWindow(window, size); });
+}
+
+auto
+TableCache::getNumTables() -> size_t
+{
+    return getFftPlans().getNumTables() + getWindows().getNumTables();
+}
+
+} // namespace spectrex
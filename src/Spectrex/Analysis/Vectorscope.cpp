@@ -0,0 +1,350 @@
+#include <Spectrex/Analysis/Vectorscope.hpp>
+
+// Stdlib
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) ||            \
+  defined(_M_IX86)
+#define SPECTREX_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(SPECTREX_SIMD_X86) && !defined(_MSC_VER)
+#define SPECTREX_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+#define SPECTREX_TARGET_AVX2
+#endif
+
+namespace spectrex {
+
+namespace {
+
+/// Weight of the density histogram above which the cells are renormalized.
+constexpr float k_maxDensityWeight = 1e20f;
+
+/// Returns the density cell coordinate of a side or mid value, clamped to the
+/// histogram. NaN maps to 0.
+inline auto
+getCellCoordinate(float value, float densitySize) noexcept -> int32_t
+{
+    const auto position = (value + 1.0f) * 0.5f * densitySize;
+    const auto clamped = position > 0.0f ? position : 0.0f;
+    return (int32_t)std::min(clamped, densitySize - 1.0f);
+}
+
+/// Rotates samples into side and mid, computes their density cells if
+/// \a densitySize is not 0, and sums left * right, left * left and
+/// right * right.
+void
+rotateScalar(const float* left,
+             const float* right,
+             size_t numSamples,
+             int32_t densitySize,
+             float* side,
+             float* mid,
+             int32_t* cells,
+             float* sums) noexcept
+{
+    sums[0] = 0.0f;
+    sums[1] = 0.0f;
+    sums[2] = 0.0f;
+    for (size_t i = 0; i < numSamples; ++i) {
+        side[i] = (left[i] - right[i]) * 0.5f;
+        mid[i] = (left[i] + right[i]) * 0.5f;
+        sums[0] += left[i] * right[i];
+        sums[1] += left[i] * left[i];
+        sums[2] += right[i] * right[i];
+    }
+
+    if (densitySize != 0) {
+        const auto size = (float)densitySize;
+        for (size_t i = 0; i < numSamples; ++i) {
+            cells[i] = getCellCoordinate(mid[i], size) * densitySize +
+                       getCellCoordinate(side[i], size);
+        }
+    }
+}
+
+#if defined(SPECTREX_SIMD_X86)
+
+/// Returns the sum of all elements.
+SPECTREX_TARGET_AVX2 auto
+sumAvx2(__m256 value) noexcept -> float
+{
+    auto sum = _mm_add_ps(_mm256_castps256_ps128(value),
+                          _mm256_extractf128_ps(value, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+    return _mm_cvtss_f32(sum);
+}
+
+/// Rotates samples into side and mid, computes their density cells if
+/// \a densitySize is not 0, and sums left * right, left * left and
+/// right * right, 8 samples at a time.
+SPECTREX_TARGET_AVX2 void
+rotateAvx2(const float* left,
+           const float* right,
+           size_t numSamples,
+           int32_t densitySize,
+           float* side,
+           float* mid,
+           int32_t* cells,
+           float* sums) noexcept
+{
+    const auto half = _mm256_set1_ps(0.5f);
+    const auto one = _mm256_set1_ps(1.0f);
+    const auto zero = _mm256_setzero_ps();
+    const auto scale = _mm256_set1_ps(0.5f * (float)densitySize);
+    const auto last = _mm256_set1_ps((float)densitySize - 1.0f);
+    const auto stride = _mm256_set1_epi32(densitySize);
+
+    auto leftRight = _mm256_setzero_ps();
+    auto leftLeft = _mm256_setzero_ps();
+    auto rightRight = _mm256_setzero_ps();
+
+    size_t i = 0;
+    for (; i + 8 <= numSamples; i += 8) {
+        const auto l = _mm256_loadu_ps(left + i);
+        const auto r = _mm256_loadu_ps(right + i);
+        const auto s = _mm256_mul_ps(_mm256_sub_ps(l, r), half);
+        const auto m = _mm256_mul_ps(_mm256_add_ps(l, r), half);
+        _mm256_storeu_ps(side + i, s);
+        _mm256_storeu_ps(mid + i, m);
+
+        leftRight = _mm256_fmadd_ps(l, r, leftRight);
+        leftLeft = _mm256_fmadd_ps(l, l, leftLeft);
+        rightRight = _mm256_fmadd_ps(r, r, rightRight);
+
+        if (densitySize != 0) {
+            // Max and min return their second operand for NaN
+            const auto column = _mm256_cvttps_epi32(_mm256_min_ps(
+              _mm256_max_ps(_mm256_mul_ps(_mm256_add_ps(s, one), scale), zero),
+              last));
+            const auto row = _mm256_cvttps_epi32(_mm256_min_ps(
+              _mm256_max_ps(_mm256_mul_ps(_mm256_add_ps(m, one), scale), zero),
+              last));
+            _mm256_storeu_si256(
+              reinterpret_cast<__m256i*>(cells + i),
+              _mm256_add_epi32(_mm256_mullo_epi32(row, stride), column));
+        }
+    }
+
+    sums[0] = sumAvx2(leftRight);
+    sums[1] = sumAvx2(leftLeft);
+    sums[2] = sumAvx2(rightRight);
+
+    // The remaining samples are computed here rather than by rotateScalar, as
+    // calling non-AVX code with the upper halves of the registers in use
+    // stalls
+    const auto size = (float)densitySize;
+    for (; i < numSamples; ++i) {
+        side[i] = (left[i] - right[i]) * 0.5f;
+        mid[i] = (left[i] + right[i]) * 0.5f;
+        sums[0] += left[i] * right[i];
+        sums[1] += left[i] * left[i];
+        sums[2] += right[i] * right[i];
+        if (densitySize != 0) {
+            cells[i] = getCellCoordinate(mid[i], size) * densitySize +
+                       getCellCoordinate(side[i], size);
+        }
+    }
+}
+
+#endif // SPECTREX_SIMD_X86
+
+} // namespace
+
+Vectorscope::Vectorscope(float sampleRate,
+                         const Config& config,
+                         SimdLevel simdLevel)
+  : m_sampleRate(sampleRate)
+  , m_config(config)
+  , m_simdLevel(simdLevel == SimdLevel::Avx2 &&
+                    detectSimdLevel() == SimdLevel::Avx2
+                  ? SimdLevel::Avx2
+                  : SimdLevel::Scalar)
+  , m_decimation(std::max<size_t>(
+      1,
+      (size_t)std::ceil((double)sampleRate /
+                        (k_frameRate *
+                         (double)std::max<size_t>(1, config.PointBudget)))))
+  , m_densityGrowth(
+      std::exp(1.0 / (k_densityTimeConstant * (double)sampleRate)))
+  , m_correlationDecay(
+      std::exp(-1.0 / (k_correlationTimeConstant * (double)sampleRate)))
+{
+    if (m_config.ReductionMode == Mode::Points) {
+        m_points.resize(std::max<size_t>(1, m_config.PointBudget));
+    } else {
+        const auto size = std::max<size_t>(1, m_config.DensitySize);
+        m_density.resize(size * size);
+    }
+}
+
+void
+Vectorscope::reset() noexcept
+{
+    std::fill(m_points.begin(), m_points.end(), VectorscopePoint{});
+    m_numPoints = 0;
+    m_pointIndex = 0;
+    m_decimationPhase = 0;
+
+    std::fill(m_density.begin(), m_density.end(), 0.0f);
+    m_densityWeight = 1.0f;
+
+    std::fill(std::begin(m_correlationSums), std::end(m_correlationSums), 0.0);
+    m_numSamples = 0;
+}
+
+void
+Vectorscope::process(AudioChannelView left, AudioChannelView right) noexcept
+{
+    auto* rotate = rotateScalar;
+#if defined(SPECTREX_SIMD_X86)
+    if (m_simdLevel == SimdLevel::Avx2) {
+        rotate = rotateAvx2;
+    }
+#endif
+
+    const auto numSamples = std::min(left.size(), right.size());
+    const auto densitySize =
+      m_density.empty()
+        ? 0
+        : (int32_t)std::max<size_t>(1, m_config.DensitySize);
+    m_numSamples += numSamples;
+
+    for (size_t offset = 0; offset < numSamples; offset += k_chunkSize) {
+        const auto n = std::min(k_chunkSize, numSamples - offset);
+
+        float side[k_chunkSize];
+        float mid[k_chunkSize];
+        int32_t cells[k_chunkSize];
+        float sums[3];
+        rotate(left.data() + offset,
+               right.data() + offset,
+               n,
+               densitySize,
+               side,
+               mid,
+               cells,
+               sums);
+
+        // Callers mostly pass the same number of samples, so the decay and
+        // growth of a chunk are only recomputed when its size changes
+        if (n != m_chunkSize) {
+            m_chunkSize = n;
+            m_chunkDecay = std::pow(m_correlationDecay, (double)n);
+            m_chunkGrowth = (float)std::pow(m_densityGrowth, (double)n);
+        }
+
+        for (size_t s = 0; s < 3; ++s) {
+            m_correlationSums[s] =
+              m_correlationSums[s] * m_chunkDecay + (double)sums[s];
+        }
+
+        addPoints(side, mid, cells, n);
+    }
+}
+
+void
+Vectorscope::addPoints(const float* side,
+                       const float* mid,
+                       const int32_t* cells,
+                       size_t numPoints) noexcept
+{
+    if (!m_points.empty()) {
+        // Every m_decimation-th point, continuing from the previous chunk
+        auto i = m_decimationPhase;
+        for (; i < numPoints; i += m_decimation) {
+            m_points[m_pointIndex] = { side[i], mid[i] };
+            if (++m_pointIndex == m_points.size()) {
+                m_pointIndex = 0;
+            }
+            ++m_numPoints;
+        }
+        m_decimationPhase = i - numPoints;
+        return;
+    }
+
+    // All points of a chunk share the weight of its first point
+    for (size_t i = 0; i < numPoints; ++i) {
+        m_density[(size_t)cells[i]] += m_densityWeight;
+    }
+
+    m_densityWeight *= m_chunkGrowth;
+    if (m_densityWeight > k_maxDensityWeight) {
+        const auto scale = 1.0f / m_densityWeight;
+        for (auto& cell : m_density) {
+            cell *= scale;
+        }
+        m_densityWeight = 1.0f;
+    }
+}
+
+auto
+Vectorscope::getInfo() const noexcept -> VectorscopeInfo
+{
+    VectorscopeInfo info;
+
+    const auto energy = m_correlationSums[1] * m_correlationSums[2];
+    if (energy > 1e-20) {
+        const auto correlation = m_correlationSums[0] / std::sqrt(energy);
+        info.Correlation = (float)std::clamp(correlation, -1.0, 1.0);
+    }
+
+    info.Decimation = m_decimation;
+    info.DensityScale =
+      (float)(1.0 / ((double)m_densityWeight * k_densityTimeConstant *
+                     (double)m_sampleRate));
+    info.NumSamples = m_numSamples;
+    return info;
+}
+
+void
+Vectorscope::syncPoints(const PointSyncHandler& handler) const
+{
+    if (m_points.empty()) {
+        return;
+    }
+
+    // Oldest point still held, and its position in the ring buffer
+    const auto capacity = m_points.size();
+    const auto numPoints = std::min(m_numPoints, capacity);
+    const auto firstPoint = m_numPoints - numPoints;
+    const auto start = firstPoint % capacity;
+    const auto numFirst = std::min(numPoints, capacity - start);
+
+    const auto info = getInfo();
+    const SyncInfo<const VectorscopePoint> first(
+      firstPoint, m_points.data() + start, 1, numFirst);
+    if (numFirst == numPoints) {
+        handler(info, first, std::nullopt);
+        return;
+    }
+
+    handler(info,
+            first,
+            SyncInfo<const VectorscopePoint>(
+              firstPoint + numFirst, m_points.data(), 1, numPoints - numFirst));
+}
+
+void
+Vectorscope::syncDensity(const DensitySyncHandler& handler) const
+{
+    if (m_density.empty()) {
+        return;
+    }
+
+    const auto size = std::max<size_t>(1, m_config.DensitySize);
+    handler(getInfo(), SyncInfo<const float>(0, m_density.data(), size, size));
+}
+
+auto
+Vectorscope::getMemorySize() const noexcept -> size_t
+{
+    return m_points.size() * sizeof(VectorscopePoint) +
+           m_density.size() * sizeof(float);
+}
+
+} // namespace spectrex
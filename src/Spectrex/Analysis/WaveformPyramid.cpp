@@ -0,0 +1,596 @@
+#include <Spectrex/Analysis/WaveformPyramid.hpp>
+
+// Stdlib
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) ||            \
+  defined(_M_IX86)
+#define SPECTREX_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(SPECTREX_SIMD_X86) && !defined(_MSC_VER)
+#define SPECTREX_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+#define SPECTREX_TARGET_AVX2
+#endif
+
+namespace spectrex {
+
+namespace {
+
+constexpr auto k_binSize = WaveformPyramid::k_baseBinSize;
+
+/// Size of the DFT of the spectral centroid, spanning two bins.
+constexpr auto k_centroidSize = 2 * k_binSize;
+
+/// Hann windowed DFT coefficients of the spectral centroid, per sample for
+/// DFT bins 1 up to and including Nyquist. DC does not contribute to the
+/// brightness of a signal.
+struct CentroidTables
+{
+    alignas(32) float Re[k_centroidSize][k_binSize];
+    alignas(32) float Im[k_centroidSize][k_binSize];
+};
+
+auto
+getCentroidTables() -> const CentroidTables&
+{
+    static const auto tables = [] {
+        const auto pi = std::acos(-1.0);
+
+        CentroidTables result;
+        for (size_t i = 0; i < k_centroidSize; ++i) {
+            const auto phase = 2.0 * pi * (double)i / (double)k_centroidSize;
+            const auto window = 0.5 - 0.5 * std::cos(phase);
+            for (size_t k = 0; k < k_binSize; ++k) {
+                const auto angle = phase * (double)(k + 1);
+                result.Re[i][k] = (float)(window * std::cos(angle));
+                result.Im[i][k] = (float)(-window * std::sin(angle));
+            }
+        }
+        return result;
+    }();
+
+    return tables;
+}
+
+/// Returns the number of set bits of \a bits.
+constexpr auto
+countBits(uint32_t bits) noexcept -> uint32_t
+{
+    bits = bits - ((bits >> 1) & 0x55555555u);
+    bits = (bits & 0x33333333u) + ((bits >> 2) & 0x33333333u);
+    bits = (bits + (bits >> 4)) & 0x0f0f0f0fu;
+    return (bits * 0x01010101u) >> 24;
+}
+
+/// Computes the minimum, maximum and number of zero crossings of a bin.
+void
+analyzeBinScalar(const float* samples,
+                 bool& lastPositive,
+                 WaveformBin& bin,
+                 uint32_t& numCrossings) noexcept
+{
+    bin.Min = samples[0];
+    bin.Max = samples[0];
+    numCrossings = 0;
+
+    for (size_t i = 0; i < k_binSize; ++i) {
+        bin.Min = std::min(bin.Min, samples[i]);
+        bin.Max = std::max(bin.Max, samples[i]);
+
+        const auto positive = samples[i] >= 0.0f;
+        numCrossings += positive != lastPositive ? 1 : 0;
+        lastPositive = positive;
+    }
+}
+
+/// Computes the spectral centroid of the previous and current bin, in DFT
+/// bins.
+auto
+getCentroidScalar(const float* previous, const float* current) noexcept
+  -> float
+{
+    const auto& tables = getCentroidTables();
+
+    float re[k_binSize] = {};
+    float im[k_binSize] = {};
+    for (size_t i = 0; i < k_centroidSize; ++i) {
+        const auto x = i < k_binSize ? previous[i] : current[i - k_binSize];
+        for (size_t k = 0; k < k_binSize; ++k) {
+            re[k] += x * tables.Re[i][k];
+            im[k] += x * tables.Im[i][k];
+        }
+    }
+
+    float weighted = 0.0f;
+    float sum = 0.0f;
+    for (size_t k = 0; k < k_binSize; ++k) {
+        const auto magnitude = std::sqrt(re[k] * re[k] + im[k] * im[k]);
+        weighted += magnitude * (float)(k + 1);
+        sum += magnitude;
+    }
+
+    return sum > 0.0f ? weighted / sum : 0.0f;
+}
+
+/// Filters a bin through the crossover, one biquad (lane) after the other,
+/// and computes the mean squares of the bands.
+template<typename State>
+void
+filterBandsScalar(const float* samples,
+                  State& state,
+                  WaveformBandBin& meanSquares) noexcept
+{
+    float sums[3] = {};
+    for (size_t i = 0; i < k_binSize; ++i) {
+        // Every second and later biquad of a band takes the output of its
+        // predecessor in the previous sample
+        const float input[8] = { samples[i], state.Y[0], samples[i],
+                                 state.Y[2], samples[i], state.Y[4],
+                                 state.Y[5], state.Y[6] };
+        for (size_t l = 0; l < 8; ++l) {
+            const auto y = state.B0[l] * input[l] + state.S1[l];
+            state.S1[l] =
+              state.B1[l] * input[l] - state.A1[l] * y + state.S2[l];
+            state.S2[l] = state.B2[l] * input[l] - state.A2[l] * y;
+            state.Y[l] = y;
+        }
+
+        sums[0] += state.Y[1] * state.Y[1];
+        sums[1] += state.Y[7] * state.Y[7];
+        sums[2] += state.Y[3] * state.Y[3];
+    }
+
+    meanSquares.Low = sums[0] / (float)k_binSize;
+    meanSquares.Mid = sums[1] / (float)k_binSize;
+    meanSquares.High = sums[2] / (float)k_binSize;
+}
+
+#if defined(SPECTREX_SIMD_X86)
+
+/// Returns the sum of all elements.
+SPECTREX_TARGET_AVX2 auto
+sumAvx2(__m256 value) noexcept -> float
+{
+    auto sum = _mm_add_ps(_mm256_castps256_ps128(value),
+                          _mm256_extractf128_ps(value, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+    return _mm_cvtss_f32(sum);
+}
+
+/// Computes the minimum, maximum and number of zero crossings of a bin, as
+/// two vectors of samples. The signs of all samples form a bitmask, so the
+/// zero crossings are the set bits of the bitmask xor itself shifted by one.
+SPECTREX_TARGET_AVX2 void
+analyzeBinAvx2(const float* samples,
+               bool& lastPositive,
+               WaveformBin& bin,
+               uint32_t& numCrossings) noexcept
+{
+    const auto low = _mm256_loadu_ps(samples);
+    const auto high = _mm256_loadu_ps(samples + 8);
+
+    const auto min8 = _mm256_min_ps(low, high);
+    auto min = _mm_min_ps(_mm256_castps256_ps128(min8),
+                          _mm256_extractf128_ps(min8, 1));
+    min = _mm_min_ps(min, _mm_movehl_ps(min, min));
+    min = _mm_min_ss(min, _mm_shuffle_ps(min, min, 1));
+    bin.Min = _mm_cvtss_f32(min);
+
+    const auto max8 = _mm256_max_ps(low, high);
+    auto max = _mm_max_ps(_mm256_castps256_ps128(max8),
+                          _mm256_extractf128_ps(max8, 1));
+    max = _mm_max_ps(max, _mm_movehl_ps(max, max));
+    max = _mm_max_ss(max, _mm_shuffle_ps(max, max, 1));
+    bin.Max = _mm_cvtss_f32(max);
+
+    const auto zero = _mm256_setzero_ps();
+    const auto positive =
+      (uint32_t)_mm256_movemask_ps(_mm256_cmp_ps(low, zero, _CMP_GE_OQ)) |
+      (uint32_t)_mm256_movemask_ps(_mm256_cmp_ps(high, zero, _CMP_GE_OQ))
+        << 8;
+    const auto previous = (positive << 1) | (lastPositive ? 1u : 0u);
+    numCrossings = countBits((positive ^ previous) & 0xffffu);
+    lastPositive = (positive >> 15) != 0;
+}
+
+/// Computes the spectral centroid of the previous and current bin, in DFT
+/// bins. Every sample is broadcast and accumulated into all 16 DFT bins at
+/// once, so there are no horizontal sums but for the final two.
+SPECTREX_TARGET_AVX2 auto
+getCentroidAvx2(const float* previous, const float* current) noexcept
+  -> float
+{
+    const auto& tables = getCentroidTables();
+
+    auto reLow = _mm256_setzero_ps();
+    auto reHigh = _mm256_setzero_ps();
+    auto imLow = _mm256_setzero_ps();
+    auto imHigh = _mm256_setzero_ps();
+    for (size_t i = 0; i < k_centroidSize; ++i) {
+        const auto x = _mm256_broadcast_ss(
+          i < k_binSize ? previous + i : current + (i - k_binSize));
+        reLow = _mm256_fmadd_ps(x, _mm256_load_ps(tables.Re[i]), reLow);
+        reHigh = _mm256_fmadd_ps(x, _mm256_load_ps(tables.Re[i] + 8), reHigh);
+        imLow = _mm256_fmadd_ps(x, _mm256_load_ps(tables.Im[i]), imLow);
+        imHigh = _mm256_fmadd_ps(x, _mm256_load_ps(tables.Im[i] + 8), imHigh);
+    }
+
+    const auto magnitudeLow = _mm256_sqrt_ps(_mm256_fmadd_ps(
+      reLow, reLow, _mm256_mul_ps(imLow, imLow)));
+    const auto magnitudeHigh = _mm256_sqrt_ps(_mm256_fmadd_ps(
+      reHigh, reHigh, _mm256_mul_ps(imHigh, imHigh)));
+
+    const auto kLow = _mm256_setr_ps(1, 2, 3, 4, 5, 6, 7, 8);
+    const auto kHigh = _mm256_setr_ps(9, 10, 11, 12, 13, 14, 15, 16);
+    const auto weighted = sumAvx2(_mm256_fmadd_ps(
+      magnitudeLow, kLow, _mm256_mul_ps(magnitudeHigh, kHigh)));
+    const auto sum = sumAvx2(_mm256_add_ps(magnitudeLow, magnitudeHigh));
+
+    return sum > 0.0f ? weighted / sum : 0.0f;
+}
+
+/// Filters a bin through the crossover, all eight biquads at once, and
+/// computes the mean squares of the bands.
+template<typename State>
+SPECTREX_TARGET_AVX2 void
+filterBandsAvx2(const float* samples,
+                State& state,
+                WaveformBandBin& meanSquares) noexcept
+{
+    const auto b0 = _mm256_load_ps(state.B0);
+    const auto b1 = _mm256_load_ps(state.B1);
+    const auto b2 = _mm256_load_ps(state.B2);
+    const auto a1 = _mm256_load_ps(state.A1);
+    const auto a2 = _mm256_load_ps(state.A2);
+    auto s1 = _mm256_load_ps(state.S1);
+    auto s2 = _mm256_load_ps(state.S2);
+    auto y = _mm256_load_ps(state.Y);
+
+    // Lanes 1, 3, 5, 6 and 7 take the output of their predecessor, lanes 0,
+    // 2 and 4 the sample
+    const auto predecessors = _mm256_setr_epi32(0, 0, 2, 2, 4, 4, 5, 6);
+    auto sums = _mm256_setzero_ps();
+    for (size_t i = 0; i < k_binSize; ++i) {
+        const auto input =
+          _mm256_blend_ps(_mm256_permutevar8x32_ps(y, predecessors),
+                          _mm256_broadcast_ss(samples + i),
+                          0x15);
+        y = _mm256_fmadd_ps(b0, input, s1);
+        s1 = _mm256_fmadd_ps(b1, input, _mm256_fnmadd_ps(a1, y, s2));
+        s2 = _mm256_fnmadd_ps(a2, y, _mm256_mul_ps(b2, input));
+        sums = _mm256_fmadd_ps(y, y, sums);
+    }
+
+    _mm256_store_ps(state.S1, s1);
+    _mm256_store_ps(state.S2, s2);
+    _mm256_store_ps(state.Y, y);
+
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, sums);
+    meanSquares.Low = lanes[1] / (float)k_binSize;
+    meanSquares.Mid = lanes[7] / (float)k_binSize;
+    meanSquares.High = lanes[3] / (float)k_binSize;
+}
+
+#endif // SPECTREX_SIMD_X86
+
+/// Computes the coefficients of a Butterworth lowpass or highpass biquad,
+/// normalized by a0, two of which in series form a Linkwitz-Riley filter.
+/// @return b0, b1, b2, a1 and a2.
+auto
+getButterworthCoefficients(double frequency, double sampleRate, bool highpass)
+  -> std::array<float, 5>
+{
+    const auto pi = std::acos(-1.0);
+    const auto omega =
+      2.0 * pi * std::clamp(frequency, 1.0, 0.49 * sampleRate) / sampleRate;
+    const auto alpha = std::sin(omega) / std::sqrt(2.0);
+    const auto cosine = std::cos(omega);
+    const auto a0 = 1.0 + alpha;
+
+    const auto b1 = highpass ? -(1.0 + cosine) : 1.0 - cosine;
+    const auto b0 = std::abs(b1) / 2.0;
+    return { (float)(b0 / a0),
+             (float)(b1 / a0),
+             (float)(b0 / a0),
+             (float)(-2.0 * cosine / a0),
+             (float)((1.0 - alpha) / a0) };
+}
+
+/// Passes the bins of a level ring buffer to \a handler, in chronological
+/// order.
+template<typename Bin, typename Handler>
+void
+syncBins(const WaveformPyramidInfo& info,
+         const std::vector<Bin>& bins,
+         const Handler& handler)
+{
+    // Oldest bin still held, and its position in the ring buffer
+    const auto numBins = std::min(info.EndBin, info.Capacity);
+    const auto firstBin = info.EndBin - numBins;
+    const auto start = firstBin % info.Capacity;
+    const auto numFirst = std::min(numBins, info.Capacity - start);
+
+    const SyncInfo<const Bin> first(firstBin, bins.data() + start, 1, numFirst);
+    if (numFirst == numBins) {
+        handler(info, first, std::nullopt);
+        return;
+    }
+
+    handler(info,
+            first,
+            SyncInfo<const Bin>(
+              firstBin + numFirst, bins.data(), 1, numBins - numFirst));
+}
+
+} // namespace
+
+WaveformPyramid::WaveformPyramid(float sampleRate,
+                                 double historySeconds,
+                                 size_t factor,
+                                 FrequencyMode frequencyMode,
+                                 SimdLevel simdLevel,
+                                 std::optional<Crossover> crossover)
+  : m_sampleRate(sampleRate)
+  , m_factor(std::max<size_t>(2, factor))
+  , m_frequencyMode(frequencyMode)
+  , m_simdLevel(simdLevel == SimdLevel::Avx2 &&
+                    detectSimdLevel() == SimdLevel::Avx2
+                  ? SimdLevel::Avx2
+                  : SimdLevel::Scalar)
+  , m_crossover(crossover)
+  , m_frequencySmoothing((float)(
+      1.0 - std::exp(-(double)k_baseBinSize /
+                     (k_frequencyTimeConstant * (double)sampleRate))))
+{
+    // Every level covers the entire history, down to a couple of bins
+    auto numBins = std::max<size_t>(
+      2,
+      (size_t)std::ceil(historySeconds * (double)sampleRate /
+                        (double)k_baseBinSize));
+    auto binSize = k_baseBinSize;
+    while (m_levels.size() < k_maxNumLevels) {
+        Level level;
+        level.BinSize = binSize;
+        level.Bins.resize(numBins);
+        if (m_crossover) {
+            level.BandBins.resize(numBins);
+        }
+        m_levels.push_back(std::move(level));
+
+        if (numBins <= 2) {
+            break;
+        }
+        numBins = std::max<size_t>(2, (numBins + m_factor - 1) / m_factor);
+        binSize *= m_factor;
+    }
+
+    if (m_crossover) {
+        // Lowpasses at LowMid, highpasses at MidHigh, and the mid band
+        // between the two
+        const auto lowMid = (double)m_crossover->LowMid;
+        const auto midHigh = std::max((double)m_crossover->MidHigh, lowMid);
+        const bool highpasses[8] = { false, false, true, true,
+                                     true,  true,  false, false };
+        const double frequencies[8] = { lowMid, lowMid, midHigh, midHigh,
+                                        lowMid, lowMid, midHigh, midHigh };
+        for (size_t l = 0; l < 8; ++l) {
+            const auto coefficients = getButterworthCoefficients(
+              frequencies[l], (double)sampleRate, highpasses[l]);
+            m_crossoverState.B0[l] = coefficients[0];
+            m_crossoverState.B1[l] = coefficients[1];
+            m_crossoverState.B2[l] = coefficients[2];
+            m_crossoverState.A1[l] = coefficients[3];
+            m_crossoverState.A2[l] = coefficients[4];
+        }
+    }
+}
+
+void
+WaveformPyramid::reset() noexcept
+{
+    for (auto& level : m_levels) {
+        std::fill(level.Bins.begin(), level.Bins.end(), WaveformBin{});
+        level.NumCompleted = 0;
+        level.NumMerged = 0;
+        level.FrequencySum = 0.0f;
+        std::fill(
+          level.BandBins.begin(), level.BandBins.end(), WaveformBandBin{});
+        level.BandSum = WaveformBandBin{};
+    }
+
+    m_numSamples = 0;
+    m_binFill = 0;
+    m_lastPositive = false;
+    std::fill(std::begin(m_previousSamples), std::end(m_previousSamples), 0.0f);
+    m_frequency = 0.0f;
+    for (size_t l = 0; l < 8; ++l) {
+        m_crossoverState.S1[l] = 0.0f;
+        m_crossoverState.S2[l] = 0.0f;
+        m_crossoverState.Y[l] = 0.0f;
+    }
+}
+
+void
+WaveformPyramid::process(gsl::span<const float> samples) noexcept
+{
+    m_numSamples += samples.size();
+
+    while (!samples.empty()) {
+        // Whole bins are computed in place
+        if (m_binFill == 0 && samples.size() >= k_baseBinSize) {
+            processBin(samples.data());
+            samples = samples.subspan(k_baseBinSize);
+            continue;
+        }
+
+        const auto n = std::min(samples.size(), k_baseBinSize - m_binFill);
+        std::copy_n(samples.data(), n, m_binSamples + m_binFill);
+        samples = samples.subspan(n);
+
+        m_binFill += n;
+        if (m_binFill == k_baseBinSize) {
+            m_binFill = 0;
+            processBin(m_binSamples);
+        }
+    }
+}
+
+void
+WaveformPyramid::processBin(const float* samples) noexcept
+{
+    auto* analyzeBin = analyzeBinScalar;
+    auto* getCentroid = getCentroidScalar;
+    auto* filterBands = filterBandsScalar<CrossoverState>;
+#if defined(SPECTREX_SIMD_X86)
+    if (m_simdLevel == SimdLevel::Avx2) {
+        analyzeBin = analyzeBinAvx2;
+        getCentroid = getCentroidAvx2;
+        filterBands = filterBandsAvx2<CrossoverState>;
+    }
+#endif
+
+    WaveformBin bin;
+    uint32_t numCrossings = 0;
+    analyzeBin(samples, m_lastPositive, bin, numCrossings);
+
+    if (m_frequencyMode != FrequencyMode::None) {
+        float frequency = 0.0f;
+        if (m_frequencyMode == FrequencyMode::ZeroCrossing) {
+            // Two zero crossings per period
+            frequency = (float)numCrossings / (float)k_baseBinSize *
+                        m_sampleRate / 2.0f;
+        } else {
+            frequency = getCentroid(m_previousSamples, samples) *
+                        m_sampleRate / (float)k_centroidSize;
+            std::memcpy(
+              m_previousSamples, samples, sizeof(float) * k_baseBinSize);
+        }
+
+        m_frequency += m_frequencySmoothing * (frequency - m_frequency);
+        bin.Frequency = m_frequency;
+    }
+
+    WaveformBandBin meanSquares;
+    if (m_crossover) {
+        filterBands(samples, m_crossoverState, meanSquares);
+    }
+
+    addBin(bin, meanSquares);
+}
+
+void
+WaveformPyramid::addBin(const WaveformBin& bin,
+                        const WaveformBandBin& meanSquares) noexcept
+{
+    const auto hasBands = m_crossover.has_value();
+    const auto toRms = [](const WaveformBandBin& sum, size_t count) {
+        return WaveformBandBin{ std::sqrt(sum.Low / (float)count),
+                                std::sqrt(sum.Mid / (float)count),
+                                std::sqrt(sum.High / (float)count) };
+    };
+
+    auto& finest = m_levels.front();
+    finest.Bins[finest.NumCompleted % finest.Bins.size()] = bin;
+    if (hasBands) {
+        finest.BandBins[finest.NumCompleted % finest.BandBins.size()] =
+          toRms(meanSquares, 1);
+    }
+    ++finest.NumCompleted;
+
+    for (size_t l = 1; l < m_levels.size(); ++l) {
+        auto& level = m_levels[l];
+        auto& merged = level.Bins[level.NumCompleted % level.Bins.size()];
+        if (level.NumMerged == 0) {
+            merged = bin;
+            level.FrequencySum = bin.Frequency;
+        } else {
+            merged.Min = std::min(merged.Min, bin.Min);
+            merged.Max = std::max(merged.Max, bin.Max);
+            level.FrequencySum += bin.Frequency;
+        }
+
+        ++level.NumMerged;
+        merged.Frequency = level.FrequencySum / (float)level.NumMerged;
+
+        if (hasBands) {
+            auto& sum = level.BandSum;
+            if (level.NumMerged == 1) {
+                sum = meanSquares;
+            } else {
+                sum.Low += meanSquares.Low;
+                sum.Mid += meanSquares.Mid;
+                sum.High += meanSquares.High;
+            }
+            level.BandBins[level.NumCompleted % level.BandBins.size()] =
+              toRms(sum, level.NumMerged);
+        }
+
+        if (level.NumMerged * k_baseBinSize == level.BinSize) {
+            level.NumMerged = 0;
+            ++level.NumCompleted;
+        }
+    }
+}
+
+auto
+WaveformPyramid::findLevel(double pixelsPerSample) const noexcept -> size_t
+{
+    if (!(pixelsPerSample > 0.0)) {
+        return m_levels.size() - 1;
+    }
+
+    const auto binsPerPixel =
+      1.0 / (pixelsPerSample * (double)k_baseBinSize);
+    const auto level =
+      std::round(std::log(binsPerPixel) / std::log((double)m_factor));
+    return (size_t)std::clamp(level, 0.0, (double)(m_levels.size() - 1));
+}
+
+auto
+WaveformPyramid::getInfo(size_t level) const noexcept -> WaveformPyramidInfo
+{
+    const auto& data = m_levels[level];
+
+    WaveformPyramidInfo info;
+    info.Level = level;
+    info.BinSize = data.BinSize;
+    info.Capacity = data.Bins.size();
+    info.EndBin = data.NumCompleted + (data.NumMerged > 0 ? 1 : 0);
+    info.NumSamples = m_numSamples;
+    return info;
+}
+
+void
+WaveformPyramid::sync(size_t level, const SyncHandler& handler) const
+{
+    syncBins(getInfo(level), m_levels[level].Bins, handler);
+}
+
+void
+WaveformPyramid::syncBands(size_t level, const BandSyncHandler& handler) const
+{
+    if (m_crossover) {
+        syncBins(getInfo(level), m_levels[level].BandBins, handler);
+    }
+}
+
+auto
+WaveformPyramid::getMemorySize() const noexcept -> size_t
+{
+    size_t size = 0;
+    for (const auto& level : m_levels) {
+        size += level.Bins.size() * sizeof(WaveformBin) +
+                level.BandBins.size() * sizeof(WaveformBandBin);
+    }
+    return size;
+}
+
+} // namespace spectrex
@@ -0,0 +1,241 @@
+#include <Spectrex/Analysis/ZoomFft.hpp>
+
+// Stdlib
+#include <algorithm>
+#include <cmath>
+
+namespace spectrex {
+
+namespace {
+
+/// Number of samples after which the oscillator is renormalized.
+constexpr size_t k_normalizationInterval = 4096;
+
+/// Number of anti-aliasing filter taps per unit of decimation.
+constexpr size_t k_tapsPerDecimation = 24;
+
+auto
+clampBand(double sampleRate, const FrequencyBand& band) noexcept
+  -> FrequencyBand
+{
+    const auto nyquist = (float)(sampleRate / 2.0);
+    return { std::clamp(band.MinFrequency, 0.0f, nyquist),
+             std::clamp(band.MaxFrequency, 0.0f, nyquist) };
+}
+
+} // namespace
+
+auto
+ZoomFft::getDecimation(double sampleRate, const FrequencyBand& band) noexcept
+  -> size_t
+{
+    // The decimated (complex) signal covers sampleRate / D around the centre
+    // of the band; leave half of that as transition band for the filter
+    const auto width =
+      std::max((double)clampBand(sampleRate, band).getWidth(), 1.0);
+
+    size_t decimation = 1;
+    while (decimation < k_maxDecimation &&
+           sampleRate / (double)(decimation * 2) >= 2.0 * width) {
+        decimation *= 2;
+    }
+
+    return decimation;
+}
+
+ZoomFft::ZoomFft(double sampleRate,
+                 const FrequencyBand& band,
+                 size_t size,
+                 size_t hop)
+  : m_sampleRate(sampleRate)
+  , m_decimation(getDecimation(sampleRate, band))
+  , m_size(size)
+  , m_hop(std::max<size_t>(1, (hop + m_decimation / 2) / m_decimation))
+  , m_historyRe(size)
+  , m_historyIm(size)
+  , m_fft(FftBackendRegistry::create(size))
+  , m_frameRe(size)
+  , m_frameIm(size)
+  , m_spectrumRe(size / 2 + 1)
+  , m_spectrumIm(size / 2 + 1)
+{
+    const auto pi = std::acos(-1.0);
+    const auto clampedBand = clampBand(sampleRate, band);
+    KASSERT(!clampedBand.isEmpty(), "Frequency band must not be empty");
+
+    // Mix the centre of the band down to 0 Hz
+    m_centreFrequency =
+      ((double)clampedBand.MinFrequency + (double)clampedBand.MaxFrequency) /
+      2.0;
+    m_rotationRe = std::cos(2.0 * pi * m_centreFrequency / sampleRate);
+    m_rotationIm = -std::sin(2.0 * pi * m_centreFrequency / sampleRate);
+
+    // Bins within the band, in terms of the shifted transform, i.e. with
+    // shifted bin size / 2 at the centre frequency
+    m_resolution = sampleRate / (double)(m_decimation * size);
+    const auto halfSize = (double)(size / 2);
+    const auto first = std::ceil(
+      ((double)clampedBand.MinFrequency - m_centreFrequency) / m_resolution +
+      halfSize);
+    const auto last = std::floor(
+      ((double)clampedBand.MaxFrequency - m_centreFrequency) / m_resolution +
+      halfSize);
+    m_firstBin = (size_t)std::clamp(first, 0.0, (double)(size - 1));
+    m_numBins =
+      (size_t)std::clamp(last, (double)m_firstBin, (double)(size - 1)) + 1 -
+      m_firstBin;
+    m_magnitudes.resize(m_numBins);
+
+    // Blackman windowed sinc low-pass, with the cutoff halfway between the
+    // edge of the band and the decimated Nyquist frequency
+    if (m_decimation == 1) {
+        m_taps.assign(1, 1.0f);
+    } else {
+        const auto numTaps = k_tapsPerDecimation * m_decimation + 1;
+        const auto cutoff =
+          ((double)clampedBand.getWidth() / 2.0 +
+           sampleRate / (double)(m_decimation * 2)) /
+          (2.0 * sampleRate);
+        const auto centre = (double)(numTaps - 1) / 2.0;
+
+        std::vector<double> taps(numTaps);
+        auto sum = 0.0;
+        for (size_t i = 0; i < numTaps; ++i) {
+            const auto x = (double)i - centre;
+            const auto sinc = x == 0.0
+                                ? 2.0 * cutoff
+                                : std::sin(2.0 * pi * cutoff * x) / (pi * x);
+            const auto phase = 2.0 * pi * (double)i / (double)(numTaps - 1);
+            const auto window =
+              0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+            taps[i] = sinc * window;
+            sum += taps[i];
+        }
+
+        // Unity gain at DC, i.e. at the centre of the band
+        m_taps.resize(numTaps);
+        for (size_t i = 0; i < numTaps; ++i) {
+            m_taps[i] = (float)(taps[i] / sum);
+        }
+    }
+    m_mixedRe.resize(2 * m_taps.size());
+    m_mixedIm.resize(2 * m_taps.size());
+
+    // Periodic Hann window, on the same scale as Stft
+    m_window = TableCache::getWindow(Window::WindowHann, size);
+}
+
+void
+ZoomFft::reset() noexcept
+{
+    m_oscillatorRe = 1.0;
+    m_oscillatorIm = 0.0;
+    m_samplesSinceNormalization = 0;
+
+    std::fill(m_mixedRe.begin(), m_mixedRe.end(), 0.0f);
+    std::fill(m_mixedIm.begin(), m_mixedIm.end(), 0.0f);
+    m_mixedIndex = 0;
+
+    std::fill(m_historyRe.begin(), m_historyRe.end(), 0.0f);
+    std::fill(m_historyIm.begin(), m_historyIm.end(), 0.0f);
+    m_historyIndex = 0;
+
+    m_phase = 0;
+    m_samplesSinceFrame = 0;
+}
+
+auto
+ZoomFft::getBinFrequency(size_t bin) const noexcept -> double
+{
+    return m_centreFrequency +
+           ((double)(m_firstBin + bin) - (double)(m_size / 2)) * m_resolution;
+}
+
+void
+ZoomFft::process(gsl::span<const float> samples,
+                 const FrameHandler& handler) noexcept
+{
+    const auto numTaps = m_taps.size();
+    const auto* taps = m_taps.data();
+
+    for (const auto sample : samples) {
+        // Mix down
+        const auto re = (double)sample * m_oscillatorRe;
+        const auto im = (double)sample * m_oscillatorIm;
+        m_mixedRe[m_mixedIndex] = m_mixedRe[m_mixedIndex + numTaps] = (float)re;
+        m_mixedIm[m_mixedIndex] = m_mixedIm[m_mixedIndex + numTaps] = (float)im;
+        m_mixedIndex = m_mixedIndex + 1 == numTaps ? 0 : m_mixedIndex + 1;
+
+        const auto oscillatorRe =
+          m_oscillatorRe * m_rotationRe - m_oscillatorIm * m_rotationIm;
+        m_oscillatorIm =
+          m_oscillatorRe * m_rotationIm + m_oscillatorIm * m_rotationRe;
+        m_oscillatorRe = oscillatorRe;
+
+        if (++m_samplesSinceNormalization == k_normalizationInterval) {
+            const auto scale = 1.0 / std::hypot(m_oscillatorRe, m_oscillatorIm);
+            m_oscillatorRe *= scale;
+            m_oscillatorIm *= scale;
+            m_samplesSinceNormalization = 0;
+        }
+
+        // Filter only at the decimated sample instants
+        if (++m_phase < m_decimation) {
+            continue;
+        }
+        m_phase = 0;
+
+        const auto* mixedRe = m_mixedRe.data() + m_mixedIndex;
+        const auto* mixedIm = m_mixedIm.data() + m_mixedIndex;
+        auto filteredRe = 0.0f;
+        auto filteredIm = 0.0f;
+        for (size_t i = 0; i < numTaps; ++i) {
+            filteredRe += taps[i] * mixedRe[i];
+            filteredIm += taps[i] * mixedIm[i];
+        }
+
+        m_historyRe[m_historyIndex] = filteredRe;
+        m_historyIm[m_historyIndex] = filteredIm;
+        m_historyIndex = (m_historyIndex + 1) & (m_size - 1);
+
+        if (++m_samplesSinceFrame == m_hop) {
+            m_samplesSinceFrame = 0;
+            processFrame(handler);
+        }
+    }
+}
+
+void
+ZoomFft::processFrame(const FrameHandler& handler) noexcept
+{
+    // Linearize and window the history, oldest sample first
+    const auto* window = m_window->data();
+    for (size_t i = 0; i < m_size; ++i) {
+        const auto j = (m_historyIndex + i) & (m_size - 1);
+        m_frameRe[i] = m_historyRe[j] * window[i];
+        m_frameIm[i] = m_historyIm[j] * window[i];
+    }
+
+    // Complex transform from two real transforms: Z_k = A_k + i B_k, with the
+    // upper half of A and B following from conjugate symmetry
+    m_fft->forward(m_frameRe.data(), m_spectrumRe.data());
+    m_fft->forward(m_frameIm.data(), m_spectrumIm.data());
+
+    const auto halfSize = m_size / 2;
+    for (size_t b = 0; b < m_numBins; ++b) {
+        // Undo the shift, so the centre frequency maps to transform bin 0
+        const auto k = (m_firstBin + b + halfSize) & (m_size - 1);
+        const auto upper = k > halfSize;
+        const auto a = upper ? std::conj(m_spectrumRe[m_size - k])
+                             : m_spectrumRe[k];
+        const auto c = upper ? std::conj(m_spectrumIm[m_size - k])
+                             : m_spectrumIm[k];
+        const auto bin = std::complex<float>(a.real() - c.imag(),
+                                             a.imag() + c.real());
+        m_magnitudes[b] = std::sqrt(std::norm(bin));
+    }
+
+    handler(m_magnitudes);
+}
+
+} // namespace spectrex
@@ -0,0 +1,173 @@
+#include <Spectrex/AnalysisScheduler.hpp>
+
+// Stdlib
+#include <algorithm>
+
+namespace spectrex {
+
+std::atomic<int> AnalysisScheduler::s_numWorkers = 0;
+
+AnalysisScheduler::Worker::Worker(AnalysisScheduler& owner, size_t index)
+  : juce::Thread("analysis " + juce::String((int)index))
+  , m_owner(owner)
+  , m_index(index)
+{
+}
+
+AnalysisScheduler::Worker::~Worker()
+{
+    // Attempt to stop the worker, wake it up so it does not have to run into
+    // its timeout first
+    // Take a reasonably large timeout that takes the normal wakeup timeout
+    // into account
+    signalThreadShouldExit();
+    m_owner.notify();
+    stopThread(k_workerTimeoutMs * 10);
+}
+
+/// @thread worker
+void
+AnalysisScheduler::Worker::run()
+{
+    size_t turn = 0;
+
+    while (!threadShouldExit()) {
+        // Look for work in the own queue first, and steal work from the
+        // queues of other workers otherwise. Only the queue being looked at
+        // is locked, so the lock of another worker is only taken to steal.
+        AnalysisTask* task = nullptr;
+        const auto numQueues = m_owner.m_queues.size();
+        for (size_t i = 0; task == nullptr && i < numQueues; ++i) {
+            task =
+              acquireTask(*m_owner.m_queues[(m_index + i) % numQueues], turn);
+        }
+
+        if (task == nullptr) {
+            // Wait for next wakeup or timeout
+            m_owner.m_wakeupEvent.wait(k_workerTimeoutMs);
+            continue;
+        }
+
+        // A wakeup only wakes a single worker, whereas any number of tasks
+        // may have become pending at once. Pass the wakeup on before
+        // processing, so the next worker looks for another task while this one
+        // is busy, until a worker finds none.
+        m_owner.notify();
+
+        // Process a single turn of the task, and move on to the next task
+        task->processPendingBlocks(k_maxBlocksPerTurn);
+        task->m_busy.clear(std::memory_order_release);
+        ++turn;
+    }
+}
+
+auto
+AnalysisScheduler::acquireTask(Queue& queue, size_t offset) noexcept
+  -> AnalysisTask*
+{
+    std::lock_guard<std::mutex> lock{ queue.Mutex };
+
+    const auto& tasks = queue.Tasks;
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        AnalysisTask* task = tasks[(offset + i) % tasks.size()];
+
+        if (task->m_busy.test_and_set(std::memory_order_acquire)) {
+            // Already being processed by another worker
+            continue;
+        }
+
+        if (task->hasPendingBlocks()) {
+            return task;
+        }
+
+        task->m_busy.clear(std::memory_order_release);
+    }
+
+    return nullptr;
+}
+
+auto
+AnalysisScheduler::getInstance() -> std::shared_ptr<AnalysisScheduler>
+{
+    static std::mutex mutex;
+    static std::weak_ptr<AnalysisScheduler> instance;
+
+    std::lock_guard<std::mutex> lock{ mutex };
+
+    auto ret = instance.lock();
+    if (ret == nullptr) {
+        auto numWorkers = s_numWorkers.load();
+        if (numWorkers <= 0) {
+            numWorkers = std::max(1,
+                                  juce::SystemStats::getNumPhysicalCpus() -
+                                    k_numReservedAudioThreads);
+        }
+
+        ret = std::shared_ptr<AnalysisScheduler>(
+          new AnalysisScheduler(numWorkers));
+        instance = ret;
+    }
+
+    return ret;
+}
+
+void
+AnalysisScheduler::setNumWorkers(int numWorkers) noexcept
+{
+    s_numWorkers = std::max(0, numWorkers);
+}
+
+void
+AnalysisScheduler::addTask(AnalysisTask& task)
+{
+    // Spread tasks evenly across the worker queues
+    auto& queue = *m_queues[m_nextQueue++ % m_queues.size()];
+
+    std::lock_guard<std::mutex> lock{ queue.Mutex };
+    queue.Tasks.push_back(&task);
+}
+
+void
+AnalysisScheduler::removeTask(AnalysisTask& task)
+{
+    for (auto& queue : m_queues) {
+        std::lock_guard<std::mutex> lock{ queue->Mutex };
+
+        auto& tasks = queue->Tasks;
+        tasks.erase(std::remove(tasks.begin(), tasks.end(), &task),
+                    tasks.end());
+    }
+
+    // No worker can acquire the task anymore, wait for any worker that is
+    // still processing it
+    while (task.m_busy.test_and_set(std::memory_order_acquire)) {
+        juce::Thread::yield();
+    }
+    task.m_busy.clear(std::memory_order_release);
+}
+
+AnalysisScheduler::AnalysisScheduler(int numWorkers)
+{
+    for (int i = 0; i < numWorkers; ++i) {
+        m_queues.push_back(std::make_unique<Queue>());
+    }
+
+    // Start the workers with high priority, their number is bounded so they
+    // leave room for the audio threads of the host
+    for (int i = 0; i < numWorkers; ++i) {
+        m_workers.push_back(std::make_unique<Worker>(*this, (size_t)i));
+        m_workers.back()->startThread(juce::Thread::Priority::high);
+    }
+}
+
+AnalysisScheduler::~AnalysisScheduler()
+{
+    // Signal all workers first, so that any wakeup is never lost on a worker
+    // that still has to be stopped
+    for (auto& worker : m_workers) {
+        worker->signalThreadShouldExit();
+    }
+    m_workers.clear();
+}
+
+} // namespace spectrex
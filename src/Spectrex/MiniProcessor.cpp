@@ -9,6 +9,11 @@
 #undef TEST_GENERATE_CHIRP
 #undef TEST_GENERATE_BEEP
 
+#if defined(TEST_GENERATE_CLEAR) || defined(TEST_GENERATE_WHITE_NOISE) ||     \
+  defined(TEST_GENERATE_CHIRP) || defined(TEST_GENERATE_BEEP)
+#define TEST_GENERATE_ANY
+#endif
+
 namespace spectrex {
 
 MiniProcessor::ProcessingThread::ProcessingThread(MiniProcessor& owner)
@@ -19,9 +24,12 @@ MiniProcessor::ProcessingThread::ProcessingThread(MiniProcessor& owner)
 
 MiniProcessor::ProcessingThread::~ProcessingThread()
 {
-    // Attempt to stop the processing thread
-    // Take a reasonably large timeout that takes the normal notify timeout into
-    // account
+    // Attempt to stop the processing thread, wake it up so it does not have to
+    // run into its timeout first
+    // Take a reasonably large timeout that takes the normal wakeup timeout
+    // into account
+    signalThreadShouldExit();
+    m_owner.m_wakeupEvent.notify();
     stopThread(k_processingThreadTimeoutMs * 10);
 }
 
@@ -29,157 +37,1034 @@ MiniProcessor::ProcessingThread::~ProcessingThread()
 void
 MiniProcessor::ProcessingThread::run()
 {
-    // Work buffers
+    // Processing loop
+    while (!threadShouldExit()) {
+        for (auto& channelGroup : m_owner.m_channelGroups) {
+            channelGroup->processPendingBlocks(
+              std::numeric_limits<int>::max());
+        }
+
+        // Wait for next wakeup or timeout
+        m_owner.m_wakeupEvent.wait(k_processingThreadTimeoutMs);
+    }
+}
+
+MiniProcessor::ChannelGroup::ChannelGroup(MiniProcessor& owner, size_t index)
+  : m_owner(owner)
+  , m_index(index)
+{
+    // Instantiate audio processor
+    m_processor = std::make_unique<spectrex::KProcessor>();
+
+    // Configuration
+    m_processor->setParameter(spectrex::ProcessorParameters::Key::FtSize,
+                              spectrex::FtSize::Size256);
+
+    // Initialize audio transport
     constexpr auto subBlockSize = KProcessor::getExpectedBlockSize();
-    std::array<SyncData, subBlockSize> syncDataBlock;
-    std::array<std::array<float, subBlockSize>, 2> audioSubBlocks;
-    std::array<juce::MidiMessage, subBlockSize> midiSubBlock;
+    for (auto& audioRingBuffer : m_audioRingBuffers) {
+        audioRingBuffer = std::make_unique<SpscRingBuffer<float>>(
+          subBlockSize * k_ringBufferElements, 0.0f);
+    }
+    m_blockRingBuffer = std::make_unique<SpscRingBuffer<BlockData>>(
+      k_ringBufferElements, BlockData{});
 
-    // State
-    double lastPpq = k_PpqInitialState;
+    for (auto& backlog : m_sideAnalysisBacklog) {
+        backlog.resize(k_sideAnalysisBacklogSize);
+    }
+}
 
-    // Processing loop
-    while (!threadShouldExit()) {
-        // Check if there is any data available at all
-        if (m_owner.m_numChannels > 0 &&
-            m_owner.m_ringBuffer->getReadSpace() > 0) {
-            // Avoid floating point denormals
-            juce::ScopedNoDenormals scopedNoDenormals;
-
-            // Ensure processor is prepared
-            {
-                float totalNumSamples = -1.0f;
-
-                // If the processor could not prepare (initialize), handle this
-                // gracefully and ignore all processing
-                if (!m_owner.m_processor->prepare(totalNumSamples)) {
-                    continue;
+/// @thread processing
+auto
+MiniProcessor::ChannelGroup::hasPendingBlocks() noexcept -> bool
+{
+    return m_blockRingBuffer->getReadSpace() > 0;
+}
+
+/// @thread processing
+auto
+MiniProcessor::ChannelGroup::processPendingBlocks(int maxBlocks) noexcept
+  -> int
+{
+    // Work buffers, only used whenever a sub-block wraps around the end of a
+    // channel lane
+    constexpr auto subBlockSize = KProcessor::getExpectedBlockSize();
+    std::array<std::array<float, subBlockSize>, k_numGroupChannels>
+      audioSubBlocks;
+    std::array<AudioChannelView, k_numGroupChannels> audioViews;
+    std::array<bool, k_numGroupChannels> audioViewsInPlace;
+
+    // Check if there is any data available at all
+    if (!hasPendingBlocks()) {
+        return 0;
+    }
+
+    // The host no longer feeds this group, drain the blocks it published
+    // before, so they are not analyzed as stale data once it is fed again
+    if (m_numChannels == 0) {
+        m_skippingProcessor = true;
+        m_skippingSideAnalyses = true;
+        return skipPendingBlocks(maxBlocks);
+    }
+
+    // Consumption of the processor and the side analyses is tracked
+    // separately, so reading only the side analyses does not keep the
+    // processor analyzing. Once neither is consumed, drain the transport
+    // without analyzing it. The loudness meter measures the entire program,
+    // so it is still fed if enabled.
+    const auto isActive =
+      m_owner.isAnalysisActive(AnalysisKind::Processors);
+    const auto areSideAnalysesActive =
+      m_owner.isAnalysisActive(AnalysisKind::SideAnalyses);
+    m_skippingProcessor |= !isActive;
+    m_skippingSideAnalyses |= !areSideAnalysesActive;
+    if (!isActive && !areSideAnalysesActive &&
+        !m_owner.m_loudnessMeterEnabled) {
+        return skipPendingBlocks(maxBlocks);
+    }
+
+    // An analysis became active again after skipping data, so it continues
+    // with cleared histories from the current host position
+    if (isActive && m_skippingProcessor) {
+        m_skippingProcessor = false;
+        m_needsPreparation = true;
+        m_processor->resetPosition();
+        m_lastPpq = k_PpqInitialState;
+    }
+    if (areSideAnalysesActive && m_skippingSideAnalyses) {
+        m_skippingSideAnalyses = false;
+        resetSideAnalyses();
+    }
+
+    // Avoid floating point denormals
+    juce::ScopedNoDenormals scopedNoDenormals;
+
+    // Ensure processor is prepared
+    if (isActive) {
+        if (m_needsPreparation) {
+            m_needsPreparation = false;
+            if (!reprepareProcessor()) {
+                DBG("The processor histories could not be cleared");
+            }
+        }
+
+        float totalNumSamples = -1.0f;
+
+        // If the processor could not prepare (initialize), handle this
+        // gracefully and ignore all processing
+        if (!m_processor->prepare(totalNumSamples)) {
+            return 0;
+        }
+    }
+
+    // Get playhead information, the audio thread never waits for this read
+    //
+    // @thread data may not be fully synced up with ringbuffer
+    //
+    // Do not use critical variables from playhead (ppqPosition*), use
+    // BlockData instead.
+    bool isPlaying =
+      true; // If there is no playhead, we should always just play
+    float bpm = 0.0f;
+    int timeSigNumerator = 0;
+    {
+        /// @thread audio
+        /// @thread processing
+        const auto transportState = m_owner.m_transportState.load();
+        if (transportState.valid) {
+            isPlaying = transportState.isPlaying;
+            bpm = (float)transportState.bpm;
+            timeSigNumerator = transportState.timeSigNumerator;
+        }
+    }
+
+    // Set non-critical playhead related variables on processor, if any
+    if (bpm > 0.0f) {
+        // Set the DAW BPM
+        m_processor->setParameter<float>(ProcessorParameters::Key::Bpm, bpm);
+    }
+    if (timeSigNumerator > 0) {
+        m_processor->setParameter<int>(
+          ProcessorParameters::Key::TimeSignatureNumerator, timeSigNumerator);
+    }
+
+    // Maximum number of sub-blocks processed as a single batch
+    const auto maxBatchBlocks =
+      (int)(m_owner.m_processingBlockSize.load() / subBlockSize);
+
+    // Every published BlockData entry guarantees a complete sub-block inside
+    // each channel lane, so read until the metadata lane is drained (or the
+    // maximum number of blocks is reached) and perform sub-block processing.
+    //
+    // Sub-blocks are gathered into batches of consecutive sub-blocks that
+    // share their host position and channel layout. A sub-block carrying a
+    // note on resets the play position, after which the host position is
+    // applied anew, so it always starts a batch of its own. All bookkeeping is
+    // done once per batch, whereas the processor is still fed sub-block by
+    // sub-block, so the analysis is identical to processing one sub-block at
+    // a time.
+    /// @thread m_blockRingBuffer read from processing thread (consumer)
+    /// @thread m_audioRingBuffers read from processing thread (consumer)
+    int numBlocks = 0;
+    while (numBlocks < maxBlocks) {
+        const auto blockRegion = m_blockRingBuffer->peekContiguous(
+          (size_t)std::min(maxBatchBlocks, maxBlocks - numBlocks));
+        const auto blocks = blockRegion.First;
+        if (blocks.empty()) {
+            break;
+        }
+
+        const auto& firstBlock = blocks[0];
+        size_t batchBlocks = 1;
+        while (batchBlocks < blocks.size() &&
+               blocks[batchBlocks].noteOnMask == 0 &&
+               blocks[batchBlocks].numChannels == firstBlock.numChannels &&
+               blocks[batchBlocks].ppqPosition == firstBlock.ppqPosition &&
+               blocks[batchBlocks].ppqLoopEnd == firstBlock.ppqLoopEnd) {
+            ++batchBlocks;
+        }
+
+        // Process data in place inside the channel lanes. Lanes hold a
+        // multiple of the sub-block size and are consumed in sub-blocks, so a
+        // sub-block is expected to be contiguous. The batch ends wherever a
+        // lane wraps around.
+        std::array<gsl::span<const float>, k_numGroupChannels> laneViews;
+        for (int c = 0; c < (int)firstBlock.numChannels; ++c) {
+            laneViews[c] =
+              m_audioRingBuffers[c]
+                ->peekContiguous(batchBlocks * subBlockSize)
+                .First;
+            audioViewsInPlace[c] = laneViews[c].size() >= subBlockSize;
+            batchBlocks = std::max<size_t>(
+              1, std::min(batchBlocks, laneViews[c].size() / subBlockSize));
+        }
+
+        updateAnalysisLatency(firstBlock.publishTicks);
+
+        for (size_t b = 0; b < batchBlocks; ++b) {
+            // Lanes the block does not have data for (mono) mirror the first
+            // lane
+            for (int c = 0; c < k_numGroupChannels; ++c) {
+                if (c >= (int)firstBlock.numChannels) {
+                    audioViews[c] = audioViews[0];
+                } else if (audioViewsInPlace[c]) {
+                    audioViews[c] =
+                      laneViews[c].subspan(b * subBlockSize, subBlockSize);
+                } else {
+                    m_audioRingBuffers[c]->read(audioSubBlocks[c].data(),
+                                                subBlockSize);
+                    audioViews[c] = audioSubBlocks[c];
                 }
             }
 
-            // Get playhead information using a brief lock for a copy only
-            //
-            // @thread data may not be fully synced up with ringbuffer
-            //
-            // Do not use critical variables from playhead (ppqPosition*), use
-            // SyncData instead.
-            bool isPlaying =
-              true; // If there is no playhead, we should always just play
-            float bpm = 0.0f;
-            int timeSigNumerator = 0;
-            {
-                /// @thread audio
-                /// @thread processing
-                std::scoped_lock<std::mutex> lock{ m_owner.m_playheadMutex };
-                juce::AudioPlayHead::CurrentPositionInfo info =
-                  m_owner.m_playhead;
-                if (m_owner.m_playheadValid) {
-                    isPlaying = info.isPlaying;
-                    bpm = info.bpm;
-                    timeSigNumerator = info.timeSigNumerator;
+            if (isActive && b == 0) {
+                // Reset the play position on any note on/off event, we check
+                // the entire block here so there can be a really minor offset
+                if (firstBlock.noteOnMask != 0) {
+                    m_processor->resetPosition();
                 }
+
+                // The host position is shared by the entire batch
+                updatePosition(firstBlock, isPlaying);
             }
 
-            // Set non-critical playhead related variables on processor, if any
-            if (bpm > 0.0f) {
-                // Set the DAW BPM
-                m_owner.m_processor->setParameter<float>(
-                  ProcessorParameters::Key::Bpm, bpm);
+            // Perform processing of sub-blocks
+            if (isActive) {
+                m_processor->process(
+                  audioViews[0], audioViews[1], k_numGroupChannels);
             }
-            if (timeSigNumerator > 0) {
-                m_owner.m_processor->setParameter<int>(
-                  ProcessorParameters::Key::TimeSignatureNumerator,
-                  timeSigNumerator);
+        }
+
+        // The side analyses take batches of any size, so they are fed the
+        // entire batch at once. A batch that is not in place is a single
+        // sub-block.
+        std::array<AudioChannelView, k_numGroupChannels> batchViews;
+        for (int c = 0; c < k_numGroupChannels; ++c) {
+            if (c >= (int)firstBlock.numChannels) {
+                batchViews[c] = batchViews[0];
+            } else if (audioViewsInPlace[c]) {
+                batchViews[c] =
+                  laneViews[c].first(batchBlocks * subBlockSize);
+            } else {
+                batchViews[c] = audioSubBlocks[c];
             }
+        }
+        processSideAnalyses(
+          batchViews, (int)firstBlock.numChannels, areSideAnalysesActive);
+
+        const auto numBatchSamples = (uint64_t)(batchBlocks * subBlockSize);
+        if (isActive) {
+            m_numAnalyzedSamples += numBatchSamples;
+        } else {
+            m_numSkippedSamples += numBatchSamples;
+        }
 
-            // If we have enough data inside our read space to read a sub-block
-            // per channel, do so and perform sub-block processing
-            /// @thread m_audioRingBuffer read from processing thread (consumer)
-            /// @thread m_midiRingBuffer read from processing thread (consumer)
-            while (m_owner.m_ringBuffer->getReadSpace() >= subBlockSize) {
-                // Read data from ring buffer
-                m_owner.m_ringBuffer->read(syncDataBlock.data(), subBlockSize);
-
-                // Unpack into individual buffers
-                for (int i = 0; i < subBlockSize; ++i) {
-                    const SyncData& s = syncDataBlock[i];
-                    audioSubBlocks[0][i] = s.left;
-                    audioSubBlocks[1][i] = s.right;
-
-                    // Reset the play position on any note on/off event, we
-                    // check the entire block here so there can be a really
-                    // minor offset
-                    if (s.noteOn) {
-                        m_owner.m_processor->resetPosition();
-                    }
-                }
+        // Hand the processed storage back to the audio thread
+        for (int c = 0; c < (int)firstBlock.numChannels; ++c) {
+            if (audioViewsInPlace[c]) {
+                m_audioRingBuffers[c]->commitRead(batchBlocks * subBlockSize);
+            }
+        }
+        m_blockRingBuffer->commitRead(batchBlocks);
 
-                // Get ppqPosition from the last sample, since it is only done
-                // on a block basis, it will usually be the same throughout
-                // (though not guaranteed to be). The last sample will be the
-                // most recent sample.
-                {
-                    double ppqPosition =
-                      syncDataBlock[subBlockSize - 1].ppqPosition;
-                    double ppqLoopEnd =
-                      syncDataBlock[subBlockSize - 1]
-                        .ppqLoopEnd; // Use infinite to encode no loop
-
-                    if (isPlaying) {
-                        m_owner.m_lastTimeInQuarters.store(ppqPosition);
-                    }
+        numBlocks += (int)batchBlocks;
+    }
 
-                    // Modulate ppq position according to loop, if
-                    // information is available. This avoids some DAWs
-                    // letting ppqPosition go beyond ppqLoopEnd, causing
-                    // samples to be visualized beyond the loop point.
-                    ppqPosition = isfinite(ppqLoopEnd) && ppqLoopEnd > 0
-                                    ? (fmod(ppqPosition, ppqLoopEnd))
-                                    : ppqPosition;
-
-                    // Resync condition, any of the following:
-                    // * PPQ delta exceeds threshold
-                    // * PPQ jumped back in time
-                    // * Processor was initialized (lastPpq is initial
-                    // state)
-                    // * Processor was initialized (isInitialPosition())
-                    const auto ppqDelta = abs(lastPpq - ppqPosition);
-                    bool ppqResync = (ppqDelta > k_resyncPpqThreshold) ||
-                                     (ppqPosition < lastPpq) ||
-                                     (lastPpq == k_PpqInitialState) ||
-                                     m_owner.m_processor->isInitialPosition();
-
-                    // Always force position resync to zero when in pre-roll
-                    // (ppq is negative), so it always starts at the right
-                    // point when the ppq becomes positive.
-                    if (ppqPosition < 0) {
-                        ppqPosition = 0;
-                        ppqResync = true;
-                    }
+    return numBlocks;
+}
 
-                    // Stores absolute ppq for GUI purposes, performs no
-                    // syncronization of data
-                    m_owner.m_processor->setAbsolutePosition(ppqPosition);
-
-                    // Set is playing state and update play position
-                    // according to PPQ information either if we start
-                    // playing, or the PPQ delta is greater than the resync
-                    // threshold (in PPQ)
-                    if (m_owner.m_processor->setPlaying(isPlaying) ||
-                        (isPlaying && ppqResync)) {
-                        m_owner.m_processor->setPosition(ppqPosition);
-                    }
-                    lastPpq = ppqPosition;
+/// @thread processing
+void
+MiniProcessor::ChannelGroup::processSideAnalyses(
+  const std::array<AudioChannelView, k_numGroupChannels>& views,
+  int numChannels,
+  bool isActive) noexcept
+{
+    std::unique_lock<std::mutex> lock{ m_sideAnalysisMutex, std::try_to_lock };
+
+    // A consumer holds the lock, e.g. while its synchronization handler runs.
+    // Rather than waiting for it, keep the samples for the next batch, as
+    // long as they fit and have been processed alike.
+    if (!lock.owns_lock()) {
+        const auto numSamples = views[0].size();
+        const auto fits =
+          m_sideAnalysisBacklogSize + numSamples <= k_sideAnalysisBacklogSize &&
+          (m_sideAnalysisBacklogSize == 0 ||
+           (m_sideAnalysisBacklogChannels == numChannels &&
+            m_sideAnalysisBacklogActive == isActive));
+        if (fits) {
+            for (int c = 0; c < std::max(numChannels, 1); ++c) {
+                std::copy(views[c].begin(),
+                          views[c].end(),
+                          m_sideAnalysisBacklog[c].begin() +
+                            (std::ptrdiff_t)m_sideAnalysisBacklogSize);
+            }
+            m_sideAnalysisBacklogSize += numSamples;
+            m_sideAnalysisBacklogChannels = numChannels;
+            m_sideAnalysisBacklogActive = isActive;
+            return;
+        }
+        lock.lock();
+    }
+
+    flushSideAnalysisBacklog();
+    feedSideAnalyses(views, numChannels, isActive);
+}
+
+/// @thread processing
+void
+MiniProcessor::ChannelGroup::flushSideAnalysisBacklog() noexcept
+{
+    if (m_sideAnalysisBacklogSize == 0) {
+        return;
+    }
+
+    // A single channel is mirrored
+    std::array<AudioChannelView, k_numGroupChannels> views;
+    for (int c = 0; c < k_numGroupChannels; ++c) {
+        views[c] = c < std::max(m_sideAnalysisBacklogChannels, 1)
+                     ? AudioChannelView(m_sideAnalysisBacklog[c].data(),
+                                        m_sideAnalysisBacklogSize)
+                     : views[0];
+    }
+    feedSideAnalyses(
+      views, m_sideAnalysisBacklogChannels, m_sideAnalysisBacklogActive);
+    m_sideAnalysisBacklogSize = 0;
+}
+
+/// @thread processing
+void
+MiniProcessor::ChannelGroup::feedSideAnalyses(
+  const std::array<AudioChannelView, k_numGroupChannels>& views,
+  int numChannels,
+  bool isActive) noexcept
+{
+    for (int c = 0; c < k_numGroupChannels; ++c) {
+        if (isActive && m_waveformPyramids[c] != nullptr) {
+            m_waveformPyramids[c]->process(views[c]);
+        }
+    }
+
+    // A mirrored channel would be measured twice
+    if (m_loudnessMeter != nullptr) {
+        const auto numMeasured = std::clamp(numChannels, 1, k_numGroupChannels);
+        m_loudnessMeter->process(
+          gsl::span<const AudioChannelView>(views.data(), (size_t)numMeasured));
+    }
+
+    // A mono group mirrors its channel, which shows as a vertical line
+    if (isActive && m_vectorscope != nullptr) {
+        m_vectorscope->process(views[0], views[1]);
+    }
+}
+
+/// @thread processing
+void
+MiniProcessor::ChannelGroup::resetSideAnalyses() noexcept
+{
+    std::lock_guard<std::mutex> lock{ m_sideAnalysisMutex };
+
+    flushSideAnalysisBacklog();
+
+    // The loudness meter keeps measuring while the analysis is inactive
+    for (auto& waveformPyramid : m_waveformPyramids) {
+        if (waveformPyramid != nullptr) {
+            waveformPyramid->reset();
+        }
+    }
+    if (m_vectorscope != nullptr) {
+        m_vectorscope->reset();
+    }
+}
+
+/// @thread processing
+auto
+MiniProcessor::ChannelGroup::skipPendingBlocks(int maxBlocks) noexcept -> int
+{
+    constexpr auto subBlockSize = KProcessor::getExpectedBlockSize();
+
+    // Blocks only hold samples in the lanes of their channels
+    const auto blockRegion =
+      m_blockRingBuffer->peekContiguous((size_t)maxBlocks);
+    std::array<size_t, k_numGroupChannels> numLaneSamples{};
+    const auto countSamples = [&](gsl::span<const BlockData> blocks) {
+        for (const auto& block : blocks) {
+            for (int c = 0; c < (int)block.numChannels; ++c) {
+                numLaneSamples[c] += subBlockSize;
+            }
+        }
+    };
+    countSamples(blockRegion.First);
+    if (blockRegion.Second) {
+        countSamples(*blockRegion.Second);
+    }
+    const auto numBlocks = blockRegion.size();
+
+    for (int c = 0; c < k_numGroupChannels; ++c) {
+        if (numLaneSamples[c] > 0) {
+            auto& lane = *m_audioRingBuffers[c];
+            lane.commitRead(lane.peekContiguous(numLaneSamples[c]).size());
+        }
+    }
+    m_blockRingBuffer->commitRead(numBlocks);
+    m_numSkippedSamples += (uint64_t)(numBlocks * subBlockSize);
+
+    return (int)numBlocks;
+}
+
+/// @thread processing
+auto
+MiniProcessor::ChannelGroup::reprepareProcessor() noexcept -> bool
+{
+    std::lock_guard<std::mutex> lock{ m_owner.m_preparationMutex };
+
+    // Not prepared by the host yet, so there are no histories to clear
+    const auto sampleRate = (float)m_owner.m_sampleRate.load();
+    if (!(sampleRate > 0.0f)) {
+        return false;
+    }
+
+    // KProcessor has no call to clear its histories, it only clears them when
+    // it is prepared after a parameter that requires preparation changed (see
+    // KProcessor::prepare). So the sample rate is changed to half the sample
+    // rate of the owner and then set to it, which the host cannot interleave
+    // with while this holds the preparation lock. A refused change leaves the
+    // processor valid, with its histories, which is reported rather than
+    // assumed.
+    m_processor->setParameter<float>(ProcessorParameters::Key::SampleRate,
+                                     0.5f * sampleRate);
+    m_processor->setParameter<float>(ProcessorParameters::Key::SampleRate,
+                                     sampleRate);
+    const auto cleared = !m_processor->isValid();
+
+    float totalNumSamples = -1.0f;
+    m_processor->prepare(totalNumSamples);
+
+    return cleared;
+}
+
+/// @thread processing
+void
+MiniProcessor::ChannelGroup::updatePosition(const BlockData& block,
+                                            bool isPlaying) noexcept
+{
+    // Get ppqPosition of the most recent sample in the block, since it is
+    // only done on a host block basis, it will usually be the same
+    // throughout (though not guaranteed to be).
+    double ppqPosition = block.ppqPosition;
+    double ppqLoopEnd = block.ppqLoopEnd; // Use infinite to encode no loop
+
+    // All channel groups share the host position, so only the first
+    // one reports it
+    if (isPlaying && m_index == 0) {
+        m_owner.m_lastTimeInQuarters.store(ppqPosition);
+    }
+
+    // Modulate ppq position according to loop, if information is
+    // available. This avoids some DAWs letting ppqPosition go beyond
+    // ppqLoopEnd, causing samples to be visualized beyond the loop
+    // point.
+    ppqPosition = isfinite(ppqLoopEnd) && ppqLoopEnd > 0
+                    ? (fmod(ppqPosition, ppqLoopEnd))
+                    : ppqPosition;
+
+    // Resync condition, any of the following:
+    // * PPQ delta exceeds threshold
+    // * PPQ jumped back in time
+    // * Processor was initialized (lastPpq is initial state)
+    // * Processor was initialized (isInitialPosition())
+    const auto ppqDelta = abs(m_lastPpq - ppqPosition);
+    bool ppqResync = (ppqDelta > k_resyncPpqThreshold) ||
+                     (ppqPosition < m_lastPpq) ||
+                     (m_lastPpq == k_PpqInitialState) ||
+                     m_processor->isInitialPosition();
+
+    // Always force position resync to zero when in pre-roll (ppq is
+    // negative), so it always starts at the right point when the ppq
+    // becomes positive.
+    if (ppqPosition < 0) {
+        ppqPosition = 0;
+        ppqResync = true;
+    }
+
+    // Stores absolute ppq for GUI purposes, performs no
+    // syncronization of data
+    m_processor->setAbsolutePosition(ppqPosition);
+
+    // Set is playing state and update play position according to PPQ
+    // information either if we start playing, or the PPQ delta is
+    // greater than the resync threshold (in PPQ)
+    if (m_processor->setPlaying(isPlaying) || (isPlaying && ppqResync)) {
+        m_processor->setPosition(ppqPosition);
+    }
+    m_lastPpq = ppqPosition;
+}
+
+void
+MiniProcessor::wakeUp() noexcept
+{
+    if (m_scheduler != nullptr) {
+        m_scheduler->notify();
+    } else {
+        m_wakeupEvent.notify();
+    }
+}
+
+void
+MiniProcessor::ChannelGroup::updateAnalysisLatency(
+  int64_t publishTicks) noexcept
+{
+    const auto latencyMs = juce::Time::highResolutionTicksToSeconds(
+                             juce::Time::getHighResolutionTicks() -
+                             publishTicks) *
+                           1000.0;
+
+    if (m_latencyResetRequested.exchange(false)) {
+        m_latencyMaximumMs = 0.0;
+    }
+
+    m_latencyAverageMs = m_latencyAverageMs +
+                         (latencyMs - m_latencyAverageMs) * k_latencySmoothing;
+    m_latencyMaximumMs = std::max(m_latencyMaximumMs.load(), latencyMs);
+}
+
+/// @thread audio
+auto
+MiniProcessor::ChannelGroup::write(const float* const* channels,
+                                   int numChannels,
+                                   int numSamples,
+                                   const juce::MidiBuffer& midiMessages,
+                                   bool triggerEnabled,
+                                   const BlockData& blockData) noexcept -> int
+{
+    constexpr auto subBlockSize = KProcessor::getExpectedBlockSize();
+    static_assert(subBlockSize <= 32,
+                  "BlockData::noteOnMask holds one bit per sub-block sample");
+
+    m_numChannels = numChannels;
+    const auto wakeupThreshold = m_owner.m_wakeupThreshold.load();
+
+    // If the processing thread is lagging so far behind that the transport
+    // cannot hold the entire block, drop the block as a whole. This keeps the
+    // channel lanes and the metadata lane aligned.
+    for (int c = 0; c < k_numGroupChannels; ++c) {
+        if (m_audioRingBuffers[c]->getWriteSpace() < (size_t)numSamples) {
+            return -1;
+        }
+    }
+
+    juce::MidiBuffer::Iterator midiIt{ midiMessages };
+
+    // Find first MIDI message, if any
+    juce::MidiMessage message{};
+    int midiSamplePosition = 0;
+    if (!midiIt.getNextEvent(message, midiSamplePosition)) {
+        // No further MIDI messages, invalidate sample position
+        midiSamplePosition = -1;
+    }
+
+    // Perform "sub-block" processing. Instead of processing the length of the
+    // input buffer directly, the input buffer is written into the channel
+    // lanes and broken up into chunks the size of the sub-block size. Any
+    // remaining samples from the input buffer due to the input buffer size not
+    // being divisible by the sub-block size are contained in the channel lanes
+    // and are processed once new data comes in, the metadata of a sub-block is
+    // only published once the sub-block is complete
+    /// @thread m_audioRingBuffers write from audio thread (producer)
+    /// @thread m_blockRingBuffer write from audio thread (producer)
+    int numBlocks = 0;
+    for (int i = 0; i < numSamples;) {
+        const auto n = juce::jmin((int)(subBlockSize - m_blockFill),
+                                  numSamples - i);
+
+        // The number of lanes of a sub-block is determined by its first
+        // sample. Only these lanes are written, any missing right channel
+        // (mono, odd trailing channel) is mirrored by the consumer. Whenever
+        // the number of channels changes halfway a sub-block, the left
+        // channel fills in for a right channel that disappeared.
+        if (m_blockFill == 0) {
+            m_blockNumChannels = (uint32_t)numChannels;
+        }
+        for (int c = 0; c < (int)m_blockNumChannels; ++c) {
+            const auto* channel = channels[std::min(c, numChannels - 1)];
+            m_audioRingBuffers[c]->write({ channel + i, (size_t)n });
+        }
+
+        // See if we have matching MIDI messages
+        while (triggerEnabled && midiSamplePosition >= i &&
+               midiSamplePosition < i + n) {
+            m_blockNoteOnMask |= 1u << (m_blockFill + midiSamplePosition - i);
+            if (!midiIt.getNextEvent(message, midiSamplePosition)) {
+                // No further MIDI messages, invalidate sample position
+                midiSamplePosition = -1;
+            }
+        }
+
+        m_blockFill += n;
+        i += n;
+
+        // Publish the sub-block once it is complete
+        if (m_blockFill == subBlockSize) {
+            BlockData block = blockData;
+            block.noteOnMask = m_blockNoteOnMask;
+            block.numChannels = m_blockNumChannels;
+
+            m_blockRingBuffer->push(block);
+
+            m_blockFill = 0;
+            m_blockNoteOnMask = 0;
+            ++numBlocks;
+
+            // Within a large host block, the processing thread(s) are woken
+            // up as soon as enough samples are pending. The first group
+            // keeps count for all groups, which are fed in lockstep.
+            if (m_index == 0) {
+                m_owner.m_samplesSinceWakeup += (int)subBlockSize;
+                if (m_owner.m_samplesSinceWakeup >= wakeupThreshold) {
+                    m_owner.wakeUp();
+                    m_owner.m_samplesSinceWakeup = 0;
                 }
+            }
+        }
+    }
+
+    return numBlocks;
+}
+
+void
+MiniProcessor::setProcessingBlockSize(int numSamples) noexcept
+{
+    static_assert(k_minProcessingBlockSize ==
+                    KProcessor::getExpectedBlockSize(),
+                  "Batches consist of whole sub-blocks");
+
+    m_processingBlockSize =
+      juce::jlimit(k_minProcessingBlockSize,
+                   k_maxProcessingBlockSize,
+                   juce::nextPowerOfTwo(numSamples));
+}
+
+void
+MiniProcessor::setWaveformPyramid(double historySeconds,
+                                  int factor,
+                                  WaveformPyramid::FrequencyMode frequencyMode)
+{
+    m_waveformPyramidSeconds = std::max(0.0, historySeconds);
+    m_waveformPyramidFactor = std::max(2, factor);
+    m_waveformPyramidFrequencyMode = frequencyMode;
+    updateSideAnalyses();
+}
+
+void
+MiniProcessor::syncWaveformPyramid(
+  int channel,
+  double pixelsPerSample,
+  const WaveformPyramid::SyncHandler& handler) const
+{
+    markConsumed(AnalysisKind::SideAnalyses);
+
+    const auto& channelGroup =
+      *m_channelGroups[(size_t)channel / k_numGroupChannels];
+
+    std::lock_guard<std::mutex> lock{ channelGroup.m_sideAnalysisMutex };
+
+    const auto& waveformPyramid =
+      channelGroup.m_waveformPyramids[channel % k_numGroupChannels];
+    if (waveformPyramid != nullptr) {
+        waveformPyramid->sync(waveformPyramid->findLevel(pixelsPerSample),
+                              handler);
+    }
+}
+
+void
+MiniProcessor::setWaveformBands(bool enabled,
+                                WaveformPyramid::Crossover crossover)
+{
+    m_waveformBandsEnabled = enabled;
+    m_waveformBandsLowMid = crossover.LowMid;
+    m_waveformBandsMidHigh = crossover.MidHigh;
+    updateSideAnalyses();
+}
+
+void
+MiniProcessor::syncWaveformBands(
+  int channel,
+  double pixelsPerSample,
+  const WaveformPyramid::BandSyncHandler& handler) const
+{
+    markConsumed(AnalysisKind::SideAnalyses);
+
+    const auto& channelGroup =
+      *m_channelGroups[(size_t)channel / k_numGroupChannels];
+
+    std::lock_guard<std::mutex> lock{ channelGroup.m_sideAnalysisMutex };
+
+    const auto& waveformPyramid =
+      channelGroup.m_waveformPyramids[channel % k_numGroupChannels];
+    if (waveformPyramid != nullptr) {
+        waveformPyramid->syncBands(
+          waveformPyramid->findLevel(pixelsPerSample), handler);
+    }
+}
+
+void
+MiniProcessor::setLoudnessMeter(bool enabled)
+{
+    m_loudnessMeterEnabled = enabled;
+    updateSideAnalyses();
+}
+
+auto
+MiniProcessor::getLoudness(int channel) const -> LoudnessInfo
+{
+    markConsumed(AnalysisKind::SideAnalyses);
+
+    const auto& channelGroup =
+      *m_channelGroups[(size_t)channel / k_numGroupChannels];
+
+    std::lock_guard<std::mutex> lock{ channelGroup.m_sideAnalysisMutex };
+
+    if (channelGroup.m_loudnessMeter == nullptr) {
+        return LoudnessInfo{};
+    }
+    return channelGroup.m_loudnessMeter->getInfo();
+}
+
+void
+MiniProcessor::resetLoudness()
+{
+    for (auto& channelGroup : m_channelGroups) {
+        std::lock_guard<std::mutex> lock{ channelGroup->m_sideAnalysisMutex };
 
-                // Perform processing of sub-blocks
-                m_owner.m_processor->process(
-                  audioSubBlocks[0], audioSubBlocks[1], m_owner.m_numChannels);
+        if (channelGroup->m_loudnessMeter != nullptr) {
+            channelGroup->m_loudnessMeter->reset();
+        }
+    }
+}
+
+void
+MiniProcessor::setVectorscope(bool enabled, const Vectorscope::Config& config)
+{
+    m_vectorscopeEnabled = enabled;
+    m_vectorscopeMode = config.ReductionMode;
+    m_vectorscopePointBudget = std::max<size_t>(1, config.PointBudget);
+    m_vectorscopeDensitySize = std::max<size_t>(1, config.DensitySize);
+    updateSideAnalyses();
+}
+
+void
+MiniProcessor::syncVectorscopePoints(
+  int channel,
+  const Vectorscope::PointSyncHandler& handler) const
+{
+    markConsumed(AnalysisKind::SideAnalyses);
+
+    const auto& channelGroup =
+      *m_channelGroups[(size_t)channel / k_numGroupChannels];
+
+    std::lock_guard<std::mutex> lock{ channelGroup.m_sideAnalysisMutex };
+
+    if (channelGroup.m_vectorscope != nullptr) {
+        channelGroup.m_vectorscope->syncPoints(handler);
+    }
+}
+
+void
+MiniProcessor::syncVectorscopeDensity(
+  int channel,
+  const Vectorscope::DensitySyncHandler& handler) const
+{
+    markConsumed(AnalysisKind::SideAnalyses);
+
+    const auto& channelGroup =
+      *m_channelGroups[(size_t)channel / k_numGroupChannels];
+
+    std::lock_guard<std::mutex> lock{ channelGroup.m_sideAnalysisMutex };
+
+    if (channelGroup.m_vectorscope != nullptr) {
+        channelGroup.m_vectorscope->syncDensity(handler);
+    }
+}
+
+auto
+MiniProcessor::getVectorscopeInfo(int channel) const -> VectorscopeInfo
+{
+    markConsumed(AnalysisKind::SideAnalyses);
+
+    const auto& channelGroup =
+      *m_channelGroups[(size_t)channel / k_numGroupChannels];
+
+    std::lock_guard<std::mutex> lock{ channelGroup.m_sideAnalysisMutex };
+
+    if (channelGroup.m_vectorscope == nullptr) {
+        return VectorscopeInfo{};
+    }
+    return channelGroup.m_vectorscope->getInfo();
+}
+
+void
+MiniProcessor::updateSideAnalyses()
+{
+    std::lock_guard<std::mutex> updateLock{ m_sideAnalysisUpdateMutex };
+
+    const auto sampleRate = (float)m_sampleRate.load();
+    SideAnalysisConfig config;
+    if (sampleRate > 0.0f && m_waveformPyramidSeconds > 0.0) {
+        auto& waveformPyramids = config.WaveformPyramids;
+        waveformPyramids.SampleRate = sampleRate;
+        waveformPyramids.HistorySeconds = m_waveformPyramidSeconds;
+        waveformPyramids.Factor = (size_t)m_waveformPyramidFactor.load();
+        waveformPyramids.FrequencyMode = m_waveformPyramidFrequencyMode;
+        if (m_waveformBandsEnabled) {
+            waveformPyramids.BandCrossover = WaveformPyramid::Crossover{
+                m_waveformBandsLowMid.load(), m_waveformBandsMidHigh.load()
+            };
+        }
+    }
+    if (sampleRate > 0.0f && m_loudnessMeterEnabled) {
+        config.LoudnessMeters.SampleRate = sampleRate;
+    }
+    if (sampleRate > 0.0f && m_vectorscopeEnabled) {
+        config.Vectorscopes.SampleRate = sampleRate;
+        config.Vectorscopes.Reduction =
+          Vectorscope::Config{ m_vectorscopeMode.load(),
+                               m_vectorscopePointBudget.load(),
+                               m_vectorscopeDensitySize.load() };
+    }
+
+    // Only the analyses whose configuration changed are rebuilt, so changing
+    // one keeps the history of the others, and the loudness meters keep
+    // measuring the entire program
+    const auto rebuildWaveformPyramids =
+      config.WaveformPyramids != m_sideAnalysisConfig.WaveformPyramids;
+    const auto rebuildLoudnessMeters =
+      config.LoudnessMeters != m_sideAnalysisConfig.LoudnessMeters;
+    const auto rebuildVectorscopes =
+      config.Vectorscopes != m_sideAnalysisConfig.Vectorscopes;
+
+    // Everything is allocated before anything is replaced, so the analyses
+    // stay as they are if an allocation fails
+    struct SideAnalyses
+    {
+        std::array<std::unique_ptr<WaveformPyramid>, k_numGroupChannels>
+          WaveformPyramids;
+        std::unique_ptr<spectrex::LoudnessMeter> LoudnessMeter;
+        std::unique_ptr<spectrex::Vectorscope> Vectorscope;
+    };
+    std::vector<SideAnalyses> sideAnalyses(m_channelGroups.size());
+    for (auto& analyses : sideAnalyses) {
+        const auto& waveformPyramidConfig = config.WaveformPyramids;
+        if (rebuildWaveformPyramids &&
+            waveformPyramidConfig.SampleRate > 0.0f) {
+            for (auto& waveformPyramid : analyses.WaveformPyramids) {
+                waveformPyramid = std::make_unique<WaveformPyramid>(
+                  waveformPyramidConfig.SampleRate,
+                  waveformPyramidConfig.HistorySeconds,
+                  waveformPyramidConfig.Factor,
+                  waveformPyramidConfig.FrequencyMode,
+                  detectSimdLevel(),
+                  waveformPyramidConfig.BandCrossover);
             }
         }
-        // Wait for next event or timeout
-        wait(k_processingThreadTimeoutMs);
+        if (rebuildLoudnessMeters && config.LoudnessMeters.SampleRate > 0.0f) {
+            analyses.LoudnessMeter =
+              std::make_unique<LoudnessMeter>(config.LoudnessMeters.SampleRate);
+        }
+        if (rebuildVectorscopes && config.Vectorscopes.SampleRate > 0.0f) {
+            analyses.Vectorscope =
+              std::make_unique<Vectorscope>(config.Vectorscopes.SampleRate,
+                                            config.Vectorscopes.Reduction);
+        }
+    }
+
+    for (size_t g = 0; g < m_channelGroups.size(); ++g) {
+        auto& channelGroup = *m_channelGroups[g];
+        auto& analyses = sideAnalyses[g];
+
+        // Swap while holding the lock, the previous analyses are released
+        // after it
+        std::lock_guard<std::mutex> lock{ channelGroup.m_sideAnalysisMutex };
+        if (rebuildWaveformPyramids) {
+            std::swap(analyses.WaveformPyramids,
+                      channelGroup.m_waveformPyramids);
+        }
+        if (rebuildLoudnessMeters) {
+            std::swap(analyses.LoudnessMeter, channelGroup.m_loudnessMeter);
+        }
+        if (rebuildVectorscopes) {
+            std::swap(analyses.Vectorscope, channelGroup.m_vectorscope);
+        }
     }
+    m_sideAnalysisConfig = config;
+}
+
+void
+MiniProcessor::releaseSideAnalyses() noexcept
+{
+    std::lock_guard<std::mutex> updateLock{ m_sideAnalysisUpdateMutex };
+
+    for (auto& channelGroup : m_channelGroups) {
+        std::lock_guard<std::mutex> lock{ channelGroup->m_sideAnalysisMutex };
+        for (auto& waveformPyramid : channelGroup->m_waveformPyramids) {
+            waveformPyramid.reset();
+        }
+        channelGroup->m_loudnessMeter.reset();
+        channelGroup->m_vectorscope.reset();
+    }
+
+    // Rebuilt with the next update
+    m_sideAnalysisConfig = {};
+}
+
+void
+MiniProcessor::removeConsumer(AnalysisKind kind) noexcept
+{
+    // The analysis stays active for the idle timeout after the last consumer
+    // is gone
+    markConsumed(kind);
+    --m_numConsumers[(size_t)kind];
+}
+
+void
+MiniProcessor::setIdleTimeout(double seconds) noexcept
+{
+    m_idleTimeoutTicks = juce::Time::secondsToHighResolutionTicks(
+      std::max(0.0, seconds));
+}
+
+auto
+MiniProcessor::getIdleTimeout() const noexcept -> double
+{
+    return juce::Time::highResolutionTicksToSeconds(m_idleTimeoutTicks.load());
+}
+
+auto
+MiniProcessor::isAnalysisActive(AnalysisKind kind) const noexcept -> bool
+{
+    const auto idleTimeoutTicks = m_idleTimeoutTicks.load();
+    return idleTimeoutTicks == 0 || m_numConsumers[(size_t)kind] > 0 ||
+           juce::Time::getHighResolutionTicks() -
+               m_lastConsumedTicks[(size_t)kind] <
+             idleTimeoutTicks;
+}
+
+auto
+MiniProcessor::getDemandStatistics() const noexcept -> DemandInfo
+{
+    DemandInfo demand;
+    for (const auto& channelGroup : m_channelGroups) {
+        demand.AnalyzedSamples += channelGroup->m_numAnalyzedSamples.load();
+        demand.SkippedSamples += channelGroup->m_numSkippedSamples.load();
+    }
+    return demand;
+}
+
+auto
+MiniProcessor::getAnalysisLatency() const noexcept -> LatencyInfo
+{
+    // Channel groups are fed at the same time, so report the average of the
+    // averages and the overall maximum
+    LatencyInfo latency;
+    for (const auto& channelGroup : m_channelGroups) {
+        latency.AverageMs += channelGroup->m_latencyAverageMs.load();
+        latency.MaximumMs =
+          std::max(latency.MaximumMs, channelGroup->m_latencyMaximumMs.load());
+    }
+    latency.AverageMs /= (double)m_channelGroups.size();
+
+    return latency;
+}
+
+void
+MiniProcessor::resetAnalysisLatency() noexcept
+{
+    for (auto& channelGroup : m_channelGroups) {
+        channelGroup->m_latencyResetRequested = true;
+    }
+}
+
+auto
+MiniProcessor::getMemoryPerChannel() const noexcept -> MemoryInfo
+{
+    const auto& channelGroup = *m_channelGroups.front();
+
+    MemoryInfo memory;
+
+    // Both lanes of a group belong to their own channel, the metadata lane is
+    // shared by the two channels of the group
+    memory.TransportBytes =
+      channelGroup.m_audioRingBuffers[0]->getCapacity() * sizeof(float) +
+      channelGroup.m_blockRingBuffer->getCapacity() * sizeof(BlockData) /
+        k_numGroupChannels;
+
+    // The spectrogram is shared by the two channels of the group, whereas
+    // every channel has its own waveform
+    if (channelGroup.m_processor->isValid()) {
+        const auto spectrogramInfo =
+          channelGroup.m_processor->getSpectrogramInfo();
+        const auto waveformInfo =
+          channelGroup.m_processor->getWaveformInfo(Left);
+        memory.AnalysisBytes = spectrogramInfo.Width * spectrogramInfo.Height *
+                                 sizeof(float) / k_numGroupChannels +
+                               waveformInfo.Height * sizeof(WaveformBin);
+    }
+
+    // Side analyses of the first lane and its share of those of the group
+    {
+        std::lock_guard<std::mutex> lock{ channelGroup.m_sideAnalysisMutex };
+
+        if (const auto& pyramid = channelGroup.m_waveformPyramids[0]) {
+            memory.AnalysisBytes += pyramid->getMemorySize();
+        }
+
+        // The vectorscope is shared by the two channels of the group
+        if (const auto& vectorscope = channelGroup.m_vectorscope) {
+            memory.AnalysisBytes +=
+              vectorscope->getMemorySize() / k_numGroupChannels;
+        }
+    }
+
+    return memory;
 }
 
 void
@@ -188,17 +1073,40 @@ MiniProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) noexcept
     // Update the sample rate
     DBG("Sample rate = " << sampleRate);
 
-    m_processor->setParameter<float>(ProcessorParameters::Key::SampleRate,
-                                     sampleRate);
+    // The processing thread prepares a processor anew at m_sampleRate when it
+    // resumes after skipping blocks, which must not interleave with this
+    std::unique_lock<std::mutex> preparationLock{ m_preparationMutex };
+
     m_sampleRate = sampleRate;
 
-    // Perform preparation
-    float totalNumSamples = -1.0f;
+#ifdef TEST_GENERATE_ANY
+    // Pre-size the test signal buffer, so it does not reallocate on the audio
+    // thread for any host block up to the expected size
+    m_processingBuffer.setSize(m_maxNumChannels, samplesPerBlock);
+#endif
 
-    m_processor->prepare(totalNumSamples);
+    for (auto& channelGroup : m_channelGroups) {
+        channelGroup->m_processor->setParameter<float>(
+          ProcessorParameters::Key::SampleRate, sampleRate);
+
+        // Perform preparation
+        float totalNumSamples = -1.0f;
+
+        channelGroup->m_processor->prepare(totalNumSamples);
 
-    if (totalNumSamples > 0.0f) {
-        DBG("Total number of samples visualized = " << totalNumSamples);
+        if (totalNumSamples > 0.0f) {
+            DBG("Total number of samples visualized = " << totalNumSamples);
+        }
+    }
+    preparationLock.unlock();
+
+    // The side analyses are optional. Whenever they cannot be allocated, they
+    // are released rather than left running at the previous sample rate.
+    try {
+        updateSideAnalyses();
+    } catch (...) {
+        DBG("Side analyses could not be allocated");
+        releaseSideAnalyses();
     }
 }
 
@@ -216,25 +1124,26 @@ MiniProcessor::processBlock(juce::AudioPlayHead* playHead,
     // Avoid floating point denormals
     juce::ScopedNoDenormals scopedNoDenormals;
 
-    // Retrieve audio data
-    m_processingBuffer.makeCopyOf(buffer);
-
-    // If mono (not enough channels), mirror data into stereo channel
-    if (buffer.getNumChannels() < 2) {
-        m_processingBuffer.setSize(2, buffer.getNumSamples(), true);
-        juce::FloatVectorOperations::copy(m_processingBuffer.getWritePointer(1),
-                                          m_processingBuffer.getReadPointer(0),
-                                          m_processingBuffer.getNumSamples());
-    }
-
     // Retrieve number of samples and channels
     //
-    // The buffer only has place for two channels, fewer channels is fine, but
-    // anything above 2 will not work, so clamp to 2
-    const auto numSamples = m_processingBuffer.getNumSamples();
-    constexpr auto subBlockSize = KProcessor::getExpectedBlockSize();
-    const auto numChannels = std::min(2, m_processingBuffer.getNumChannels());
-    m_numChannels = numChannels;
+    // Any channels beyond the maximum number of channels are ignored
+    const auto numSamples = buffer.getNumSamples();
+    const auto numChannels =
+      std::min(m_maxNumChannels, buffer.getNumChannels());
+
+    // Retrieve audio data, the channels of the host buffer are written into
+    // the audio transport directly. Mono data is mirrored by the consumer.
+    // Test signals are generated into a copy, which is pre-sized in
+    // prepareToPlay.
+#ifdef TEST_GENERATE_ANY
+    m_processingBuffer.setSize(numChannels, numSamples, false, false, true);
+    for (int c = 0; c < numChannels; ++c) {
+        m_processingBuffer.copyFrom(c, 0, buffer, c, 0, numSamples);
+    }
+    const float* const* channels = m_processingBuffer.getArrayOfReadPointers();
+#else
+    const float* const* channels = buffer.getArrayOfReadPointers();
+#endif
 
     // Nothing to do
     if (numChannels == 0 || numSamples == 0) {
@@ -246,24 +1155,34 @@ MiniProcessor::processBlock(juce::AudioPlayHead* playHead,
     double ppqLoopEnd =
       std::numeric_limits<double>::infinity(); // Use infinite to encode no loop
 
-    // Get playhead information, set and synchronize
+    // Get playhead information, set and synchronize. Publishing the transport
+    // state is wait-free, readers retry instead of blocking this thread.
     {
         /// @thread audio
         /// @thread processing
-        std::scoped_lock<std::mutex> lock{ m_playheadMutex };
+        TransportState transportState;
 
-        bool playheadValid = false;
+        juce::AudioPlayHead::CurrentPositionInfo playhead;
         if (playHead != nullptr) {
-            if (playHead->getCurrentPosition(m_playhead)) {
+            if (playHead->getCurrentPosition(playhead)) {
                 // Critical information
-                ppqPosition = m_playhead.ppqPosition;
-                if (m_playhead.isLooping) {
-                    ppqLoopEnd = m_playhead.ppqLoopEnd;
+                ppqPosition = playhead.ppqPosition;
+                if (playhead.isLooping) {
+                    ppqLoopEnd = playhead.ppqLoopEnd;
                 }
-                playheadValid = true;
+
+                transportState.valid = true;
+                transportState.isPlaying = playhead.isPlaying;
+                transportState.isLooping = playhead.isLooping;
+                transportState.bpm = playhead.bpm;
+                transportState.timeSigNumerator = playhead.timeSigNumerator;
+                transportState.timeSigDenominator = playhead.timeSigDenominator;
+                transportState.ppqLoopStart = playhead.ppqLoopStart;
+                transportState.ppqLoopEnd = playhead.ppqLoopEnd;
             }
         }
-        m_playheadValid = playheadValid;
+
+        m_transportState.store(transportState);
     }
 
 #ifdef TEST_GENERATE_CLEAR
@@ -368,59 +1287,37 @@ MiniProcessor::processBlock(juce::AudioPlayHead* playHead,
     }
 #endif // TEST_GENERATE_BEEP
 
-    juce::MidiBuffer::Iterator midiIt{ midiMessages };
+    // Metadata of the processing blocks of this host block, and the time at
+    // which they are handed over
+    BlockData blockData;
+    blockData.publishTicks = juce::Time::getHighResolutionTicks();
+    blockData.ppqPosition = ppqPosition;
+    blockData.ppqLoopEnd = ppqLoopEnd;
+
+    // Fan the input channels out into the channel groups, groups without
+    // input channels are not fed at all
+    for (size_t g = 0; g < m_channelGroups.size(); ++g) {
+        const auto firstChannel = (int)g * k_numGroupChannels;
+        const auto numGroupChannels =
+          juce::jlimit(0, k_numGroupChannels, numChannels - firstChannel);
+
+        if (numGroupChannels == 0) {
+            m_channelGroups[g]->m_numChannels = 0;
+            continue;
+        }
 
-    // Find first MIDI message, if any
-    juce::MidiMessage message{};
-    int midiSamplePosition = 0;
-    if (!midiIt.getNextEvent(message, midiSamplePosition)) {
-        // No further MIDI messages, invalidate sample position
-        midiSamplePosition = -1;
+        m_channelGroups[g]->write(channels + firstChannel, numGroupChannels,
+                                  numSamples, midiMessages, triggerEnabled,
+                                  blockData);
     }
 
-    // Perform "sub-block" processing. Two ring buffers twice the size of the
-    // sub-block size are used. Instead of processing the length of the input
-    // buffer directly, the input buffer is broken up into chunks the size of
-    // the sub-block size. Any remaining samples from the input buffer due to
-    // the input buffer size not being divisible by the sub-block size are
-    // contained in the channel's ring buffer and are processed once new data
-    // comes in
-    /// @thread m_audioRingBuffer write from audio thread (producer)
-    /// @thread m_midiRingBuffer write from audio thread (producer)
-    for (int i = 0; i < numSamples; i += subBlockSize) {
-        const auto n = juce::jmin((int)subBlockSize, numSamples - i);
-
-        for (int j = 0; j < n; ++j) {
-            // Write channels into their buffers, if a channel is missing
-            // (mono), insert zeroes to keep buffers in sync
-            SyncData s;
-            s.left = *(m_processingBuffer.getReadPointer(0) + i + j);
-            s.right = 0.0f;
-            if (numChannels == 2) {
-                s.right = *(m_processingBuffer.getReadPointer(1) + i + j);
-            }
-
-            // See if we have a matching MIDI message
-            s.noteOn = false;
-            if (midiSamplePosition == i + j && triggerEnabled) {
-                if (!midiIt.getNextEvent(message, midiSamplePosition)) {
-                    // No further MIDI messages, invalidate sample position
-                    midiSamplePosition = -1;
-                }
-                s.noteOn = true;
-            }
-
-            // Critical playhead information (per block)
-            s.ppqPosition = ppqPosition;
-            s.ppqLoopEnd = ppqLoopEnd;
-
-            // Add to ring buffer
-            m_ringBuffer->push(s);
-        }
-
-        // m_audioRingBuffer read will be handled async by processing thread
-        // Wake up the processing thread in any case
-        m_processingThread.notify();
+    // The transport will be read async by the processing thread(s), wake them
+    // up for whatever is still pending at the end of the host block. While
+    // they are busy with an earlier wakeup, this is coalesced without a system
+    // call.
+    if (m_samplesSinceWakeup > 0) {
+        wakeUp();
+        m_samplesSinceWakeup = 0;
     }
 
 #ifdef TEST_GENERATE_CLEAR
@@ -437,25 +1334,48 @@ MiniProcessor::processBlock(juce::AudioPlayHead* playHead,
 #endif // TEST_GENERATE_CLEAR
 }
 
-MiniProcessor::MiniProcessor() noexcept
-  : m_processingThread(*this)
+MiniProcessor::MiniProcessor(ThreadingMode threadingMode,
+                             int maxNumChannels) noexcept
+  : m_maxNumChannels(std::max(1, maxNumChannels))
+  , m_threadingMode(threadingMode)
 {
-    // Instantiate audio processor
-    m_processor = std::make_unique<spectrex::KProcessor>();
-
-    // Configuration
-    m_processor->setParameter(spectrex::ProcessorParameters::Key::FtSize,
-                              spectrex::FtSize::Size256);
+    // Every analysis starts out as consumed, so it is active for at least the
+    // idle timeout
+    for (auto& lastConsumedTicks : m_lastConsumedTicks) {
+        lastConsumedTicks = juce::Time::getHighResolutionTicks();
+    }
 
-    // Initialize ring buffer
-    constexpr auto subBlockSize = KProcessor::getExpectedBlockSize();
-    m_ringBuffer = std::make_unique<RingBuffer<SyncData>>(
-      subBlockSize * k_ringBufferElements, SyncData{});
+    // Instantiate a channel group per (incomplete) stereo pair of channels
+    const auto numChannelGroups =
+      (m_maxNumChannels + k_numGroupChannels - 1) / k_numGroupChannels;
+    for (int g = 0; g < numChannelGroups; ++g) {
+        m_channelGroups.push_back(
+          std::make_unique<ChannelGroup>(*this, (size_t)g));
+    }
 
-    // Start the processing thread with high priority
-    m_processingThread.startThread(juce::Thread::Priority::high);
+    // Either register the channel groups with the shared scheduler, so its
+    // workers analyze them in parallel, every group being a task of its own,
+    // or start the processing thread with high priority
+    if (m_threadingMode == ThreadingMode::SharedScheduler) {
+        m_scheduler = AnalysisScheduler::getInstance();
+        for (auto& channelGroup : m_channelGroups) {
+            m_scheduler->addTask(*channelGroup);
+        }
+    } else {
+        m_processingThread = std::make_unique<ProcessingThread>(*this);
+        m_processingThread->startThread(juce::Thread::Priority::high);
+    }
 }
 
-MiniProcessor::~MiniProcessor() {}
+MiniProcessor::~MiniProcessor()
+{
+    // Stop processing before any of the audio transport is destroyed
+    if (m_scheduler != nullptr) {
+        for (auto& channelGroup : m_channelGroups) {
+            m_scheduler->removeTask(*channelGroup);
+        }
+    }
+    m_processingThread.reset();
+}
 
 } // namespace spectrex
@@ -0,0 +1,112 @@
+#include <Spectrex/OfflineProcessor.hpp>
+
+// Spectrex
+#include <Spectrex/Processing/Processor.hpp>
+
+// JUCE
+#include <juce_audio_basics/juce_audio_basics.h>
+
+// Stdlib
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace spectrex {
+
+auto
+OfflineProcessor::process(KProcessor& processor,
+                          AudioChannelView left,
+                          AudioChannelView right) noexcept -> bool
+{
+    constexpr auto subBlockSize = KProcessor::getExpectedBlockSize();
+
+    // Mirror mono data into the right channel, like MiniProcessor does
+    if (right.empty()) {
+        right = left;
+    }
+    const auto numSamples = std::min(left.size(), right.size());
+
+    // Avoid floating point denormals
+    juce::ScopedNoDenormals scopedNoDenormals;
+
+    // Ensure processor is prepared
+    float totalNumSamples = -1.0f;
+    if (!processor.prepare(totalNumSamples)) {
+        return false;
+    }
+
+    // Start playing at position 0, which is what MiniProcessor does without a
+    // host playhead
+    processor.setAbsolutePosition(0.0f);
+    if (processor.setPlaying(true) || processor.isInitialPosition()) {
+        processor.setPosition(0.0f);
+    }
+
+    // Feed all complete sub-blocks in place. The remaining samples are left
+    // out, like MiniProcessor holds them back until their sub-block completes
+    for (size_t i = 0; i + subBlockSize <= numSamples; i += subBlockSize) {
+        processor.process(left.subspan(i, subBlockSize),
+                          right.subspan(i, subBlockSize),
+                          2);
+    }
+
+    return true;
+}
+
+auto
+OfflineProcessor::processBatch(gsl::span<Job> jobs, int numThreads) noexcept
+  -> size_t
+{
+    if (numThreads <= 0) {
+        numThreads = juce::SystemStats::getNumCpus();
+    }
+    numThreads = std::max(1, std::min(numThreads, (int)jobs.size()));
+
+    // Every thread repeatedly claims the next unprocessed job, so long and
+    // short jobs balance out across the threads
+    std::atomic<size_t> nextJob = 0;
+    std::atomic<size_t> numSucceeded = 0;
+
+    auto worker = [&]() noexcept {
+        for (auto j = nextJob++; j < jobs.size(); j = nextJob++) {
+            auto& job = jobs[j];
+            job.Succeeded = false;
+
+            if (job.Processor == nullptr) {
+                continue;
+            }
+
+            if (job.SampleRate > 0.0f) {
+                job.Processor->setParameter<float>(
+                  ProcessorParameters::Key::SampleRate, job.SampleRate);
+            }
+
+            job.Succeeded = process(*job.Processor, job.Left, job.Right);
+            if (job.Succeeded) {
+                ++numSucceeded;
+            }
+        }
+    };
+
+    // The calling thread takes part in the work as well
+    std::vector<std::thread> threads;
+    try {
+        threads.reserve((size_t)numThreads - 1);
+        for (int t = 1; t < numThreads; ++t) {
+            threads.emplace_back(worker);
+        }
+    } catch (...) {
+        // A thread could not be started (out of memory or threads), the
+        // threads that did start and the calling thread share all jobs
+    }
+    worker();
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    return numSucceeded;
+}
+
+} // namespace spectrex
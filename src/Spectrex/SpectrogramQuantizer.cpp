@@ -0,0 +1,45 @@
+#include <Spectrex/SpectrogramQuantizer.hpp>
+
+namespace spectrex {
+
+SpectrogramQuantizer::SpectrogramQuantizer(QuantizedFormat format) noexcept
+  : m_format(format)
+{
+}
+
+void
+SpectrogramQuantizer::setFormat(QuantizedFormat format) noexcept
+{
+    m_formatChanged = m_formatChanged || format != m_format;
+    m_format = format;
+}
+
+void
+SpectrogramQuantizer::quantizeRows(const SyncInfo<float>& info,
+                                   uint16_t* destination) const noexcept
+{
+    spectrex::quantize(
+      m_format, info.Pointer, destination, info.Width * info.Height);
+}
+
+void
+SpectrogramQuantizer::syncSpectrogram(KProcessor& processor,
+                                      const SyncHandler& handler)
+{
+    processor.syncSpectrogram([&](SyncInfo<float> first,
+                                  std::optional<SyncInfo<float>> second) {
+        // Data synchronized in the previous format can not be mixed with new
+        // data, so have the consumer start over
+        if (m_formatChanged) {
+            m_formatChanged = false;
+            handler(SyncInfo<float>(true), std::nullopt);
+            if (first.Clear) {
+                return;
+            }
+        }
+
+        handler(first, second);
+    });
+}
+
+} // namespace spectrex
@@ -0,0 +1,68 @@
+#include <Spectrex/Analysis/ConstantQ.hpp>
+
+// Spectrex
+#include <Test.hpp>
+
+// Stdlib
+#include <vector>
+
+using namespace spectrex;
+using namespace spectrex::test;
+
+namespace {
+
+/// Checks the layout of the bins.
+void
+testBins()
+{
+    ConstantQ constantQ(48000.0, 20.0, 16000.0, 24, 512);
+    SPECTREX_CHECK(constantQ.getNumBins() == 232);
+    SPECTREX_CHECK(constantQ.getNumOctaves() == 10);
+    SPECTREX_CHECK(constantQ.getBinFrequency(0) >= 20.0);
+    SPECTREX_CHECK(constantQ.getBinFrequency(constantQ.getNumBins() - 1) <=
+                   16000.0);
+    for (size_t bin = 1; bin < constantQ.getNumBins(); ++bin) {
+        const auto ratio = constantQ.getBinFrequency(bin) /
+                           constantQ.getBinFrequency(bin - 1);
+        SPECTREX_CHECK(std::abs(ratio - std::pow(2.0, 1.0 / 24.0)) < 1e-9);
+    }
+}
+
+/// Checks that tones at bin frequencies, in every octave, peak at their bin
+/// with their amplitude and hardly leak into distant bins.
+void
+testTones()
+{
+    const double sampleRate = 48000.0;
+    ConstantQ constantQ(sampleRate, 20.0, 16000.0, 24, 512);
+    const auto lastBin = constantQ.getNumBins() - 1;
+    for (const size_t bin :
+         { size_t{ 10 }, size_t{ 100 }, size_t{ 200 }, lastBin }) {
+        const auto samples = makeSine(
+          6 * 48000, constantQ.getBinFrequency(bin), sampleRate, 0.7);
+
+        Frames frames;
+        constantQ.reset();
+        constantQ.process(samples, collectFrames(frames));
+        SPECTREX_CHECK(!frames.empty());
+
+        const auto& frame = frames.back();
+        SPECTREX_CHECK(getPeak(frame) == bin);
+        SPECTREX_CHECK(std::abs(frame[bin] - 0.7f) < 5e-3f);
+        for (size_t k = 0; k < frame.size(); ++k) {
+            if (k + 3 < bin || k > bin + 3) {
+                SPECTREX_CHECK(frame[k] < 1e-2f);
+            }
+        }
+    }
+}
+
+} // namespace
+
+int
+main()
+{
+    testBins();
+    testTones();
+    return 0;
+}
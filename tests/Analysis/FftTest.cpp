@@ -0,0 +1,155 @@
+#include <Spectrex/Analysis/Fft.hpp>
+
+// Spectrex
+#include <Test.hpp>
+
+// Stdlib
+#include <complex>
+#include <vector>
+
+using namespace spectrex;
+using namespace spectrex::test;
+
+namespace {
+
+/// Returns the DFT of \a input multiplied by \a window, in double precision.
+auto
+naiveDft(const std::vector<float>& input, const std::vector<float>& window)
+  -> std::vector<std::complex<double>>
+{
+    const auto size = input.size();
+    std::vector<std::complex<double>> output(size / 2 + 1);
+    for (size_t k = 0; k < output.size(); ++k) {
+        for (size_t n = 0; n < size; ++n) {
+            const auto angle = -2.0 * k_pi * (double)(k * n % size) /
+                               (double)size;
+            output[k] += (double)(input[n] * window[n]) *
+                         std::polar(1.0, angle);
+        }
+    }
+    return output;
+}
+
+/// Checks the transform and the fused windowed magnitudes of every size and
+/// instruction set against a naive DFT.
+void
+testAgainstDft()
+{
+    for (const auto simdLevel : { SimdLevel::Scalar,
+                                  SimdLevel::Sse,
+                                  SimdLevel::Avx2,
+                                  SimdLevel::Neon }) {
+        for (size_t size = 4; size <= 4096; size *= 2) {
+            const auto input = makeNoise(size, 1.0f, (unsigned)size);
+            std::vector<float> ones(size, 1.0f);
+            std::vector<float> hann(size);
+            for (size_t i = 0; i < size; ++i) {
+                hann[i] = (float)(0.5 - 0.5 * std::cos(2.0 * k_pi * (double)i /
+                                                       (double)size));
+            }
+
+            BuiltinFft fft(size, simdLevel);
+            std::vector<std::complex<float>> spectrum(fft.getNumBins());
+            std::vector<float> magnitudes(fft.getNumBins());
+            fft.forward(input.data(), spectrum.data());
+            fft.forwardMagnitudes(input.data(), hann.data(), magnitudes.data());
+
+            const auto expected = naiveDft(input, ones);
+            const auto expectedWindowed = naiveDft(input, hann);
+            const auto tolerance = 1e-5 * std::sqrt((double)size);
+            for (size_t k = 0; k < fft.getNumBins(); ++k) {
+                SPECTREX_CHECK(
+                  std::abs(std::complex<double>(spectrum[k]) - expected[k]) <
+                  tolerance);
+                SPECTREX_CHECK(std::abs(std::abs(expectedWindowed[k]) -
+                                        (double)magnitudes[k]) < tolerance);
+            }
+        }
+    }
+}
+
+/// Checks that the registry creates backends with the installed factory, and
+/// the built-in backend once the factory is cleared.
+void
+testRegistry()
+{
+    size_t numCreated = 0;
+    FftBackendRegistry::setFactory([&](size_t size) {
+        ++numCreated;
+        return std::make_unique<BuiltinFft>(size, SimdLevel::Scalar);
+    });
+    const auto custom = FftBackendRegistry::create(256);
+    SPECTREX_CHECK(numCreated == 1);
+    SPECTREX_CHECK(custom->getSize() == 256);
+    SPECTREX_CHECK(static_cast<BuiltinFft&>(*custom).getSimdLevel() ==
+                   SimdLevel::Scalar);
+
+    FftBackendRegistry::setFactory({});
+    const auto builtin = FftBackendRegistry::create(512);
+    SPECTREX_CHECK(numCreated == 1);
+    SPECTREX_CHECK(builtin->getNumBins() == 257);
+}
+
+/// Returns the number of frames per second \a backend computes the magnitudes
+/// of Hann windowed noise at.
+auto
+measureFrameRate(FftBackend& backend, size_t numFrames = 10000) -> double
+{
+    const auto size = backend.getSize();
+    auto input = makeNoise(size);
+    std::vector<float> window(size);
+    for (size_t i = 0; i < size; ++i) {
+        window[i] = (float)(0.5 - 0.5 * std::cos(2.0 * k_pi * (double)i /
+                                                 (double)size));
+    }
+    std::vector<float> magnitudes(backend.getNumBins());
+
+    // Warm up the caches and the tables first
+    backend.forwardMagnitudes(input.data(), window.data(), magnitudes.data());
+
+    // Feed the magnitudes back, so the frames are not optimized out
+    const auto elapsed = measureNanoseconds([&] {
+        for (size_t frame = 0; frame < numFrames; ++frame) {
+            backend.forwardMagnitudes(
+              input.data(), window.data(), magnitudes.data());
+            input[frame % size] +=
+              magnitudes[frame % magnitudes.size()] * 1e-9f;
+        }
+    });
+
+    return elapsed > 0.0 ? (double)numFrames * 1e9 / elapsed : 0.0;
+}
+
+/// Prints the frames per second of every FtSize, for every instruction set of
+/// the built-in backend and for the backend of the registry.
+void
+benchmarkFrameRates()
+{
+    for (size_t size = 256; size <= 8192; size *= 2) {
+        for (const auto simdLevel : { SimdLevel::Scalar,
+                                      SimdLevel::Sse,
+                                      SimdLevel::Avx2,
+                                      SimdLevel::Neon }) {
+            BuiltinFft fft(size, simdLevel);
+            if (fft.getSimdLevel() != simdLevel) {
+                continue;
+            }
+            std::printf("%zu %s: %.0f frames/s\n", size, fft.getName(),
+                        measureFrameRate(fft));
+        }
+        const auto backend = FftBackendRegistry::create(size);
+        std::printf("%zu registry: %.0f frames/s\n", size,
+                    measureFrameRate(*backend));
+    }
+}
+
+} // namespace
+
+int
+main()
+{
+    testAgainstDft();
+    testRegistry();
+    benchmarkFrameRates();
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include <Spectrex/Analysis/LogBinRemap.hpp>
+
+// Spectrex
+#include <Test.hpp>
+
+// Stdlib
+#include <vector>
+
+using namespace spectrex;
+using namespace spectrex::test;
+
+namespace {
+
+/// Returns a configuration with tilt and dB scale.
+auto
+makeConfig(uint32_t numBins) -> LogBinRemap::Config
+{
+    LogBinRemap::Config config;
+    config.NumFftBins = 4097;
+    config.NumBins = numBins;
+    config.TiltDbPerOctave = 3.0f;
+    config.DbScale = 0.5f;
+    return config;
+}
+
+/// Checks that the matrix is only rebuilt when the configuration changes.
+void
+testCaching()
+{
+    LogBinRemap remap;
+    SPECTREX_CHECK(remap.configure(makeConfig(512)));
+    SPECTREX_CHECK(!remap.configure(makeConfig(512)));
+    SPECTREX_CHECK(remap.configure(makeConfig(256)));
+    SPECTREX_CHECK(remap.getConfig() == makeConfig(256));
+}
+
+/// Checks that a flat spectrum maps onto the tilt and dB scale gain, with
+/// the same result for every instruction set.
+void
+testFlatSpectrum()
+{
+    for (const uint32_t numBins : { 128u, 512u, 2048u }) {
+        const auto config = makeConfig(numBins);
+
+        LogBinRemap scalar(SimdLevel::Scalar);
+        LogBinRemap vectorized;
+        scalar.configure(config);
+        vectorized.configure(config);
+
+        const std::vector<float> magnitudes(config.NumFftBins, 1.0f);
+        std::vector<float> scalarOutput(numBins);
+        std::vector<float> vectorizedOutput(numBins);
+        scalar.apply(magnitudes.data(), scalarOutput.data());
+        vectorized.apply(magnitudes.data(), vectorizedOutput.data());
+
+        for (size_t bin = 0; bin < numBins; ++bin) {
+            const auto octaves = std::log2(scalar.getBinFrequency(bin) /
+                                           config.TiltReferenceFrequency);
+            const auto expected =
+              std::pow(2.0, (double)config.DbScale) *
+              std::pow(10.0, config.TiltDbPerOctave * octaves / 20.0);
+            SPECTREX_CHECK(std::abs(scalarOutput[bin] - expected) <
+                           1e-4 * expected);
+            const auto difference = vectorizedOutput[bin] - scalarOutput[bin];
+            SPECTREX_CHECK(std::abs(difference) <= 1e-6f * scalarOutput[bin]);
+        }
+    }
+}
+
+/// Prints the cost of rebuilding and applying the matrix at several analyzer
+/// bin counts, for every instruction set.
+void
+benchmarkBinCounts()
+{
+    constexpr size_t numApplies = 10000;
+
+    for (const uint32_t numBins : { 128u, 512u, 2048u }) {
+        const auto config = makeConfig(numBins);
+        for (const auto simdLevel : { SimdLevel::Scalar, SimdLevel::Avx2 }) {
+            LogBinRemap remap(simdLevel);
+            if (remap.getSimdLevel() != simdLevel) {
+                continue;
+            }
+            const auto rebuild =
+              measureNanoseconds([&] { remap.configure(config); });
+
+            std::vector<float> magnitudes(config.NumFftBins);
+            for (size_t i = 0; i < magnitudes.size(); ++i) {
+                magnitudes[i] = (float)(i % 17) / 17.0f;
+            }
+            std::vector<float> output(numBins);
+            const auto apply = measureNanoseconds([&] {
+                for (size_t i = 0; i < numApplies; ++i) {
+                    remap.apply(magnitudes.data(), output.data());
+                    // Keep the result observable, so the applies are not
+                    // optimized out
+                    magnitudes[i % magnitudes.size()] +=
+                      output[i % output.size()] * 0.0f;
+                }
+            });
+
+            std::printf("%u bins %s: rebuild %.0f us, apply %.0f ns, %zu "
+                        "weights\n",
+                        numBins,
+                        simdLevel == SimdLevel::Avx2 ? "avx2" : "scalar",
+                        rebuild * 1e-3,
+                        apply / (double)numApplies,
+                        remap.getNumWeights());
+        }
+    }
+}
+
+} // namespace
+
+int
+main()
+{
+    testCaching();
+    testFlatSpectrum();
+    benchmarkBinCounts();
+    return 0;
+}
@@ -0,0 +1,128 @@
+#include <Spectrex/Analysis/LoudnessMeter.hpp>
+
+// Spectrex
+#include <Test.hpp>
+
+// Stdlib
+#include <vector>
+
+using namespace spectrex;
+using namespace spectrex::test;
+
+namespace {
+
+/// Feeds a stereo sine of \a dbfs dBFS (peak) to \a meter, in odd chunks.
+void
+feedSine(LoudnessMeter& meter,
+         double seconds,
+         double dbfs,
+         double frequency,
+         double phase = 0.0)
+{
+    const auto sampleRate = (double)meter.getSampleRate();
+    const auto samples =
+      makeSine((size_t)(seconds * sampleRate), frequency, sampleRate,
+               std::pow(10.0, dbfs / 20.0), phase);
+    for (size_t position = 0; position < samples.size(); position += 333) {
+        const auto count = std::min<size_t>(333, samples.size() - position);
+        const auto view = AudioChannelView(samples).subspan(position, count);
+        const AudioChannelView channels[] = { view, view };
+        meter.process(channels);
+    }
+}
+
+/// Checks the cases of EBU Tech 3341 and 3342 that can be generated as
+/// sines, at 44.1 and 48 kHz with every instruction set. A 1 kHz stereo sine
+/// at -23 dBFS reads -23 LUFS.
+void
+testEbuCases()
+{
+    for (const auto sampleRate : { 44100.0f, 48000.0f }) {
+        for (const auto simdLevel : { SimdLevel::Scalar, detectSimdLevel() }) {
+            LoudnessMeter meter(sampleRate, simdLevel);
+
+            // Tech 3341 cases 1 and 2
+            feedSine(meter, 20.0, -23.0, 1000.0);
+            auto info = meter.getInfo();
+            SPECTREX_CHECK(std::abs(info.Momentary + 23.0f) < 0.1f);
+            SPECTREX_CHECK(std::abs(info.ShortTerm + 23.0f) < 0.1f);
+            SPECTREX_CHECK(std::abs(info.Integrated + 23.0f) < 0.1f);
+            SPECTREX_CHECK(std::abs(info.Seconds - 20.0) < 0.1);
+
+            // Tech 3341 case 3, the quiet parts are below the relative gate
+            meter.reset();
+            feedSine(meter, 10.0, -36.0, 1000.0);
+            feedSine(meter, 60.0, -23.0, 1000.0);
+            feedSine(meter, 10.0, -36.0, 1000.0);
+            SPECTREX_CHECK(std::abs(meter.getInfo().Integrated + 23.0f) < 0.1f);
+
+            // Tech 3342 case 1
+            meter.reset();
+            feedSine(meter, 20.0, -20.0, 1000.0);
+            feedSine(meter, 20.0, -30.0, 1000.0);
+            info = meter.getInfo();
+            SPECTREX_CHECK(std::abs(info.LoudnessRange - 10.0f) < 1.0f);
+            SPECTREX_CHECK(std::abs(info.MaxMomentary + 20.0f) < 0.1f);
+
+            // Tech 3341 case 15, a sine at fs / 4 sampled at 45 degrees peaks
+            // at -3 dBFS between the samples of 0 dBFS
+            meter.reset();
+            feedSine(meter, 5.0, 0.0, sampleRate / 4.0, k_pi / 4.0);
+            info = meter.getInfo();
+            SPECTREX_CHECK(info.MaxTruePeak > -0.4f && info.MaxTruePeak < 0.2f);
+
+            meter.reset();
+            SPECTREX_CHECK(meter.getInfo().Seconds == 0.0);
+            SPECTREX_CHECK(std::isinf(meter.getInfo().Integrated));
+        }
+    }
+}
+
+/// Checks that silence stays below the absolute gate.
+void
+testSilence()
+{
+    LoudnessMeter meter(48000.0f);
+    feedSine(meter, 5.0, -100.0, 1000.0);
+    const auto info = meter.getInfo();
+    SPECTREX_CHECK(std::isinf(info.Integrated) && info.Integrated < 0.0f);
+    SPECTREX_CHECK(info.LoudnessRange == 0.0f);
+}
+
+/// Prints the cost of processing stereo noise, for every instruction set.
+void
+benchmarkSimdLevels()
+{
+    const float sampleRate = 48000.0f;
+    const auto left = makeNoise((size_t)sampleRate, 0.5f, 1);
+    const auto right = makeNoise((size_t)sampleRate, 0.5f, 2);
+
+    for (const auto simdLevel : { SimdLevel::Scalar, SimdLevel::Avx2 }) {
+        LoudnessMeter meter(sampleRate, simdLevel);
+        if (meter.getSimdLevel() != simdLevel) {
+            continue;
+        }
+        const auto elapsed = measureNanosecondsPerSecond(
+          sampleRate, [&](size_t offset, size_t size) {
+              const AudioChannelView channels[] = {
+                  AudioChannelView(left).subspan(offset, size),
+                  AudioChannelView(right).subspan(offset, size)
+              };
+              meter.process(channels);
+          });
+        std::printf("%s: %.0f us per second of audio\n",
+                    simdLevel == SimdLevel::Avx2 ? "avx2" : "scalar",
+                    elapsed * 1e-3);
+    }
+}
+
+} // namespace
+
+int
+main()
+{
+    testEbuCases();
+    testSilence();
+    benchmarkSimdLevels();
+    return 0;
+}
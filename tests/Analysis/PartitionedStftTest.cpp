@@ -0,0 +1,110 @@
+#include <Spectrex/Analysis/PartitionedStft.hpp>
+
+// Spectrex
+#include <Spectrex/Analysis/Stft.hpp>
+#include <Test.hpp>
+
+// Stdlib
+#include <tuple>
+#include <vector>
+
+using namespace spectrex;
+using namespace spectrex::test;
+
+namespace {
+
+/// Checks that the frames match those of Stft, spread or not, whatever the
+/// hop. A spread frame is passed up to a hop late, so only the frames due a hop
+/// before the end have been passed by then.
+void
+testAgainstStft()
+{
+    const auto samples = makeNoise(4 * 48000, 0.5f, 2);
+    for (const auto& [size, hop, firstBin, lastBin] :
+         { std::tuple<size_t, size_t, size_t, size_t>{ 16384, 4096, 0, 8192 },
+           { 65536, 8192, 10, 300 },
+           { 4096, 100, 0, 2048 },
+           { 8, 3, 0, 4 } }) {
+        Stft reference(size, hop, firstBin, lastBin, Stft::Method::Fft);
+        Frames referenceFrames;
+        reference.process(samples, collectFrames(referenceFrames));
+
+        for (const auto spread : { false, true }) {
+            PartitionedStft stft(size, hop, firstBin, lastBin, spread);
+            SPECTREX_CHECK(stft.getNumBins() == lastBin - firstBin + 1);
+
+            Frames frames;
+            for (size_t position = 0; position < samples.size();
+                 position += 32) {
+                const auto count =
+                  std::min<size_t>(32, samples.size() - position);
+                stft.process(
+                  gsl::span<const float>(samples.data() + position, count),
+                  collectFrames(frames));
+            }
+
+            SPECTREX_CHECK(frames.size() <= referenceFrames.size());
+            SPECTREX_CHECK(frames.size() + 1 >= referenceFrames.size());
+            SPECTREX_CHECK(getRelativeError(frames, referenceFrames) < 1e-5);
+        }
+    }
+}
+
+/// Prints the mean, p99, p99.9 and maximum time per 32-sample process call of
+/// large transforms, spread and not. The history is filled before measuring,
+/// so all calls take part in computing frames, and the per-hop spikes of
+/// non-spread computation show in the p99.9 as long as a hop spans more than
+/// 100 calls.
+void
+benchmarkCallTimes()
+{
+    constexpr size_t callSize = 32;
+    constexpr size_t numCalls = 100000;
+
+    const auto samples = makeNoise(callSize);
+    float sum = 0.0f;
+    const auto handler = [&](gsl::span<const float> magnitudes) {
+        sum += magnitudes[0];
+    };
+
+    for (size_t size = 16384; size <= 65536; size *= 2) {
+        const auto hop = size / 4;
+        for (const auto spread : { false, true }) {
+            PartitionedStft stft(size, hop, 0, size / 2, spread);
+            for (size_t i = 0; i < (size + hop) / callSize; ++i) {
+                stft.process(samples, handler);
+            }
+
+            std::vector<double> durations(numCalls);
+            double mean = 0.0;
+            for (auto& duration : durations) {
+                duration =
+                  measureNanoseconds([&] { stft.process(samples, handler); });
+                mean += duration / (double)numCalls;
+            }
+
+            std::printf("%zu/%zu %s: mean %.0f ns, p99 %.0f ns, p99.9 %.0f "
+                        "ns, max %.0f ns\n",
+                        size,
+                        hop,
+                        spread ? "spread" : "not spread",
+                        mean,
+                        getPercentile(durations, 0.99),
+                        getPercentile(durations, 0.999),
+                        getPercentile(durations, 1.0));
+        }
+    }
+
+    // Keep the result observable, so the frames are not optimized out
+    SPECTREX_CHECK(std::isfinite(sum));
+}
+
+} // namespace
+
+int
+main()
+{
+    testAgainstStft();
+    benchmarkCallTimes();
+    return 0;
+}
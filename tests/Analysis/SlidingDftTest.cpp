@@ -0,0 +1,107 @@
+#include <Spectrex/Analysis/SlidingDft.hpp>
+
+// Spectrex
+#include <Spectrex/Analysis/Fft.hpp>
+#include <Test.hpp>
+
+// Stdlib
+#include <vector>
+
+using namespace spectrex;
+using namespace spectrex::test;
+
+namespace {
+
+/// Returns the Hann windowed magnitudes of the \a size samples of \a samples
+/// ending at \a end, computed by a full FFT.
+auto
+getFftMagnitudes(const std::vector<float>& samples, size_t end, size_t size)
+  -> std::vector<float>
+{
+    std::vector<float> window(size);
+    for (size_t i = 0; i < size; ++i) {
+        window[i] =
+          (float)(0.5 - 0.5 * std::cos(2.0 * k_pi * (double)i / (double)size));
+    }
+
+    BuiltinFft fft(size);
+    std::vector<float> magnitudes(fft.getNumBins());
+    fft.forwardMagnitudes(samples.data() + end - size, window.data(),
+                          magnitudes.data());
+    return magnitudes;
+}
+
+/// Checks the bins against a full FFT, across more than a resync interval, so
+/// both the updated and the recomputed bins are covered.
+void
+testAgainstFft()
+{
+    for (const auto& [size, firstBin, lastBin] :
+         { std::tuple<size_t, size_t, size_t>{ 256, 0, 128 },
+           { 1024, 10, 60 },
+           { 4, 0, 2 } }) {
+        const auto samples =
+          makeNoise(size * (SlidingDft::k_resyncInterval + 3), 0.5f);
+
+        SlidingDft dft(size, firstBin, lastBin);
+        std::vector<float> magnitudes(dft.getNumBins());
+        size_t position = 0;
+        while (position < samples.size()) {
+            // Odd chunk sizes, so windows end anywhere within a chunk
+            const auto count = std::min<size_t>(37, samples.size() - position);
+            dft.process(
+              gsl::span<const float>(samples.data() + position, count));
+            position += count;
+
+            if (position < size) {
+                continue;
+            }
+            dft.getMagnitudes(magnitudes.data());
+            const auto expected = getFftMagnitudes(samples, position, size);
+            for (size_t k = 0; k < dft.getNumBins(); ++k) {
+                const auto error = magnitudes[k] - expected[firstBin + k];
+                SPECTREX_CHECK(std::abs(error) < 1e-4f * (float)size);
+            }
+        }
+    }
+}
+
+/// Checks that the history round-trips, and that the bins follow a replaced
+/// history.
+void
+testHistory()
+{
+    const size_t size = 512;
+    const auto samples = makeNoise(size, 0.5f, 7);
+
+    SlidingDft dft(size, 0, size / 2);
+    dft.process(makeNoise(3 * size, 1.0f, 8));
+    dft.setHistory(samples);
+
+    std::vector<float> history(size);
+    dft.copyHistory(history.data(), size);
+    SPECTREX_CHECK(history == samples);
+
+    std::vector<float> magnitudes(dft.getNumBins());
+    dft.getMagnitudes(magnitudes.data());
+    const auto expected = getFftMagnitudes(samples, size, size);
+    for (size_t k = 0; k < dft.getNumBins(); ++k) {
+        SPECTREX_CHECK(std::abs(magnitudes[k] - expected[k]) < 1e-3f);
+    }
+
+    dft.reset();
+    dft.getMagnitudes(magnitudes.data());
+    for (const auto magnitude : magnitudes) {
+        SPECTREX_CHECK(magnitude == 0.0f);
+    }
+}
+
+} // namespace
+
+int
+main()
+{
+    testAgainstFft();
+    testHistory();
+    return 0;
+}
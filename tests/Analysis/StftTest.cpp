@@ -0,0 +1,95 @@
+#include <Spectrex/Analysis/Stft.hpp>
+
+// Spectrex
+#include <Test.hpp>
+
+// Stdlib
+#include <tuple>
+#include <vector>
+
+using namespace spectrex;
+using namespace spectrex::test;
+
+namespace {
+
+/// Returns a tone with noise.
+auto
+makeSignal(size_t numSamples) -> std::vector<float>
+{
+    auto samples = makeNoise(numSamples, 0.1f, 2);
+    const auto tone = makeSine(numSamples, 382.0, 48000.0, 0.5);
+    for (size_t i = 0; i < numSamples; ++i) {
+        samples[i] += tone[i];
+    }
+    return samples;
+}
+
+/// Checks that both methods produce the same frames at the same rate.
+void
+testMethodsAgree()
+{
+    const auto samples = makeSignal(48000);
+    for (const auto& [size, hop, firstBin, lastBin] :
+         { std::tuple<size_t, size_t, size_t, size_t>{ 4096, 8, 0, 2048 },
+           { 4096, 32, 10, 60 },
+           { 1024, 256, 0, 512 },
+           { 256, 3, 0, 128 } }) {
+        Stft fft(size, hop, firstBin, lastBin, Stft::Method::Fft);
+        Stft slidingDft(size, hop, firstBin, lastBin, Stft::Method::SlidingDft);
+        SPECTREX_CHECK(fft.getNumBins() == lastBin - firstBin + 1);
+
+        Frames fftFrames;
+        Frames slidingDftFrames;
+        fft.process(samples, collectFrames(fftFrames));
+        slidingDft.process(samples, collectFrames(slidingDftFrames));
+
+        SPECTREX_CHECK(fftFrames.size() == samples.size() / hop);
+        SPECTREX_CHECK(slidingDftFrames.size() == fftFrames.size());
+        SPECTREX_CHECK(getRelativeError(slidingDftFrames, fftFrames) < 1e-5);
+    }
+}
+
+/// Checks that the automatic method picks the sliding DFT for small hops and
+/// narrow bands only.
+void
+testAutomaticMethod()
+{
+    SPECTREX_CHECK(Stft(4096, 32, 10, 60).getMethod() ==
+                   Stft::Method::SlidingDft);
+    SPECTREX_CHECK(Stft(256, 3, 0, 128).getMethod() ==
+                   Stft::Method::SlidingDft);
+    SPECTREX_CHECK(Stft(1024, 256, 0, 512).getMethod() == Stft::Method::Fft);
+    SPECTREX_CHECK(Stft(4096, 2048, 0, 2048).getMethod() == Stft::Method::Fft);
+}
+
+/// Checks that frames do not depend on how the samples are split into calls.
+void
+testChunking()
+{
+    const auto samples = makeSignal(20000);
+
+    Stft whole(1024, 100, 0, 512, Stft::Method::Fft);
+    Stft chunked(1024, 100, 0, 512, Stft::Method::Fft);
+    Frames wholeFrames;
+    Frames chunkedFrames;
+    whole.process(samples, collectFrames(wholeFrames));
+    for (size_t position = 0; position < samples.size(); position += 33) {
+        const auto count = std::min<size_t>(33, samples.size() - position);
+        chunked.process(
+          gsl::span<const float>(samples.data() + position, count),
+          collectFrames(chunkedFrames));
+    }
+
+    SPECTREX_CHECK(chunkedFrames == wholeFrames);
+}
+
+} // namespace
+
+int
+main()
+{
+    testMethodsAgree();
+    testAutomaticMethod();
+    testChunking();
+    return 0;
+}
@@ -0,0 +1,75 @@
+#include <Spectrex/Analysis/SwappableStft.hpp>
+
+// Spectrex
+#include <Test.hpp>
+
+// Stdlib
+#include <tuple>
+#include <vector>
+
+using namespace spectrex;
+using namespace spectrex::test;
+
+namespace {
+
+/// Checks that a configuration is swapped in at a hop boundary, without
+/// interrupting the frames, and that the frames after the swap match those of
+/// a transform that had the new configuration all along.
+void
+testSwap()
+{
+    const size_t hop = 256;
+    const auto samples = makeNoise(48000, 0.5f, 2);
+    using Method = Stft::Method;
+    for (const auto& [oldSize, newSize, method] :
+         { std::tuple<size_t, size_t, Method>{ 2048, 1024, Method::Fft },
+           { 2048, 1024, Method::SlidingDft },
+           { 1024, 2048, Method::Fft },
+           { 1024, 2048, Method::SlidingDft } }) {
+        Stft reference(newSize, hop, 0, newSize / 2, Stft::Method::Fft);
+        Frames referenceFrames;
+        reference.process(samples, collectFrames(referenceFrames));
+
+        SwappableStft stft(oldSize, hop, 0, oldSize / 2, Stft::Method::Fft);
+        Frames frames;
+        size_t swapFrame = 0;
+        for (size_t position = 0; position < samples.size(); position += 333) {
+            if (position == 333 * 30) {
+                stft.configure(newSize, hop, 0, newSize / 2, method);
+                SPECTREX_CHECK(stft.isSwapPending());
+            }
+            const auto count = std::min<size_t>(333, samples.size() - position);
+            stft.process(
+              gsl::span<const float>(samples.data() + position, count),
+              [&](gsl::span<const float> magnitudes) {
+                  if (swapFrame == 0 && magnitudes.size() == newSize / 2 + 1) {
+                      swapFrame = frames.size();
+                  }
+                  frames.emplace_back(magnitudes.begin(), magnitudes.end());
+              });
+        }
+        stft.releaseRetired();
+
+        SPECTREX_CHECK(!stft.isSwapPending());
+        SPECTREX_CHECK(stft.getActive().getSize() == newSize);
+        SPECTREX_CHECK(frames.size() == referenceFrames.size());
+        SPECTREX_CHECK(swapFrame == 333 * 30 / hop + 1);
+
+        // A larger transform continues from the shorter history of the
+        // previous one, so its frames only match once it has seen a full
+        // window of its own
+        const auto firstFullFrame =
+          swapFrame + (newSize > oldSize ? newSize / hop : 0);
+        SPECTREX_CHECK(
+          getRelativeError(frames, referenceFrames, firstFullFrame) < 1e-5);
+    }
+}
+
+} // namespace
+
+int
+main()
+{
+    testSwap();
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include <Spectrex/Analysis/TableCache.hpp>
+
+// Spectrex
+#include <Test.hpp>
+
+// Stdlib
+#include <memory>
+
+using namespace spectrex;
+
+namespace {
+
+/// Checks that equal parameters share a table, that different parameters do
+/// not, and that the windows are periodic.
+void
+testSharing()
+{
+    const auto plan = TableCache::getFftPlan(1024);
+    SPECTREX_CHECK(plan->Size == 1024);
+    SPECTREX_CHECK(TableCache::getFftPlan(1024) == plan);
+    SPECTREX_CHECK(TableCache::getFftPlan(2048) != plan);
+
+    const auto hann = TableCache::getWindow(Window::WindowHann, 1024);
+    SPECTREX_CHECK(hann->size() == 1024);
+    SPECTREX_CHECK(TableCache::getWindow(Window::WindowHann, 1024) == hann);
+    SPECTREX_CHECK(TableCache::getWindow(Window::WindowHann, 512) != hann);
+    SPECTREX_CHECK(TableCache::getWindow(Window::WindowBlackman, 1024) !=
+                   hann);
+    SPECTREX_CHECK((*hann)[0] == 0.0f);
+    SPECTREX_CHECK(std::abs((*hann)[512] - 1.0f) < 1e-6f);
+    SPECTREX_CHECK(std::abs((*hann)[256] - (*hann)[768]) < 1e-6f);
+
+    const auto rectangular = TableCache::getWindow(Window::WindowNone, 64);
+    for (const auto coefficient : *rectangular) {
+        SPECTREX_CHECK(coefficient == 1.0f);
+    }
+
+    // Every built-in FFT of a size uses the same plan
+    const auto numTables = TableCache::getNumTables();
+    BuiltinFft first(4096);
+    BuiltinFft second(4096);
+    SPECTREX_CHECK(TableCache::getNumTables() == numTables + 1);
+}
+
+/// Checks that a table stays in the cache as long as any user holds it, and is
+/// released along with its last user.
+void
+testRelease()
+{
+    const auto numTables = TableCache::getNumTables();
+
+    auto plan = TableCache::getFftPlan(8192);
+    auto window = TableCache::getWindow(Window::WindowBlackman, 8192);
+    SPECTREX_CHECK(TableCache::getNumTables() == numTables + 2);
+
+    auto otherPlan = TableCache::getFftPlan(8192);
+    SPECTREX_CHECK(TableCache::getNumTables() == numTables + 2);
+    plan.reset();
+    SPECTREX_CHECK(TableCache::getNumTables() == numTables + 2);
+    otherPlan.reset();
+    SPECTREX_CHECK(TableCache::getNumTables() == numTables + 1);
+    window.reset();
+    SPECTREX_CHECK(TableCache::getNumTables() == numTables);
+
+    // Instances release their tables as well
+    auto fft = std::make_unique<BuiltinFft>(16384);
+    SPECTREX_CHECK(TableCache::getNumTables() == numTables + 1);
+    fft.reset();
+    SPECTREX_CHECK(TableCache::getNumTables() == numTables);
+
+    // A released table is built anew
+    plan = TableCache::getFftPlan(8192);
+    SPECTREX_CHECK(plan->Size == 8192);
+    SPECTREX_CHECK(TableCache::getNumTables() == numTables + 1);
+}
+
+} // namespace
+
+int
+main()
+{
+    testSharing();
+    testRelease();
+    return 0;
+}
@@ -0,0 +1,172 @@
+#include <Spectrex/Analysis/Vectorscope.hpp>
+
+// Spectrex
+#include <Test.hpp>
+
+// Stdlib
+#include <vector>
+
+using namespace spectrex;
+using namespace spectrex::test;
+
+namespace {
+
+using Mode = Vectorscope::Mode;
+
+/// Feeds a stereo pair to \a vectorscope, in odd chunks.
+void
+feed(Vectorscope& vectorscope,
+     const std::vector<float>& left,
+     const std::vector<float>& right)
+{
+    for (size_t position = 0; position < left.size(); position += 100) {
+        const auto count = std::min<size_t>(100, left.size() - position);
+        vectorscope.process(AudioChannelView(left).subspan(position, count),
+                            AudioChannelView(right).subspan(position, count));
+    }
+}
+
+/// Checks that the points stay within the budget at any sample rate, and that
+/// mono audio shows as a vertical line with a correlation of 1.
+void
+testPoints()
+{
+    for (const auto sampleRate : { 48000.0f, 192000.0f }) {
+        for (const auto simdLevel : { SimdLevel::Scalar, detectSimdLevel() }) {
+            Vectorscope vectorscope(
+              sampleRate, { Mode::Points, 2048, 128 }, simdLevel);
+            const auto mono =
+              makeSine((size_t)sampleRate, 440.0, sampleRate, 0.8);
+            feed(vectorscope, mono, mono);
+
+            vectorscope.syncPoints(
+              [&](const VectorscopeInfo& info,
+                  SyncInfo<const VectorscopePoint> first,
+                  std::optional<SyncInfo<const VectorscopePoint>> second) {
+                  SPECTREX_CHECK(first.Height + (second ? second->Height : 0) ==
+                                 2048);
+                  SPECTREX_CHECK(info.Decimation ==
+                                 (sampleRate > 96000.0f ? 4 : 1));
+                  SPECTREX_CHECK(2048 * info.Decimation >=
+                                 sampleRate / Vectorscope::k_frameRate);
+                  SPECTREX_CHECK(std::abs(info.Correlation - 1.0f) < 1e-3f);
+                  SPECTREX_CHECK(info.NumSamples == (size_t)sampleRate);
+
+                  float maxMid = 0.0f;
+                  for (size_t i = 0; i < first.Height; ++i) {
+                      SPECTREX_CHECK(first.Pointer[i].Side == 0.0f);
+                      maxMid = std::max(maxMid, std::abs(first.Pointer[i].Mid));
+                  }
+                  SPECTREX_CHECK(std::abs(maxMid - 0.8f) < 1e-3f);
+              });
+
+            // Not in density mode
+            bool called = false;
+            vectorscope.syncDensity(
+              [&](const VectorscopeInfo&, SyncInfo<const float>) {
+                  called = true;
+              });
+            SPECTREX_CHECK(!called);
+        }
+    }
+}
+
+/// Checks that the density adds up to about 1 once the history is filled, and
+/// that out of phase audio shows as a horizontal line with a correlation of
+/// -1.
+void
+testDensity()
+{
+    for (const auto sampleRate : { 48000.0f, 192000.0f }) {
+        for (const auto simdLevel : { SimdLevel::Scalar, detectSimdLevel() }) {
+            Vectorscope vectorscope(
+              sampleRate, { Mode::Density, 2048, 128 }, simdLevel);
+            const auto left =
+              makeSine((size_t)sampleRate, 440.0, sampleRate, 0.8);
+            auto right = left;
+            for (auto& sample : right) {
+                sample = -sample;
+            }
+            feed(vectorscope, left, right);
+
+            vectorscope.syncDensity(
+              [&](const VectorscopeInfo& info, SyncInfo<const float> cells) {
+                  SPECTREX_CHECK(cells.Width == 128 && cells.Height == 128);
+                  SPECTREX_CHECK(std::abs(info.Correlation + 1.0f) < 1e-3f);
+
+                  double total = 0.0;
+                  double middleRow = 0.0;
+                  for (size_t y = 0; y < cells.Height; ++y) {
+                      for (size_t x = 0; x < cells.Width; ++x) {
+                          const auto cell = cells.Pointer[y * cells.Width + x];
+                          total += cell;
+                          middleRow += y == cells.Height / 2 ? cell : 0.0f;
+                      }
+                  }
+                  SPECTREX_CHECK(std::abs(total * info.DensityScale - 1.0) <
+                                 0.02);
+                  SPECTREX_CHECK(middleRow == total);
+              });
+        }
+    }
+}
+
+/// Checks that uncorrelated audio reads a correlation of about 0, and that
+/// reset clears it.
+void
+testCorrelation()
+{
+    Vectorscope vectorscope(48000.0f, {});
+    feed(vectorscope, makeNoise(48000, 0.5f, 1), makeNoise(48000, 0.5f, 2));
+    SPECTREX_CHECK(std::abs(vectorscope.getInfo().Correlation) < 0.1f);
+
+    vectorscope.reset();
+    SPECTREX_CHECK(vectorscope.getInfo().Correlation == 0.0f);
+    SPECTREX_CHECK(vectorscope.getInfo().NumSamples == 0);
+}
+
+/// Prints the cost of processing partly correlated stereo noise, for every mode
+/// and instruction set.
+void
+benchmarkModes()
+{
+    const float sampleRate = 48000.0f;
+    const auto left = makeNoise((size_t)sampleRate, 0.5f, 1);
+    auto right = makeNoise(left.size(), 0.5f, 2);
+    for (size_t i = 0; i < right.size(); ++i) {
+        right[i] += 0.5f * left[i];
+    }
+
+    for (const auto mode : { Mode::Points, Mode::Density }) {
+        for (const auto simdLevel : { SimdLevel::Scalar, SimdLevel::Avx2 }) {
+            Vectorscope::Config config;
+            config.ReductionMode = mode;
+            Vectorscope vectorscope(sampleRate, config, simdLevel);
+            if (vectorscope.getSimdLevel() != simdLevel) {
+                continue;
+            }
+            const auto elapsed = measureNanosecondsPerSecond(
+              sampleRate, [&](size_t offset, size_t size) {
+                  vectorscope.process(
+                    AudioChannelView(left).subspan(offset, size),
+                    AudioChannelView(right).subspan(offset, size));
+              });
+            std::printf("%s %s: %.0f us per second of audio\n",
+                        mode == Mode::Density ? "density" : "points",
+                        simdLevel == SimdLevel::Avx2 ? "avx2" : "scalar",
+                        elapsed * 1e-3);
+        }
+    }
+}
+
+} // namespace
+
+int
+main()
+{
+    testPoints();
+    testDensity();
+    testCorrelation();
+    benchmarkModes();
+    return 0;
+}
@@ -0,0 +1,270 @@
+#include <Spectrex/Analysis/WaveformPyramid.hpp>
+
+// Spectrex
+#include <Test.hpp>
+
+// Stdlib
+#include <vector>
+
+using namespace spectrex;
+using namespace spectrex::test;
+
+namespace {
+
+using FrequencyMode = WaveformPyramid::FrequencyMode;
+
+/// Returns bin \a index of synchronized bins split in two.
+template<typename T>
+auto
+getBin(SyncInfo<const T> first,
+       const std::optional<SyncInfo<const T>>& second,
+       size_t index) -> const T&
+{
+    if (index >= first.RowIndex && index < first.RowIndex + first.Height) {
+        return first.Pointer[index - first.RowIndex];
+    }
+    SPECTREX_CHECK(second && index >= second->RowIndex &&
+                   index < second->RowIndex + second->Height);
+    return second->Pointer[index - second->RowIndex];
+}
+
+/// Returns a sine of increasing amplitude, so every bin has its own min/max.
+auto
+makeRamp(size_t numSamples, float sampleRate) -> std::vector<float>
+{
+    auto samples = makeSine(numSamples, 440.0, sampleRate);
+    for (size_t i = 0; i < numSamples; ++i) {
+        samples[i] *= 0.2f + 0.7f * (float)(i % 48000) / 48000.0f;
+    }
+    return samples;
+}
+
+/// Checks the min/max of every complete bin in the history of every level
+/// against the samples, once the history has wrapped around.
+void
+testMinMax()
+{
+    const float sampleRate = 48000.0f;
+    const auto samples = makeRamp(12 * 48000, sampleRate);
+    for (const size_t factor : { 2, 4 }) {
+        WaveformPyramid pyramid(sampleRate, 8.0, factor);
+        SPECTREX_CHECK(pyramid.getFactor() == factor);
+        for (size_t position = 0; position < samples.size(); position += 37) {
+            const auto count = std::min<size_t>(37, samples.size() - position);
+            pyramid.process(
+              gsl::span<const float>(samples.data() + position, count));
+        }
+
+        for (size_t level = 0; level < pyramid.getNumLevels(); ++level) {
+            pyramid.sync(
+              level,
+              [&](const WaveformPyramidInfo& info,
+                  SyncInfo<const WaveformBin> first,
+                  std::optional<SyncInfo<const WaveformBin>> second) {
+                  SPECTREX_CHECK(info.NumSamples == samples.size());
+                  SPECTREX_CHECK(first.RowIndex + first.Height +
+                                   (second ? second->Height : 0) ==
+                                 info.EndBin);
+                  SPECTREX_CHECK(info.BinSize * info.Capacity >= 8 * 48000);
+
+                  const auto completeEnd = samples.size() / info.BinSize;
+                  for (auto bin = first.RowIndex; bin < completeEnd; ++bin) {
+                      const auto begin = samples.begin() + bin * info.BinSize;
+                      const auto [min, max] =
+                        std::minmax_element(begin, begin + info.BinSize);
+                      const auto& actual = getBin(first, second, bin);
+                      SPECTREX_CHECK(actual.Min == *min);
+                      SPECTREX_CHECK(actual.Max == *max);
+                  }
+              });
+        }
+    }
+}
+
+/// Checks that the vectorized kernels produce the same bins and band bins as
+/// the scalar ones, for every frequency estimate.
+void
+testKernelsAgree()
+{
+    const float sampleRate = 48000.0f;
+    auto samples = makeSine(2 * 48000, 440.0, sampleRate, 0.5);
+    const auto noise = makeNoise(samples.size(), 0.3f, 3);
+    for (size_t i = samples.size() / 2; i < samples.size(); ++i) {
+        samples[i] += noise[i];
+    }
+
+    for (const auto mode : { FrequencyMode::None,
+                             FrequencyMode::ZeroCrossing,
+                             FrequencyMode::SpectralCentroid }) {
+        WaveformPyramid scalar(sampleRate, 4.0, 2, mode, SimdLevel::Scalar,
+                               WaveformPyramid::Crossover{});
+        WaveformPyramid vectorized(sampleRate, 4.0, 2, mode, detectSimdLevel(),
+                                   WaveformPyramid::Crossover{});
+        scalar.process(samples);
+        vectorized.process(samples);
+
+        scalar.sync(0, [&](const WaveformPyramidInfo&,
+                           SyncInfo<const WaveformBin> expected,
+                           std::optional<SyncInfo<const WaveformBin>>) {
+            vectorized.sync(0, [&](const WaveformPyramidInfo&,
+                                   SyncInfo<const WaveformBin> actual,
+                                   std::optional<SyncInfo<const WaveformBin>>) {
+                SPECTREX_CHECK(actual.Height == expected.Height);
+                for (size_t i = 0; i < actual.Height; ++i) {
+                    const auto& a = actual.Pointer[i];
+                    const auto& e = expected.Pointer[i];
+                    SPECTREX_CHECK(a.Min == e.Min && a.Max == e.Max);
+                    SPECTREX_CHECK(std::abs(a.Frequency - e.Frequency) <=
+                                   1e-4f * std::max(1.0f, e.Frequency));
+                }
+            });
+        });
+
+        using BandBins = SyncInfo<const WaveformBandBin>;
+        scalar.syncBands(0, [&](const WaveformPyramidInfo&,
+                                BandBins expected,
+                                std::optional<BandBins>) {
+            vectorized.syncBands(
+              0,
+              [&](const WaveformPyramidInfo&,
+                  BandBins actual,
+                  std::optional<BandBins>) {
+                  SPECTREX_CHECK(actual.Height == expected.Height);
+                  for (size_t i = 0; i < actual.Height; ++i) {
+                      const auto& a = actual.Pointer[i];
+                      const auto& e = expected.Pointer[i];
+                      SPECTREX_CHECK(std::abs(a.Low - e.Low) < 1e-4f);
+                      SPECTREX_CHECK(std::abs(a.Mid - e.Mid) < 1e-4f);
+                      SPECTREX_CHECK(std::abs(a.High - e.High) < 1e-4f);
+                  }
+              });
+        });
+    }
+}
+
+/// Returns the frequency estimate of the newest complete bin of a level.
+auto
+getFrequency(const WaveformPyramid& pyramid, size_t level) -> float
+{
+    float frequency = 0.0f;
+    pyramid.sync(level,
+                 [&](const WaveformPyramidInfo& info,
+                     SyncInfo<const WaveformBin> first,
+                     std::optional<SyncInfo<const WaveformBin>> second) {
+                     const auto& bin = getBin(first, second, info.EndBin - 2);
+                     frequency = bin.Frequency;
+                 });
+    return frequency;
+}
+
+/// Checks the frequency estimates of tones. The spectral centroid of the short
+/// DFT is coarse for low tones, but increases with the frequency.
+void
+testFrequency()
+{
+    const float sampleRate = 48000.0f;
+    float previousCentroid = 0.0f;
+    for (const auto frequency : { 100.0, 440.0, 1000.0, 5000.0 }) {
+        const auto samples = makeSine(48000, frequency, sampleRate, 0.5);
+
+        WaveformPyramid zeroCrossing(sampleRate, 2.0, 2);
+        zeroCrossing.process(samples);
+        SPECTREX_CHECK(std::abs(getFrequency(zeroCrossing, 4) - frequency) <
+                       0.01 * frequency);
+
+        WaveformPyramid centroid(sampleRate, 2.0, 2,
+                                 FrequencyMode::SpectralCentroid);
+        centroid.process(samples);
+        const auto estimate = getFrequency(centroid, 4);
+        SPECTREX_CHECK(estimate > previousCentroid);
+        previousCentroid = estimate;
+
+        WaveformPyramid none(sampleRate, 2.0, 2, FrequencyMode::None);
+        none.process(samples);
+        SPECTREX_CHECK(getFrequency(none, 4) == 0.0f);
+    }
+    SPECTREX_CHECK(std::abs(previousCentroid - 5000.0f) < 100.0f);
+}
+
+/// Checks that tones land in their band, at the RMS of a sine.
+void
+testBands()
+{
+    const float sampleRate = 48000.0f;
+    for (const auto& [frequency, band] :
+         { std::pair<double, int>{ 60.0, 0 }, { 800.0, 1 }, { 8000.0, 2 } }) {
+        WaveformPyramid pyramid(sampleRate, 2.0, 2, FrequencyMode::None,
+                                detectSimdLevel(),
+                                WaveformPyramid::Crossover{});
+        SPECTREX_CHECK(pyramid.hasBands());
+        pyramid.process(makeSine(48000, frequency, sampleRate));
+
+        pyramid.syncBands(
+          8,
+          [&](const WaveformPyramidInfo& info,
+              SyncInfo<const WaveformBandBin> first,
+              std::optional<SyncInfo<const WaveformBandBin>> second) {
+              const auto& bin = getBin(first, second, info.EndBin - 2);
+              const float energies[] = { bin.Low, bin.Mid, bin.High };
+              for (int b = 0; b < 3; ++b) {
+                  if (b == band) {
+                      SPECTREX_CHECK(std::abs(energies[b] - 0.7071f) < 0.03f);
+                  } else {
+                      SPECTREX_CHECK(energies[b] < 0.03f);
+                  }
+              }
+          });
+    }
+}
+
+/// Prints the cost of processing a noisy tone, for every frequency estimate and
+/// instruction set, without and with band energies.
+void
+benchmarkModes()
+{
+    const float sampleRate = 48000.0f;
+    auto samples = makeSine((size_t)sampleRate, 440.0, sampleRate, 0.5);
+    const auto noise = makeNoise(samples.size(), 0.1f, 4);
+    for (size_t i = 0; i < samples.size(); ++i) {
+        samples[i] += noise[i];
+    }
+
+    for (const auto mode : { FrequencyMode::None,
+                             FrequencyMode::ZeroCrossing,
+                             FrequencyMode::SpectralCentroid }) {
+        for (const auto simdLevel : { SimdLevel::Scalar, SimdLevel::Avx2 }) {
+            for (const auto bands : { false, true }) {
+                WaveformPyramid pyramid(
+                  sampleRate, 1.0, 2, mode, simdLevel,
+                  bands ? std::optional(WaveformPyramid::Crossover{})
+                        : std::nullopt);
+                if (pyramid.getSimdLevel() != simdLevel) {
+                    continue;
+                }
+                const auto elapsed = measureNanosecondsPerSecond(
+                  sampleRate, [&](size_t offset, size_t size) {
+                      pyramid.process(
+                        gsl::span<const float>(samples).subspan(offset, size));
+                  });
+                std::printf("Mode %d %s%s: %.0f us per second of audio\n",
+                            (int)mode,
+                            simdLevel == SimdLevel::Avx2 ? "avx2" : "scalar",
+                            bands ? " with bands" : "",
+                            elapsed * 1e-3);
+            }
+        }
+    }
+}
+
+} // namespace
+
+int
+main()
+{
+    testMinMax();
+    testKernelsAgree();
+    testFrequency();
+    testBands();
+    benchmarkModes();
+    return 0;
+}
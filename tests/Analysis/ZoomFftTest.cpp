@@ -0,0 +1,100 @@
+#include <Spectrex/Analysis/ZoomFft.hpp>
+
+// Spectrex
+#include <Spectrex/Analysis/FrequencyBand.hpp>
+#include <Test.hpp>
+
+// Stdlib
+#include <vector>
+
+using namespace spectrex;
+using namespace spectrex::test;
+
+namespace {
+
+/// Component exposing a frequency range, as KComponent does.
+struct Component
+{
+    float MinFrequency = 0.0f;
+    float MaxFrequency = 0.0f;
+
+    auto getMinFrequency() const -> float { return MinFrequency; }
+    auto getMaxFrequency() const -> float { return MaxFrequency; }
+};
+
+/// Checks the band required by components and its decimation.
+void
+testRequiredBand()
+{
+    const Component low{ 20.0f, 300.0f };
+    const Component mid{ 100.0f, 500.0f };
+    const std::vector<const Component*> components{ &low, &mid };
+
+    const auto band = getRequiredBand(components);
+    SPECTREX_CHECK(band.MinFrequency == 20.0f);
+    SPECTREX_CHECK(band.MaxFrequency == 500.0f);
+    SPECTREX_CHECK(ZoomFft::getDecimation(48000.0, band) == 32);
+    SPECTREX_CHECK(ZoomFft::getDecimation(48000.0, { 0.0f, 24000.0f }) == 1);
+}
+
+/// Checks that tones within the band show up at their frequency, at the
+/// resolution of a full band FFT 32 times the size, and that a strong tone
+/// outside of the band is rejected.
+void
+testResolution()
+{
+    const double sampleRate = 48000.0;
+    const size_t size = 1024;
+    ZoomFft zoomFft(sampleRate, { 20.0f, 500.0f }, size, 512);
+    SPECTREX_CHECK(zoomFft.getDecimation() == 32);
+    SPECTREX_CHECK(std::abs(zoomFft.getResolution() - 1.46484375) < 1e-9);
+    SPECTREX_CHECK(zoomFft.getBinFrequency(0) >=
+                   20.0 - zoomFft.getResolution());
+    SPECTREX_CHECK(zoomFft.getBinFrequency(zoomFft.getNumBins() - 1) <=
+                   500.0 + zoomFft.getResolution());
+
+    const size_t numSamples = 4 * 48000;
+    auto samples = makeSine(numSamples, 200.3, sampleRate);
+    const auto close = makeSine(numSamples, 207.0, sampleRate, 0.5);
+    const auto outside = makeSine(numSamples, 5000.0, sampleRate, 0.8);
+    for (size_t i = 0; i < numSamples; ++i) {
+        samples[i] += close[i] + outside[i];
+    }
+
+    Frames frames;
+    zoomFft.process(samples, collectFrames(frames));
+    SPECTREX_CHECK(frames.size() == numSamples / zoomFft.getHop());
+
+    // A full scale tone reads about size / 4 with a Hann window
+    const auto& frame = frames.back();
+    const auto peak = getPeak(frame);
+    SPECTREX_CHECK(std::abs(zoomFft.getBinFrequency(peak) - 200.3) <
+                   zoomFft.getResolution());
+    SPECTREX_CHECK(frame[peak] > 0.9f * (float)size / 4.0f);
+
+    // The tone 6.7 Hz away is resolved as a separate peak
+    size_t closePeak = peak + 3;
+    for (size_t k = peak + 3; k < peak + 7; ++k) {
+        closePeak = frame[k] > frame[closePeak] ? k : closePeak;
+    }
+    SPECTREX_CHECK(std::abs(zoomFft.getBinFrequency(closePeak) - 207.0) <
+                   zoomFft.getResolution());
+    SPECTREX_CHECK(frame[closePeak] > frame[closePeak - 2]);
+
+    // Far from both tones, only the leakage of the filtered 5 kHz tone remains
+    for (size_t k = 0; k < frame.size(); ++k) {
+        if (std::abs(zoomFft.getBinFrequency(k) - 203.0) > 30.0) {
+            SPECTREX_CHECK(frame[k] < 1e-2f * frame[peak]);
+        }
+    }
+}
+
+} // namespace
+
+int
+main()
+{
+    testRequiredBand();
+    testResolution();
+    return 0;
+}
@@ -0,0 +1,131 @@
+#include <Spectrex/AnalysisScheduler.hpp>
+
+// Spectrex
+#include <Test.hpp>
+
+// Stdlib
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace spectrex;
+
+namespace {
+
+/// Number of workers of the scheduler, set explicitly so the test does not
+/// depend on the number of cores.
+constexpr int k_numWorkers = 4;
+
+/// Task with a number of pending blocks, each taking some time to process,
+/// that tracks how many tasks are processed at once.
+class CountingTask final : public AnalysisTask
+{
+  public:
+    auto hasPendingBlocks() noexcept -> bool override
+    {
+        return m_numPendingBlocks > 0;
+    }
+
+    auto processPendingBlocks(int maxBlocks) noexcept -> int override
+    {
+        // Never processed by two workers at once
+        SPECTREX_CHECK(++m_numProcessing == 1);
+
+        const auto numActive = ++m_numActive;
+        auto maxNumActive = m_maxNumActive.load();
+        while (numActive > maxNumActive &&
+               !m_maxNumActive.compare_exchange_weak(maxNumActive, numActive)) {
+        }
+
+        const auto numBlocks = std::min(maxBlocks, m_numPendingBlocks.load());
+        std::this_thread::sleep_for(std::chrono::milliseconds(2) * numBlocks);
+        m_numPendingBlocks -= numBlocks;
+
+        --m_numActive;
+        --m_numProcessing;
+        return numBlocks;
+    }
+
+    CountingTask(std::atomic<int>& numActive, std::atomic<int>& maxNumActive)
+      : m_numActive(numActive)
+      , m_maxNumActive(maxNumActive)
+    {
+    }
+
+    std::atomic<int> m_numPendingBlocks = 0;
+
+  private:
+    std::atomic<int> m_numProcessing = 0;
+    std::atomic<int>& m_numActive;
+    std::atomic<int>& m_maxNumActive;
+};
+
+/// Makes a few blocks pending on as many tasks as there are workers at once,
+/// fewer than a turn each, and checks that a single notify has them processed
+/// in parallel, as an audio callback feeding every channel group does. A busy
+/// machine may delay a worker past the others, so every round only requires
+/// some parallelism, and rounds are repeated (up to a bound) until all workers
+/// have been seen active at once.
+void
+testParallel()
+{
+    AnalysisScheduler::setNumWorkers(k_numWorkers);
+    const auto scheduler = AnalysisScheduler::getInstance();
+    SPECTREX_CHECK(scheduler->getNumWorkers() == k_numWorkers);
+
+    std::atomic<int> numActive = 0;
+    std::atomic<int> maxNumActive = 0;
+    std::vector<std::unique_ptr<CountingTask>> tasks;
+    for (int t = 0; t < k_numWorkers; ++t) {
+        tasks.push_back(
+          std::make_unique<CountingTask>(numActive, maxNumActive));
+        scheduler->addTask(*tasks.back());
+    }
+
+    constexpr int minNumRounds = 10;
+    constexpr int maxNumRounds = 100;
+    int maxNumActiveSeen = 0;
+    for (int round = 0;
+         round < minNumRounds ||
+         (maxNumActiveSeen < k_numWorkers && round < maxNumRounds);
+         ++round) {
+        // Let the workers go idle
+        std::this_thread::sleep_for(
+          std::chrono::milliseconds(2 * AnalysisScheduler::k_workerTimeoutMs));
+
+        maxNumActive = 0;
+        for (auto& task : tasks) {
+            task->m_numPendingBlocks = 4;
+        }
+        scheduler->notify();
+
+        // A single worker takes four times as long as the workers together
+        const auto start = std::chrono::steady_clock::now();
+        for (auto& task : tasks) {
+            while (task->hasPendingBlocks()) {
+                SPECTREX_CHECK(std::chrono::steady_clock::now() - start <
+                               std::chrono::seconds(5));
+                std::this_thread::yield();
+            }
+        }
+        SPECTREX_CHECK(maxNumActive > 1);
+        maxNumActiveSeen = std::max(maxNumActiveSeen, maxNumActive.load());
+    }
+    SPECTREX_CHECK(maxNumActiveSeen == k_numWorkers);
+
+    for (auto& task : tasks) {
+        scheduler->removeTask(*task);
+    }
+}
+
+} // namespace
+
+int
+main()
+{
+    testParallel();
+    return 0;
+}
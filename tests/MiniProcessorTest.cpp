@@ -0,0 +1,472 @@
+#include <Spectrex/MiniProcessor.hpp>
+
+// Spectrex
+#include <Spectrex/Processing/Processor.hpp>
+#include <Test.hpp>
+
+// Stdlib
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <new>
+#include <optional>
+#include <thread>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+using namespace spectrex;
+using namespace spectrex::test;
+
+namespace {
+
+/// Whether or not allocations on this thread are counted.
+thread_local bool t_countAllocations = false;
+
+/// Number of counted allocations.
+std::atomic<size_t> s_numAllocations = 0;
+
+/// Counts an allocation whenever counting is enabled on this thread.
+void
+countAllocation() noexcept
+{
+    if (t_countAllocations) {
+        ++s_numAllocations;
+    }
+}
+
+} // namespace
+
+// Replacing the global (aligned) operator new replaces every form of it,
+// including the array and the non-throwing ones
+auto
+operator new(size_t size) -> void*
+{
+    countAllocation();
+    if (auto* pointer = std::malloc(size == 0 ? 1 : size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+auto
+operator new(size_t size, std::align_val_t alignment) -> void*
+{
+    countAllocation();
+    const auto align = std::max(sizeof(void*), (size_t)alignment);
+    void* pointer = nullptr;
+#ifdef _WIN32
+    pointer = _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+    if (posix_memalign(&pointer, align, size == 0 ? 1 : size) != 0) {
+        pointer = nullptr;
+    }
+#endif
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void
+operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void
+operator delete(void* pointer, size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void
+operator delete(void* pointer, std::align_val_t) noexcept
+{
+#ifdef _WIN32
+    _aligned_free(pointer);
+#else
+    std::free(pointer);
+#endif
+}
+
+void
+operator delete(void* pointer, size_t, std::align_val_t alignment) noexcept
+{
+    operator delete(pointer, alignment);
+}
+
+namespace spectrex {
+
+/// Drives the processing side of a MiniProcessor on the calling thread.
+struct MiniProcessorTestAccess
+{
+    /// Number of samples per channel the audio transport holds.
+    static constexpr auto k_transportSize =
+      (int64_t)MiniProcessor::k_ringBufferElements *
+      KProcessor::getExpectedBlockSize();
+
+    /// Stops the processing thread of a processor using
+    /// ThreadingMode::DedicatedThread, so that it is only processed by
+    /// processPendingBlocks.
+    static void stopProcessingThread(MiniProcessor& processor)
+    {
+        processor.m_processingThread.reset();
+    }
+
+    /// Processes all pending processing blocks of every channel group.
+    static void processPendingBlocks(MiniProcessor& processor)
+    {
+        for (auto& channelGroup : processor.m_channelGroups) {
+            channelGroup->processPendingBlocks(
+              std::numeric_limits<int>::max());
+        }
+    }
+};
+
+} // namespace spectrex
+
+namespace {
+
+/// Checks that processBlock does not allocate at any host block size, with
+/// every side analysis enabled, note ons in some blocks, and as many input
+/// channels as channel groups. Allocations are only counted on the audio
+/// thread, the processing thread may allocate freely.
+void
+testNoAllocation(int numChannels, MiniProcessor::ThreadingMode threadingMode)
+{
+    for (const int blockSize : { 32, 512, 1024, 4096 }) {
+        const double sampleRate = 48000.0;
+        MiniProcessor processor(threadingMode, numChannels);
+        processor.setWaveformPyramid(8.0);
+        processor.setWaveformBands(true);
+        processor.setLoudnessMeter(true);
+        processor.setVectorscope(true);
+        processor.prepareToPlay(sampleRate, blockSize);
+
+        juce::AudioSampleBuffer buffer(numChannels, blockSize);
+        const auto noise = makeNoise((size_t)blockSize, 0.5f);
+        for (int c = 0; c < numChannels; ++c) {
+            buffer.copyFrom(c, 0, noise.data(), blockSize);
+        }
+
+        juce::MidiBuffer noMidi;
+        juce::MidiBuffer noteOn;
+        noteOn.addEvent(juce::MidiMessage::noteOn(1, 60, 1.0f), blockSize / 2);
+
+        // About two seconds of audio, which fills up the transport unless the
+        // processing thread keeps up, so dropped blocks are covered as well
+        const auto numBlocks = (int)(2.0 * sampleRate) / blockSize;
+        s_numAllocations = 0;
+        for (int b = 0; b < numBlocks; ++b) {
+            auto& midi = b % 7 == 0 ? noteOn : noMidi;
+
+            t_countAllocations = true;
+            processor.processBlock(nullptr, buffer, midi);
+            t_countAllocations = false;
+        }
+
+        if (s_numAllocations != 0) {
+            std::fprintf(stderr,
+                         "%zu allocations at %d channels, %d samples\n",
+                         s_numAllocations.load(), numChannels, blockSize);
+        }
+        SPECTREX_CHECK(s_numAllocations == 0);
+    }
+}
+
+/// Feeds independent noise of a distinct amplitude to every input channel,
+/// and checks that getProcessorForChannel maps the channels onto stereo
+/// channel groups, that the groups are analyzed by the shared scheduler, that
+/// every channel ends up in the side analyses of its own group and that the
+/// single channel of an incomplete group is mirrored.
+void
+testChannelGroups(int numChannels)
+{
+    const double sampleRate = 48000.0;
+    const int blockSize = 512;
+    MiniProcessor processor(MiniProcessor::ThreadingMode::SharedScheduler,
+                            numChannels);
+    processor.setWaveformPyramid(8.0);
+    processor.setVectorscope(true);
+    processor.prepareToPlay(sampleRate, blockSize);
+
+    const auto numChannelGroups = (size_t)(numChannels + 1) / 2;
+    SPECTREX_CHECK(processor.getNumChannelGroups() == numChannelGroups);
+    for (int c = 0; c < numChannels; ++c) {
+        const auto [channelProcessor, channel] =
+          processor.getProcessorForChannel(c);
+        SPECTREX_CHECK(&channelProcessor ==
+                       &processor.getProcessor((size_t)c / 2));
+        SPECTREX_CHECK(channel == (c % 2 == 0 ? Left : Right));
+    }
+
+    // About a second of audio, which fits in the transport
+    const auto getAmplitude = [](int c) { return 0.1f * (float)(c + 1); };
+    const int numBlocks = (int)sampleRate / blockSize;
+    juce::AudioSampleBuffer buffer(numChannels, blockSize);
+    juce::MidiBuffer noMidi;
+    for (int b = 0; b < numBlocks; ++b) {
+        for (int c = 0; c < numChannels; ++c) {
+            const auto noise =
+              makeNoise((size_t)blockSize,
+                        getAmplitude(c),
+                        (unsigned)(b * numChannels + c + 1));
+            buffer.copyFrom(c, 0, noise.data(), blockSize);
+        }
+        processor.processBlock(nullptr, buffer, noMidi);
+    }
+
+    // Wait for the workers to analyze every channel
+    const auto numSamples = (size_t)(numBlocks * blockSize);
+    const auto start = std::chrono::steady_clock::now();
+    for (int c = 0; c < numChannels; ++c) {
+        while (processor.getVectorscopeInfo(c).NumSamples < numSamples) {
+            SPECTREX_CHECK(std::chrono::steady_clock::now() - start <
+                           std::chrono::seconds(10));
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    for (int c = 0; c < numChannels; ++c) {
+        float peak = 0.0f;
+        size_t numPyramidSamples = 0;
+        processor.syncWaveformPyramid(
+          c,
+          1.0,
+          [&](const WaveformPyramidInfo& info,
+              SyncInfo<const WaveformBin> first,
+              std::optional<SyncInfo<const WaveformBin>> second) {
+              numPyramidSamples = info.NumSamples;
+              for (const auto& bins : { std::optional(first), second }) {
+                  for (size_t i = 0; bins && i < bins->Height; ++i) {
+                      peak = std::max(
+                        { peak, bins->Pointer[i].Max, -bins->Pointer[i].Min });
+                  }
+              }
+          });
+        SPECTREX_CHECK(numPyramidSamples == numSamples);
+        SPECTREX_CHECK(peak <= getAmplitude(c));
+        SPECTREX_CHECK(peak > 0.99f * getAmplitude(c));
+
+        // Independent channels are uncorrelated, whereas a mirrored channel
+        // is fully correlated with itself
+        const auto correlation = processor.getVectorscopeInfo(c).Correlation;
+        if (c + 1 < numChannels || c % 2 == 1) {
+            SPECTREX_CHECK(std::abs(correlation) < 0.1f);
+        } else {
+            SPECTREX_CHECK(correlation > 0.99f);
+        }
+    }
+}
+
+/// Sets an idle timeout and checks that the blocks nobody consumes are skipped,
+/// that consuming only the side analyses feeds them but not the processors,
+/// and that the processors analyze again once consumed.
+void
+testIdleTimeout()
+{
+    using AnalysisKind = MiniProcessor::AnalysisKind;
+
+    const double sampleRate = 48000.0;
+    const int blockSize = 512;
+    MiniProcessor processor(MiniProcessor::ThreadingMode::DedicatedThread, 2);
+    processor.setVectorscope(true);
+    processor.setIdleTimeout(0.05);
+    processor.prepareToPlay(sampleRate, blockSize);
+
+    juce::AudioSampleBuffer buffer(2, blockSize);
+    const auto noise = makeNoise((size_t)blockSize, 0.5f);
+    for (int c = 0; c < 2; ++c) {
+        buffer.copyFrom(c, 0, noise.data(), blockSize);
+    }
+    juce::MidiBuffer noMidi;
+
+    const int numBlocks = 16;
+    const auto numSamples = (uint64_t)(numBlocks * blockSize);
+    const auto feed = [&] {
+        for (int b = 0; b < numBlocks; ++b) {
+            processor.processBlock(nullptr, buffer, noMidi);
+        }
+    };
+    const auto waitFor = [](auto&& condition) {
+        const auto start = std::chrono::steady_clock::now();
+        while (!condition()) {
+            SPECTREX_CHECK(std::chrono::steady_clock::now() - start <
+                           std::chrono::seconds(10));
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    };
+
+    // Nothing was consumed for longer than the idle timeout
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    SPECTREX_CHECK(!processor.isAnalysisActive(AnalysisKind::Processors));
+    SPECTREX_CHECK(!processor.isAnalysisActive(AnalysisKind::SideAnalyses));
+    feed();
+    waitFor([&] {
+        return processor.getDemandStatistics().SkippedSamples == numSamples;
+    });
+    SPECTREX_CHECK(processor.getDemandStatistics().AnalyzedSamples == 0);
+
+    // Only the side analyses are consumed, the processors keep skipping
+    processor.addConsumer(AnalysisKind::SideAnalyses);
+    SPECTREX_CHECK(processor.getVectorscopeInfo(0).NumSamples == 0);
+    feed();
+    waitFor([&] {
+        return processor.getDemandStatistics().SkippedSamples ==
+               2 * numSamples;
+    });
+    SPECTREX_CHECK(processor.getVectorscopeInfo(0).NumSamples == numSamples);
+    SPECTREX_CHECK(!processor.isAnalysisActive(AnalysisKind::Processors));
+    SPECTREX_CHECK(processor.getDemandStatistics().AnalyzedSamples == 0);
+
+    // The processors are consumed again, and prepared anew
+    processor.addConsumer(AnalysisKind::Processors);
+    feed();
+    waitFor([&] {
+        return processor.getDemandStatistics().AnalyzedSamples == numSamples;
+    });
+    SPECTREX_CHECK(processor.getDemandStatistics().SkippedSamples ==
+                   2 * numSamples);
+    SPECTREX_CHECK(processor.getProcessor().isValid());
+    SPECTREX_CHECK(processor.getProcessor().getParameter<float>(
+                     ProcessorParameters::Key::SampleRate) ==
+                   (float)sampleRate);
+
+    processor.removeConsumer(AnalysisKind::Processors);
+    processor.removeConsumer(AnalysisKind::SideAnalyses);
+}
+
+/// Keeps feeding audio while a synchronization handler holds the side
+/// analyses, longer than the processing thread can hold back their samples,
+/// and checks that every sample still ends up in the side analyses once the
+/// handler returns.
+void
+testSlowConsumer()
+{
+    const double sampleRate = 48000.0;
+    const int blockSize = 512;
+    MiniProcessor processor(MiniProcessor::ThreadingMode::DedicatedThread, 2);
+    processor.setWaveformPyramid(8.0);
+    processor.setVectorscope(true);
+    processor.prepareToPlay(sampleRate, blockSize);
+
+    juce::AudioSampleBuffer buffer(2, blockSize);
+    const auto noise = makeNoise((size_t)blockSize, 0.5f);
+    for (int c = 0; c < 2; ++c) {
+        buffer.copyFrom(c, 0, noise.data(), blockSize);
+    }
+    juce::MidiBuffer noMidi;
+
+    // Twice as many samples as the processing thread holds back
+    const int numBlocks = 64;
+    processor.syncWaveformPyramid(
+      0,
+      1.0,
+      [&](const WaveformPyramidInfo&,
+          SyncInfo<const WaveformBin>,
+          std::optional<SyncInfo<const WaveformBin>>) {
+          for (int b = 0; b < numBlocks; ++b) {
+              processor.processBlock(nullptr, buffer, noMidi);
+              std::this_thread::sleep_for(std::chrono::milliseconds(1));
+          }
+      });
+
+    const auto numSamples = (size_t)(numBlocks * blockSize);
+    const auto start = std::chrono::steady_clock::now();
+    while (processor.getVectorscopeInfo(0).NumSamples < numSamples) {
+        SPECTREX_CHECK(std::chrono::steady_clock::now() - start <
+                       std::chrono::seconds(10));
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    SPECTREX_CHECK(processor.getVectorscopeInfo(0).NumSamples == numSamples);
+
+    size_t numPyramidSamples = 0;
+    processor.syncWaveformPyramid(
+      1,
+      1.0,
+      [&](const WaveformPyramidInfo& info,
+          SyncInfo<const WaveformBin>,
+          std::optional<SyncInfo<const WaveformBin>>) {
+          numPyramidSamples = info.NumSamples;
+      });
+    SPECTREX_CHECK(numPyramidSamples == numSamples);
+}
+
+/// Returns the cost of the processing side at a batch size in nanoseconds per
+/// second of audio. Ten seconds of stereo noise are written in host blocks,
+/// then analyzed on the calling thread whenever the audio transport is about
+/// to fill up, so only the analysis and the per batch bookkeeping are timed,
+/// and no block is dropped at any sample rate.
+auto
+measureProcessingBlockSize(int processingBlockSize,
+                           int hostBlockSize = 512,
+                           double sampleRate = 48000.0) -> double
+{
+    constexpr int numSeconds = 10;
+
+    juce::AudioSampleBuffer buffer(2, hostBlockSize);
+    for (int c = 0; c < 2; ++c) {
+        const auto noise =
+          makeNoise((size_t)hostBlockSize, 0.5f, (unsigned)(c + 1));
+        buffer.copyFrom(c, 0, noise.data(), hostBlockSize);
+    }
+    juce::MidiBuffer noMidi;
+
+    MiniProcessor processor(MiniProcessor::ThreadingMode::DedicatedThread, 2);
+    MiniProcessorTestAccess::stopProcessingThread(processor);
+    processor.setProcessingBlockSize(processingBlockSize);
+    processor.prepareToPlay(sampleRate, hostBlockSize);
+
+    double elapsed = 0.0;
+    const auto numSamples = (int64_t)(numSeconds * sampleRate);
+    int64_t numWrittenSamples = 0;
+    int64_t numPendingSamples = 0;
+    while (numWrittenSamples < numSamples) {
+        if (numPendingSamples + hostBlockSize >
+            MiniProcessorTestAccess::k_transportSize) {
+            elapsed += measureNanoseconds([&] {
+                MiniProcessorTestAccess::processPendingBlocks(processor);
+            });
+            numPendingSamples = 0;
+        }
+        processor.processBlock(nullptr, buffer, noMidi);
+        numWrittenSamples += hostBlockSize;
+        numPendingSamples += hostBlockSize;
+    }
+    elapsed += measureNanoseconds(
+      [&] { MiniProcessorTestAccess::processPendingBlocks(processor); });
+
+    return elapsed / ((double)numWrittenSamples / sampleRate);
+}
+
+/// Prints the cost of the processing side at every batch size.
+void
+benchmarkProcessingBlockSize()
+{
+    for (int size = MiniProcessor::k_minProcessingBlockSize;
+         size <= MiniProcessor::k_maxProcessingBlockSize;
+         size *= 2) {
+        std::printf("Batch size %d: %.2f ms per second of audio\n", size,
+                    measureProcessingBlockSize(size) * 1e-6);
+    }
+}
+
+} // namespace
+
+int
+main()
+{
+    using ThreadingMode = MiniProcessor::ThreadingMode;
+
+    testNoAllocation(2, ThreadingMode::DedicatedThread);
+    testNoAllocation(1, ThreadingMode::DedicatedThread);
+    testNoAllocation(8, ThreadingMode::SharedScheduler);
+    testChannelGroups(8);
+    testChannelGroups(7);
+    testIdleTimeout();
+    testSlowConsumer();
+    benchmarkProcessingBlockSize();
+    return 0;
+}
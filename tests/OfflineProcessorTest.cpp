@@ -0,0 +1,167 @@
+#include <Spectrex/OfflineProcessor.hpp>
+
+// Spectrex
+#include <Spectrex/MiniProcessor.hpp>
+#include <Spectrex/Processing/Processor.hpp>
+#include <Test.hpp>
+
+// Stdlib
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+using namespace spectrex;
+using namespace spectrex::test;
+
+namespace {
+
+/// Returns the spectrogram history of \a processor, oldest row first.
+auto
+getSpectrogram(KProcessor& processor) -> std::vector<float>
+{
+    std::vector<float> result;
+    processor.syncSpectrogram(
+      [&](SyncInfo<float> first, std::optional<SyncInfo<float>> second) {
+          for (const auto& info : { std::optional(first), second }) {
+              if (info && info->isValid()) {
+                  result.insert(result.end(), info->Pointer,
+                                info->Pointer + info->Width * info->Height);
+              }
+          }
+      });
+    return result;
+}
+
+/// Returns the waveform history of a channel of \a processor, oldest bin first.
+auto
+getWaveform(KProcessor& processor, Channel channel) -> std::vector<float>
+{
+    std::vector<float> result;
+    processor.syncWaveform(
+      channel, [&](SyncInfo<WaveformBin> first,
+                   std::optional<SyncInfo<WaveformBin>> second) {
+          for (const auto& info : { std::optional(first), second }) {
+              if (info && info->isValid()) {
+                  for (size_t i = 0; i < info->Width * info->Height; ++i) {
+                      result.push_back(info->Pointer[i].Min);
+                      result.push_back(info->Pointer[i].Max);
+                  }
+              }
+          }
+      });
+    return result;
+}
+
+/// Returns a processor configured like the processors of MiniProcessor.
+auto
+makeProcessor(float sampleRate) -> std::unique_ptr<KProcessor>
+{
+    auto processor = std::make_unique<KProcessor>();
+    processor->setParameter(ProcessorParameters::Key::FtSize, FtSize::Size256);
+    processor->setParameter<float>(ProcessorParameters::Key::SampleRate,
+                                   sampleRate);
+    return processor;
+}
+
+/// Feeds the same stereo noise to MiniProcessor, in host blocks that do not
+/// divide into processing blocks, and to OfflineProcessor in one go, and
+/// checks that both processors end up with the same histories. The trailing
+/// samples that do not fill a processing block are analyzed by neither.
+void
+testMatchesMiniProcessor()
+{
+    constexpr auto subBlockSize = KProcessor::getExpectedBlockSize();
+    const double sampleRate = 48000.0;
+    const int blockSize = 500;
+    const int numBlocks = 17;
+    const auto numSamples = (size_t)(numBlocks * blockSize);
+    const auto left = makeNoise(numSamples, 0.5f, 1);
+    const auto right = makeNoise(numSamples, 0.25f, 2);
+
+    MiniProcessor realtime(MiniProcessor::ThreadingMode::DedicatedThread, 2);
+    realtime.prepareToPlay(sampleRate, blockSize);
+    juce::AudioSampleBuffer buffer(2, blockSize);
+    juce::MidiBuffer noMidi;
+    for (int b = 0; b < numBlocks; ++b) {
+        buffer.copyFrom(0, 0, left.data() + b * blockSize, blockSize);
+        buffer.copyFrom(1, 0, right.data() + b * blockSize, blockSize);
+        realtime.processBlock(nullptr, buffer, noMidi);
+    }
+
+    // Wait until the processing thread analyzed all complete blocks
+    const auto numAnalyzedSamples = numSamples / subBlockSize * subBlockSize;
+    const auto start = std::chrono::steady_clock::now();
+    while (realtime.getDemandStatistics().AnalyzedSamples <
+           numAnalyzedSamples) {
+        SPECTREX_CHECK(std::chrono::steady_clock::now() - start <
+                       std::chrono::seconds(10));
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    const auto offline = makeProcessor((float)sampleRate);
+    SPECTREX_CHECK(OfflineProcessor::process(*offline, left, right));
+
+    auto& processor = realtime.getProcessor();
+    SPECTREX_CHECK(!getSpectrogram(processor).empty());
+    SPECTREX_CHECK(getSpectrogram(*offline) == getSpectrogram(processor));
+    for (const auto channel : { Left, Right }) {
+        SPECTREX_CHECK(getWaveform(*offline, channel) ==
+                       getWaveform(processor, channel));
+    }
+}
+
+/// Analyzes jobs of very different lengths, including an empty one, one
+/// shorter than a processing block and one without a processor, on fewer
+/// threads than jobs, and checks that every job ends up with the histories of
+/// analyzing it on its own.
+void
+testBatch()
+{
+    const float sampleRate = 44100.0f;
+    const std::vector<size_t> lengths = { 3 * 44100, 0, 20, 4321, 44100, 96 };
+
+    std::vector<std::vector<float>> inputs;
+    std::vector<std::unique_ptr<KProcessor>> processors;
+    std::vector<OfflineProcessor::Job> jobs;
+    for (size_t j = 0; j < lengths.size(); ++j) {
+        inputs.push_back(makeNoise(lengths[j], 0.5f, (unsigned)(j + 1)));
+        processors.push_back(std::make_unique<KProcessor>());
+        processors.back()->setParameter(ProcessorParameters::Key::FtSize,
+                                        FtSize::Size256);
+
+        OfflineProcessor::Job job;
+        job.Processor = processors.back().get();
+        job.Left = inputs.back();
+        job.SampleRate = sampleRate;
+        jobs.push_back(job);
+    }
+    jobs.push_back(OfflineProcessor::Job{});
+
+    SPECTREX_CHECK(OfflineProcessor::processBatch(jobs, 3) == lengths.size());
+    SPECTREX_CHECK(!jobs.back().Succeeded);
+
+    for (size_t j = 0; j < lengths.size(); ++j) {
+        SPECTREX_CHECK(jobs[j].Succeeded);
+
+        const auto reference = makeProcessor(sampleRate);
+        SPECTREX_CHECK(OfflineProcessor::process(*reference, inputs[j], {}));
+        SPECTREX_CHECK(getSpectrogram(*processors[j]) ==
+                       getSpectrogram(*reference));
+        for (const auto channel : { Left, Right }) {
+            SPECTREX_CHECK(getWaveform(*processors[j], channel) ==
+                           getWaveform(*reference, channel));
+        }
+    }
+}
+
+} // namespace
+
+int
+main()
+{
+    testMatchesMiniProcessor();
+    testBatch();
+    return 0;
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+// GSL
+#include <gsl/span>
+
+// Stdlib
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+/// Fails the test unless \a condition holds, printing the location and the condition.
+#define SPECTREX_CHECK(condition)                                                                                                                  \
+    do {                                                                                                                                             \
+        if (!(condition)) {                                                                                                                          \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition);                                                     \
+            std::exit(1);                                                                                                                            \
+        }                                                                                                                                            \
+    } while (false)
+
+namespace spectrex::test {
+
+/// Pi, for test signals.
+inline const double k_pi = std::acos(-1.0);
+
+/// Frames of magnitudes, as collected from a frame handler.
+using Frames = std::vector<std::vector<float>>;
+
+/// Returns a frame handler appending every frame to \a frames.
+inline auto collectFrames(Frames& frames)
+{
+    return [&frames](gsl::span<const float> magnitudes) { frames.emplace_back(magnitudes.begin(), magnitudes.end()); };
+}
+
+/// Returns uniform noise in [-amplitude, amplitude], the same for every run with the same seed.
+inline auto makeNoise(size_t numSamples, float amplitude = 1.0f, unsigned seed = 1) -> std::vector<float>
+{
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> distribution(-amplitude, amplitude);
+
+    std::vector<float> samples(numSamples);
+    for (auto& sample : samples) {
+        sample = distribution(generator);
+    }
+    return samples;
+}
+
+/// Returns a sine of \a frequency Hz, computed in double precision.
+inline auto makeSine(size_t numSamples, double frequency, double sampleRate, double amplitude = 1.0, double phase = 0.0) -> std::vector<float>
+{
+    std::vector<float> samples(numSamples);
+    for (size_t i = 0; i < numSamples; ++i) {
+        samples[i] = (float)(amplitude * std::sin(2.0 * k_pi * frequency * (double)i / sampleRate + phase));
+    }
+    return samples;
+}
+
+/// Returns the largest absolute difference between frames \a actual and \a expected, relative to the largest magnitude of \a expected. Only
+/// the frames both have are compared, starting at frame \a first.
+inline auto getRelativeError(const Frames& actual, const Frames& expected, size_t first = 0) -> double
+{
+    double error = 0.0;
+    double maximum = 0.0;
+    for (size_t f = first; f < std::min(actual.size(), expected.size()); ++f) {
+        SPECTREX_CHECK(actual[f].size() == expected[f].size());
+        for (size_t k = 0; k < actual[f].size(); ++k) {
+            error = std::max(error, (double)std::abs(actual[f][k] - expected[f][k]));
+            maximum = std::max(maximum, (double)std::abs(expected[f][k]));
+        }
+    }
+    return maximum > 0.0 ? error / maximum : error;
+}
+
+/// Returns the time \a function takes to run in nanoseconds, e.g. for the benchmarks printed by the tests.
+template<typename Function>
+auto measureNanoseconds(Function&& function) -> double
+{
+    const auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// Returns the time \a process takes per second of audio in nanoseconds, measured over ten passes through a second of \a sampleRate samples in
+/// typical batches of 512 samples. \a process receives the offset and size of every batch within the second.
+template<typename Function>
+auto measureNanosecondsPerSecond(double sampleRate, Function&& process) -> double
+{
+    constexpr size_t numSeconds = 10;
+    constexpr size_t batchSize = 512;
+
+    const auto numSamples = (size_t)sampleRate;
+    const auto elapsed = measureNanoseconds([&] {
+        for (size_t second = 0; second < numSeconds; ++second) {
+            for (size_t offset = 0; offset < numSamples; offset += batchSize) {
+                process(offset, std::min(batchSize, numSamples - offset));
+            }
+        }
+    });
+    return elapsed / (double)numSeconds;
+}
+
+/// Returns the nearest-rank percentile \a fraction (e.g. 0.99) of \a values, which must not be empty.
+inline auto getPercentile(std::vector<double> values, double fraction) -> double
+{
+    std::sort(values.begin(), values.end());
+    const auto rank = (size_t)std::ceil(fraction * (double)values.size());
+    return values[std::max<size_t>(1, rank) - 1];
+}
+
+/// Returns the index of the largest value of \a values.
+inline auto getPeak(gsl::span<const float> values) -> size_t
+{
+    return (size_t)(std::max_element(values.begin(), values.end()) - values.begin());
+}
+
+} // namespace spectrex::test
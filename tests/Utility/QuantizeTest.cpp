@@ -0,0 +1,108 @@
+#include <Spectrex/Utility/Quantize.hpp>
+
+// Spectrex
+#include <Test.hpp>
+
+// Stdlib
+#include <cmath>
+#include <limits>
+
+using namespace spectrex;
+
+namespace {
+
+/// Returns the value of a half-precision float, decoded field by field.
+auto
+decodeHalf(uint16_t half) -> float
+{
+    const auto sign = (half & 0x8000u) != 0 ? -1.0f : 1.0f;
+    const auto exponent = (int)((half >> 10) & 0x1fu);
+    const auto mantissa = (int)(half & 0x3ffu);
+    if (exponent == 0x1f) {
+        return mantissa == 0 ? sign * std::numeric_limits<float>::infinity()
+                             : std::numeric_limits<float>::quiet_NaN();
+    }
+    if (exponent == 0) {
+        return sign * std::ldexp((float)mantissa, -24);
+    }
+    return sign * std::ldexp((float)(1024 + mantissa), exponent - 25);
+}
+
+/// Checks every half-precision code against a field by field decode, and that
+/// encoding round-trips.
+void
+testHalfCodes()
+{
+    for (uint32_t code = 0; code < 0x10000u; ++code) {
+        const auto half = (uint16_t)code;
+        const auto expected = decodeHalf(half);
+        const auto value = halfToFloat(half);
+        if (std::isnan(expected)) {
+            SPECTREX_CHECK(std::isnan(value));
+            SPECTREX_CHECK(std::isnan(halfToFloat(floatToHalf(value))));
+            continue;
+        }
+        SPECTREX_CHECK(std::bit_cast<uint32_t>(value) ==
+                       std::bit_cast<uint32_t>(expected));
+        SPECTREX_CHECK(floatToHalf(value) == half);
+    }
+}
+
+/// Checks that floats between two half-precision values round to the nearest,
+/// and ties to the even one, including into subnormals and infinity.
+void
+testHalfRounding()
+{
+    for (uint32_t code = 0; code < 0x7c00u; ++code) {
+        const auto lower = decodeHalf((uint16_t)code);
+        const auto upper =
+          code + 1 == 0x7c00u ? 65536.0f : decodeHalf((uint16_t)(code + 1));
+        const auto middle = (lower + upper) / 2.0f;
+        const auto even = (uint16_t)((code & 1u) == 0 ? code : code + 1);
+
+        SPECTREX_CHECK(floatToHalf(middle) == even);
+        SPECTREX_CHECK(floatToHalf(-middle) == (uint16_t)(even | 0x8000u));
+        SPECTREX_CHECK(floatToHalf(std::nextafter(middle, 0.0f)) == code);
+        SPECTREX_CHECK(floatToHalf(std::nextafter(middle, upper)) == code + 1);
+    }
+    SPECTREX_CHECK(floatToHalf(1e10f) == 0x7c00u);
+    SPECTREX_CHECK(floatToHalf(1e-10f) == 0);
+}
+
+/// Checks the precision of the LogUint16 encoding over its range.
+void
+testLogUint16()
+{
+    const auto step =
+      (k_logUint16MaxDb - k_logUint16MinDb) / (float)(0xffff - 1);
+    for (auto db = k_logUint16MinDb + step; db < k_logUint16MaxDb;
+         db += 0.37f) {
+        const auto magnitude = std::pow(10.0f, db / 20.0f);
+        const auto decoded =
+          logUint16ToMagnitude(magnitudeToLogUint16(magnitude));
+        SPECTREX_CHECK(std::abs(20.0f * std::log10(decoded / magnitude)) <=
+                       0.51f * step + 1e-4f);
+    }
+
+    // Code 0 is reserved for silence, quiet signals clamp to code 1
+    SPECTREX_CHECK(magnitudeToLogUint16(0.0f) == 0);
+    SPECTREX_CHECK(logUint16ToMagnitude(0) == 0.0f);
+    SPECTREX_CHECK(magnitudeToLogUint16(1e-9f) == 1);
+    SPECTREX_CHECK(magnitudeToLogUint16(1e-20f) == 1);
+    SPECTREX_CHECK(std::abs(20.0f * std::log10(logUint16ToMagnitude(1)) -
+                            k_logUint16MinDb) < 1e-3f);
+    SPECTREX_CHECK(magnitudeToLogUint16(1e9f) == 0xffffu);
+    SPECTREX_CHECK(std::abs(20.0f * std::log10(logUint16ToMagnitude(0xffff)) -
+                            k_logUint16MaxDb) < 1e-3f);
+}
+
+} // namespace
+
+int
+main()
+{
+    testHalfCodes();
+    testHalfRounding();
+    testLogUint16();
+    return 0;
+}
@@ -0,0 +1,150 @@
+#include <Spectrex/Utility/RingBuffer.hpp>
+
+// Spectrex
+#include <Test.hpp>
+
+// Stdlib
+#include <numeric>
+#include <vector>
+
+using namespace spectrex;
+
+namespace {
+
+/// Returns the values [first, first + count).
+auto
+makeSequence(int first, size_t count) -> std::vector<int>
+{
+    std::vector<int> values(count);
+    std::iota(values.begin(), values.end(), first);
+    return values;
+}
+
+/// Streams a sequence through the ring buffer in writes of varying size,
+/// wrapping around many times, and checks that reads and in place peeks
+/// return every element once and in order.
+void
+testSequence(size_t capacity)
+{
+    RingBuffer<int> ringBuffer(capacity, -1);
+
+    int next = 0;
+    int expected = 0;
+    bool peek = false;
+    for (size_t round = 0; round < 100; ++round) {
+        // A full ring buffer reads as empty, so keep at least one free
+        const auto count = 1 + round % (capacity - 1);
+        ringBuffer.write(makeSequence(next, count));
+        next += (int)count;
+        SPECTREX_CHECK(ringBuffer.getReadSpace() == (int)count);
+
+        if (peek) {
+            const auto region = ringBuffer.peekContiguous();
+            SPECTREX_CHECK(region.size() == count);
+            for (const auto value : region.First) {
+                SPECTREX_CHECK(value == expected++);
+            }
+            if (region.Second) {
+                for (const auto value : *region.Second) {
+                    SPECTREX_CHECK(value == expected++);
+                }
+            }
+            ringBuffer.commitRead(count);
+        } else {
+            std::vector<int> values(count);
+            ringBuffer.read(values.data(), (int)count);
+            SPECTREX_CHECK(values == makeSequence(expected, count));
+            expected += (int)count;
+        }
+        SPECTREX_CHECK(ringBuffer.getReadSpace() == 0);
+        peek = !peek;
+    }
+}
+
+/// Checks that a peek across the end of the storage is split in two, and that
+/// a partial commitRead only consumes the oldest elements.
+void
+testPeekAcrossEnd(size_t capacity)
+{
+    RingBuffer<int> ringBuffer(capacity, -1);
+    ringBuffer.write(makeSequence(0, capacity - 2));
+    ringBuffer.commitRead(capacity - 3);
+    ringBuffer.write(makeSequence((int)capacity - 2, 4));
+
+    // Three elements up to the end of the storage, two from its start
+    auto region = ringBuffer.peekContiguous();
+    SPECTREX_CHECK(region.size() == 5);
+    SPECTREX_CHECK(region.First.size() == 3);
+    SPECTREX_CHECK(region.Second && region.Second->size() == 2);
+    const auto expected = makeSequence((int)capacity - 3, 5);
+    SPECTREX_CHECK(std::equal(
+      region.First.begin(), region.First.end(), expected.begin()));
+    SPECTREX_CHECK(std::equal(
+      region.Second->begin(), region.Second->end(), expected.begin() + 3));
+
+    ringBuffer.commitRead(4);
+    region = ringBuffer.peekContiguous();
+    SPECTREX_CHECK(region.size() == 1);
+    SPECTREX_CHECK(!region.Second);
+    SPECTREX_CHECK(region.First[0] == expected[4]);
+}
+
+/// Checks that a write of more elements than the capacity keeps the most
+/// recent ones, like as many pushes would.
+void
+testOversizeWrite(size_t capacity)
+{
+    RingBuffer<int> ringBuffer(capacity, -1);
+    RingBuffer<int> pushed(capacity, -1);
+    ringBuffer.advance(3);
+    pushed.advance(3);
+
+    const auto values = makeSequence(0, 2 * capacity + 3);
+    ringBuffer.write(values);
+    for (const auto value : values) {
+        pushed.push(value);
+    }
+
+    int previous = -1;
+    ringBuffer.getPreviousValue(previous);
+    SPECTREX_CHECK(previous == values.back());
+
+    // The storage holds the last capacity elements, the oldest at the head,
+    // so all but the oldest are read from right after the head
+    const auto head = (3 + values.size()) % capacity;
+    ringBuffer.skip((int)head + 1);
+    pushed.skip((int)head + 1);
+    const auto region = ringBuffer.peekContiguous();
+    const auto expected = pushed.peekContiguous();
+    SPECTREX_CHECK(region.size() == capacity - 1);
+    SPECTREX_CHECK(expected.size() == capacity - 1);
+    std::vector<int> actualValues(region.First.begin(), region.First.end());
+    std::vector<int> expectedValues(expected.First.begin(),
+                                    expected.First.end());
+    if (region.Second) {
+        actualValues.insert(
+          actualValues.end(), region.Second->begin(), region.Second->end());
+    }
+    if (expected.Second) {
+        expectedValues.insert(expectedValues.end(),
+                              expected.Second->begin(),
+                              expected.Second->end());
+    }
+    SPECTREX_CHECK(actualValues == expectedValues);
+    SPECTREX_CHECK(actualValues.front() ==
+                   values[values.size() - capacity + 1]);
+}
+
+} // namespace
+
+int
+main()
+{
+    // A power-of-two capacity wraps with a mask, any other with a modulo
+    for (const size_t capacity : { 8, 10 }) {
+        testSequence(capacity);
+        testPeekAcrossEnd(capacity);
+        testOversizeWrite(capacity);
+    }
+    return 0;
+}
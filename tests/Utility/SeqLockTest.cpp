@@ -0,0 +1,83 @@
+#include <Spectrex/Utility/SeqLock.hpp>
+
+// Spectrex
+#include <Test.hpp>
+
+// Stdlib
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace spectrex;
+
+namespace {
+
+/// Value spanning several cache lines, so a store takes long enough to be
+/// overlapped by loads. Every store sets all words to the same counter, so a
+/// torn value has differing words.
+struct Value
+{
+    std::array<uint64_t, 32> Words{};
+};
+
+/// Stores an increasing counter on a writer thread while a reader thread
+/// loads, and checks that loads never return a torn or older value, and that
+/// the statistics count every store, load and retry.
+void
+testWriterReader()
+{
+    SeqLock<Value> seqLock;
+    std::atomic<bool> done = false;
+    std::atomic<uint64_t> numStores = 0;
+
+    std::thread writer([&] {
+        Value value;
+        while (!done) {
+            value.Words.fill(numStores + 1);
+            seqLock.store(value);
+            ++numStores;
+        }
+    });
+
+    // Read until loads have overlapped with stores many times, which also
+    // happens on a single core whenever either thread is preempted during a
+    // store or a load
+    const size_t minNumLoads = 100'000;
+    const uint64_t minNumRetries = 1000;
+    size_t numLoads = 0;
+    uint64_t previous = 0;
+    const auto start = std::chrono::steady_clock::now();
+    while (numLoads < minNumLoads ||
+           seqLock.getStatistics().NumRetries < minNumRetries) {
+        SPECTREX_CHECK(std::chrono::steady_clock::now() - start <
+                       std::chrono::seconds(60));
+
+        const auto value = seqLock.load();
+        ++numLoads;
+        for (const auto word : value.Words) {
+            SPECTREX_CHECK(word == value.Words[0]);
+        }
+        SPECTREX_CHECK(value.Words[0] >= previous);
+        previous = value.Words[0];
+    }
+
+    done = true;
+    writer.join();
+
+    // The constructor stores the initial value
+    const auto statistics = seqLock.getStatistics();
+    SPECTREX_CHECK(statistics.NumWrites == numStores + 1);
+    SPECTREX_CHECK(statistics.NumReads == numLoads);
+    SPECTREX_CHECK(statistics.NumRetries > 0);
+    SPECTREX_CHECK(seqLock.load().Words[0] == numStores);
+}
+
+} // namespace
+
+int
+main()
+{
+    testWriterReader();
+    return 0;
+}
@@ -0,0 +1,182 @@
+#include <Spectrex/Utility/SpscRingBuffer.hpp>
+
+// Spectrex
+#include <Spectrex/Utility/RingBuffer.hpp>
+#include <Test.hpp>
+
+// Stdlib
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace spectrex;
+
+namespace {
+
+/// Number of samples per push, as published by the audio thread.
+constexpr size_t k_blockSize = 32;
+
+/// Streams a sequence from a producer to a consumer thread, using pushes and
+/// bulk writes of varying size on one side and reads and in place peeks on
+/// the other, and checks that every element arrives once and in order.
+void
+testSequence(size_t capacity)
+{
+    const uint32_t numElements = 4'000'000;
+    SpscRingBuffer<uint32_t> ringBuffer(capacity, 0);
+
+    std::thread producer([&] {
+        std::vector<uint32_t> values(97);
+        uint32_t next = 0;
+        size_t size = 1;
+        while (next < numElements) {
+            if (size == 1) {
+                if (ringBuffer.push(next)) {
+                    ++next;
+                } else {
+                    std::this_thread::yield();
+                }
+            } else {
+                const auto n = std::min<size_t>(size, numElements - next);
+                for (size_t i = 0; i < n; ++i) {
+                    values[i] = next + (uint32_t)i;
+                }
+                const auto written = ringBuffer.write(
+                  gsl::span<const uint32_t>(values.data(), n));
+                SPECTREX_CHECK(written <= n);
+                next += (uint32_t)written;
+                if (written < n) {
+                    std::this_thread::yield();
+                }
+            }
+            size = size % values.size() + 1;
+        }
+    });
+
+    std::vector<uint32_t> values(64);
+    uint32_t expected = 0;
+    bool peek = false;
+    while (expected < numElements) {
+        size_t n = 0;
+        if (peek) {
+            const auto region = ringBuffer.peekContiguous(61);
+            for (const auto value : region.First) {
+                SPECTREX_CHECK(value == expected++);
+            }
+            if (region.Second) {
+                for (const auto value : *region.Second) {
+                    SPECTREX_CHECK(value == expected++);
+                }
+            }
+            n = region.size();
+            ringBuffer.commitRead(n);
+        } else {
+            n = ringBuffer.read(values.data(), values.size());
+            for (size_t i = 0; i < n; ++i) {
+                SPECTREX_CHECK(values[i] == expected++);
+            }
+        }
+        if (n == 0) {
+            std::this_thread::yield();
+        }
+        peek = !peek;
+    }
+
+    producer.join();
+    SPECTREX_CHECK(ringBuffer.getReadSpace() == 0);
+}
+
+/// Checks that a full ring buffer rejects writes instead of overwriting
+/// unread elements.
+void
+testFull()
+{
+    SpscRingBuffer<int> ringBuffer(8, 0);
+    const std::vector<int> values{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    SPECTREX_CHECK(ringBuffer.write(values) == 8);
+    SPECTREX_CHECK(!ringBuffer.push(10));
+    SPECTREX_CHECK(ringBuffer.getWriteSpace() == 0);
+
+    std::vector<int> output(8);
+    SPECTREX_CHECK(ringBuffer.read(output.data(), 3) == 3);
+    SPECTREX_CHECK(ringBuffer.write(values) == 3);
+    SPECTREX_CHECK(ringBuffer.read(output.data(), 8) == 8);
+    SPECTREX_CHECK(output == (std::vector<int>{ 3, 4, 5, 6, 7, 0, 1, 2 }));
+}
+
+/// Returns the number of blocks per second the consumer has read.
+auto
+getBlocksPerSecond(size_t numBlocks,
+                   std::chrono::steady_clock::time_point start) -> double
+{
+    const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+    return (double)numBlocks / elapsed.count();
+}
+
+/// Prints the throughput of 32-sample pushes, for RingBuffer and
+/// SpscRingBuffer on a single thread, and for SpscRingBuffer between a
+/// producer and a consumer thread. RingBuffer cannot be shared between
+/// threads, so only its single threaded throughput can be compared.
+void
+benchmarkThroughput()
+{
+    const size_t numBlocks = 2'000'000;
+    const size_t capacity = 16 * 1024;
+    const std::vector<float> block(k_blockSize, 0.5f);
+    std::vector<float> output(k_blockSize);
+
+    RingBuffer<float> ringBuffer(capacity, 0.0f);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t b = 0; b < numBlocks; ++b) {
+        ringBuffer.write(block);
+        ringBuffer.read(output.data(), (int)k_blockSize);
+    }
+    std::printf("RingBuffer, one thread: %.1f M blocks/s\n",
+                getBlocksPerSecond(numBlocks, start) * 1e-6);
+
+    SpscRingBuffer<float> spscRingBuffer(capacity, 0.0f);
+    start = std::chrono::steady_clock::now();
+    for (size_t b = 0; b < numBlocks; ++b) {
+        spscRingBuffer.write(block);
+        spscRingBuffer.read(output.data(), k_blockSize);
+    }
+    std::printf("SpscRingBuffer, one thread: %.1f M blocks/s\n",
+                getBlocksPerSecond(numBlocks, start) * 1e-6);
+
+    spscRingBuffer.reset();
+    start = std::chrono::steady_clock::now();
+    std::thread producer([&] {
+        for (size_t b = 0; b < numBlocks;) {
+            if (spscRingBuffer.write(block) == k_blockSize) {
+                ++b;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    for (size_t b = 0; b < numBlocks;) {
+        if (spscRingBuffer.getReadSpace() >= k_blockSize) {
+            spscRingBuffer.read(output.data(), k_blockSize);
+            ++b;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    std::printf("SpscRingBuffer, two threads: %.1f M blocks/s\n",
+                getBlocksPerSecond(numBlocks, start) * 1e-6);
+    SPECTREX_CHECK(output == block);
+}
+
+} // namespace
+
+int
+main()
+{
+    testSequence(1000);
+    testSequence(1024);
+    testFull();
+    benchmarkThroughput();
+    return 0;
+}
@@ -0,0 +1,132 @@
+#include <Spectrex/Utility/WakeupEvent.hpp>
+
+// Spectrex
+#include <Test.hpp>
+
+// Stdlib
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace spectrex;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// Timeout of the waits, far longer than any wakeup takes.
+constexpr int k_timeoutMs = 2000;
+
+/// Waits for \a event to be signaled, for at most a few timeouts, and counts
+/// the waits that ran into their timeout in \a numTimeouts. A wait may return
+/// early without a signal (on Windows and macOS), so it is repeated until the
+/// signal arrives.
+auto
+waitForSignal(WakeupEvent& event, std::atomic<int>& numTimeouts) -> bool
+{
+    for (int attempt = 0; attempt < 3; ++attempt) {
+        const auto start = Clock::now();
+        if (event.wait(k_timeoutMs)) {
+            return true;
+        }
+        if (Clock::now() - start >= std::chrono::milliseconds(k_timeoutMs)) {
+            ++numTimeouts;
+        }
+    }
+    return false;
+}
+
+/// Checks that a notify before the wait is not lost, that any number of them
+/// is coalesced into a single wakeup, and that the event resets itself.
+void
+testNotifyBeforeWait()
+{
+    WakeupEvent event;
+    SPECTREX_CHECK(!event.wait(1));
+
+    event.notify();
+    const auto start = Clock::now();
+    SPECTREX_CHECK(event.wait(k_timeoutMs));
+    SPECTREX_CHECK(Clock::now() - start < std::chrono::seconds(1));
+    SPECTREX_CHECK(!event.wait(1));
+
+    for (int i = 0; i < 3; ++i) {
+        event.notify();
+    }
+    SPECTREX_CHECK(event.wait(k_timeoutMs));
+    SPECTREX_CHECK(!event.wait(1));
+}
+
+/// Checks that a thread blocked in wait is woken up by a notify long before
+/// its timeout expires.
+void
+testWakeup()
+{
+    WakeupEvent event;
+    std::atomic<bool> woken = false;
+    std::atomic<int> numTimeouts = 0;
+    std::thread waiter([&] { woken = waitForSignal(event, numTimeouts); });
+
+    // Give the waiter time to block on the event
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    SPECTREX_CHECK(!woken);
+    event.notify();
+    waiter.join();
+    SPECTREX_CHECK(woken);
+    SPECTREX_CHECK(numTimeouts == 0);
+}
+
+/// Passes a token back and forth between two threads many times, each waking
+/// up the other, so a notify racing with the other thread about to wait is
+/// covered as well. A lost wakeup makes a wait run into its timeout, even when
+/// the signal is picked up by the next wait.
+void
+testHandoff()
+{
+    constexpr int numRounds = 10000;
+
+    WakeupEvent ping;
+    WakeupEvent pong;
+    std::atomic<int> token = 0;
+    std::atomic<bool> failed = false;
+    std::atomic<int> numTimeouts = 0;
+
+    std::thread other([&] {
+        for (int round = 0; round < numRounds; ++round) {
+            if (!waitForSignal(ping, numTimeouts) || token != 2 * round + 1) {
+                failed = true;
+                return;
+            }
+            ++token;
+            pong.notify();
+        }
+    });
+
+    for (int round = 0; round < numRounds && !failed; ++round) {
+        ++token;
+        ping.notify();
+        if (!waitForSignal(pong, numTimeouts) || token != 2 * round + 2) {
+            failed = true;
+        }
+    }
+    if (failed) {
+        // Release the other thread in case it is still waiting
+        ping.notify();
+    }
+    other.join();
+
+    SPECTREX_CHECK(!failed);
+    SPECTREX_CHECK(numTimeouts == 0);
+    SPECTREX_CHECK(token == 2 * numRounds);
+}
+
+} // namespace
+
+int
+main()
+{
+    testNotifyBeforeWait();
+    testWakeup();
+    testHandoff();
+    return 0;
+}